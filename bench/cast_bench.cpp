@@ -0,0 +1,53 @@
+#include "benchmark/benchmark.h" // cppcheck-suppress [missingInclude]
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "LWCLI/cast.hpp"
+
+// Builds a comma separated list of n_elements random integers, as would be passed to e.g. '--ids'.
+[[nodiscard]] static std::string make_int_list(const std::size_t n_elements)
+{
+    std::mt19937_64 engine(42); // NOLINT(cert-msc32-c, cert-msc51-cpp)
+    std::uniform_int_distribution<std::int64_t> distribution(0, 1'000'000'000);
+
+    std::string result;
+    for (std::size_t i = 0; i < n_elements; ++i) {
+        if (i != 0)
+            result += ',';
+        result += std::to_string(distribution(engine));
+    }
+    return result;
+}
+
+template<class Type>
+static void BM_VectorCast(benchmark::State& state)
+{
+    const auto str = make_int_list(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        auto result = lwcli::cast<std::vector<Type>>::from_string(str);
+        benchmark::DoNotOptimize(result.data());
+    }
+
+    // Note: reported by Google Benchmark as throughput (bytes_per_second).
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(str.size()));
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0));
+}
+
+BENCHMARK(BM_VectorCast<std::int64_t>)->RangeMultiplier(100)->Range(10, 1'000'000);
+BENCHMARK(BM_VectorCast<double>)->RangeMultiplier(100)->Range(10, 1'000'000);
+
+static void BM_CountDelimiters(benchmark::State& state)
+{
+    const auto str = make_int_list(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(lwcli::_count_occurrences(str, ','));
+
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(str.size()));
+}
+
+BENCHMARK(BM_CountDelimiters)->Arg(1'000'000);
@@ -0,0 +1,637 @@
+// Note: must precede every LWCLI header, and be defined in only this translation unit. Counts allocations (See
+// allocation_scope) without recording any parse.
+#define LWCLI_INSTRUMENTATION_COUNT_ALLOCATIONS
+
+#include "benchmark/benchmark.h" // cppcheck-suppress [missingInclude]
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "LWCLI/batch.hpp"
+#include "LWCLI/cast.hpp"
+#include "LWCLI/exceptions.hpp"
+#include "LWCLI/instrumentation.hpp"
+#include "LWCLI/lazy_options.hpp"
+#include "LWCLI/options.hpp"
+#include "LWCLI/parser.hpp"
+#include "LWCLI/static_parser.hpp"
+
+// Run with '--benchmark_format=json' (Or '--benchmark_out=<file> --benchmark_out_format=json') for machine-readable
+// output. Each parse benchmark reports:
+// - args_per_second: the number of command-line arguments parsed per second.
+// - allocs_per_parse: the number of heap allocations made by a single parse.
+// Batch benchmarks instead report rows_per_second, the number of command-lines parsed per second.
+
+/* Allocation counting ---------------------------------------------------------------------------------------------- */
+
+// Note: only allocations made within an allocation_scope (i.e. the timed loop) are counted, so those made whilst
+// building a workload (Or by Google Benchmark itself) are not recorded.
+namespace
+{
+std::size_t g_allocation_count = 0;
+
+class allocation_scope
+{
+public:
+    allocation_scope() noexcept:
+        _start(lwcli::_thread_allocations.n_allocations)
+    {}
+
+    allocation_scope(const allocation_scope&) = delete;
+    allocation_scope& operator=(const allocation_scope&) = delete;
+
+    ~allocation_scope()
+    {
+        g_allocation_count = lwcli::_thread_allocations.n_allocations - _start;
+    }
+
+private:
+    std::size_t _start;
+};
+
+void report(benchmark::State& state, const std::size_t argc)
+{
+    state.counters["args_per_second"] = benchmark::Counter(
+        static_cast<double>(argc - 1),
+        benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["allocs_per_parse"] =
+        benchmark::Counter(static_cast<double>(g_allocation_count), benchmark::Counter::kAvgIterations);
+}
+} // namespace
+
+/* Workloads -------------------------------------------------------------------------------------------------------- */
+
+namespace
+{
+enum class mix : std::uint8_t {
+    FLAGS,
+    KEY_VALUES,
+    POSITIONALS,
+    MIXED,
+};
+
+// Accumulates every positional argument, so that none are optimised away.
+struct summer
+{
+    long long* sum;
+
+    void operator()(const int value) const noexcept
+    {
+        *sum += value;
+    }
+};
+
+// A parser with n_options options of each named kind registered (Plus a positional sink), along with an argv of argc
+// arguments drawn from the given mix. Options are registered in place, hence workloads are neither copied nor moved.
+class workload
+{
+public:
+    workload(const mix kind, const std::size_t argc, const std::size_t n_options):
+        _flags(n_options),
+        _key_values(n_options),
+        _sink(lwcli::make_positional_sink<int>(summer{&_sum}))
+    {
+        for (std::size_t i = 0; i < n_options; ++i) {
+            _flags[i].aliases = {"-f" + std::to_string(i), "--flag-" + std::to_string(i)};
+            _flags[i].description = "Description for flag";
+            _key_values[i].aliases = {"-k" + std::to_string(i), "--key-" + std::to_string(i)};
+            _key_values[i].description = "Description for key-value";
+
+            parser.register_option(_flags[i]).register_option(_key_values[i]);
+        }
+        _sink.name = "values";
+        _sink.description = "Description for values";
+        parser.register_option(_sink).freeze();
+
+        _args.reserve(argc);
+        _args.emplace_back("bench");
+        for (std::size_t i = 0; _args.size() < argc; ++i) {
+            switch (kind == mix::MIXED ? static_cast<mix>(i % 3) : kind) {
+            case mix::FLAGS:
+                _args.push_back("--flag-" + std::to_string(i % n_options));
+                break;
+            case mix::KEY_VALUES:
+                _args.push_back("--key-" + std::to_string(i % n_options));
+                if (_args.size() < argc)
+                    _args.push_back(std::to_string(i));
+                else
+                    _args.back() = "--flag-0";
+                break;
+            case mix::POSITIONALS:
+            case mix::MIXED:
+                _args.push_back(std::to_string(i));
+                break;
+            }
+        }
+
+        argv.reserve(_args.size());
+        for (const auto& arg : _args)
+            argv.push_back(arg.c_str());
+    }
+
+    workload(const workload&) = delete;
+    workload& operator=(const workload&) = delete;
+
+    [[nodiscard]] int argc() const noexcept
+    {
+        return static_cast<int>(argv.size());
+    }
+
+    lwcli::CLIParser parser;
+    std::vector<const char*> argv;
+
+private:
+    std::vector<lwcli::FlagOption> _flags;
+    std::vector<lwcli::KeyValueOption<std::optional<int>>> _key_values;
+
+    long long _sum = 0;
+    lwcli::PositionalSink<int, summer> _sink;
+
+    std::vector<std::string> _args;
+};
+} // namespace
+
+/* Parse benchmarks ------------------------------------------------------------------------------------------------- */
+
+template<mix Kind>
+static void BM_Parse(benchmark::State& state)
+{
+    workload load(Kind, static_cast<std::size_t>(state.range(0)), static_cast<std::size_t>(state.range(1)));
+
+    {
+        const allocation_scope scope;
+        for (auto _ : state)
+            load.parser.parse(load.argc(), load.argv.data());
+    }
+    report(state, load.argv.size());
+}
+
+// Note: argc = 1 would display the help menu, hence the smallest argc benchmarked is 10.
+#define LWCLI_PARSE_BENCHMARK(kind)                                                                                    \
+    BENCHMARK(BM_Parse<kind>)                                                                                          \
+        ->ArgNames({"argc", "options"})                                                                                \
+        ->ArgsProduct({{10, 1'000, 100'000, 1'000'000}, {5, 100, 10'000}})
+
+LWCLI_PARSE_BENCHMARK(mix::FLAGS);
+LWCLI_PARSE_BENCHMARK(mix::KEY_VALUES);
+LWCLI_PARSE_BENCHMARK(mix::MIXED);
+
+// Note: positional arguments never consult the named options, so their count is not varied.
+BENCHMARK(BM_Parse<mix::POSITIONALS>)
+    ->ArgNames({"argc", "options"})
+    ->ArgsProduct({{10, 1'000, 100'000, 1'000'000}, {5}});
+
+// Parses the same arguments as BM_Parse<Kind>, joined into a single command-line. Every other argument is quoted, so
+// half are views of the command-line and half are unescaped.
+template<mix Kind>
+static void BM_ParseCommandLine(benchmark::State& state)
+{
+    workload load(Kind, static_cast<std::size_t>(state.range(0)), static_cast<std::size_t>(state.range(1)));
+
+    std::string command_line;
+    for (std::size_t i = 0; i < load.argv.size(); ++i)
+        command_line += i % 2 == 0 ? std::string(load.argv[i]) + " " : "'" + std::string(load.argv[i]) + "' ";
+
+    {
+        const allocation_scope scope;
+        for (auto _ : state)
+            load.parser.parse(command_line);
+    }
+    report(state, load.argv.size());
+}
+
+BENCHMARK(BM_ParseCommandLine<mix::MIXED>)
+    ->ArgNames({"argc", "options"})
+    ->ArgsProduct({{10, 1'000, 100'000}, {100}});
+
+// Parses argc abbreviations (Each the unambiguous prefix of a distinct option, bar repeats) with prefix matching
+// enabled. The cost of each lookup should not depend on the number of options registered.
+static void BM_ParsePrefixes(benchmark::State& state)
+{
+    const auto argc = static_cast<std::size_t>(state.range(0));
+    const auto n_options = static_cast<std::size_t>(state.range(1));
+
+    std::vector<lwcli::FlagOption> flags(n_options);
+    lwcli::CLIParser parser;
+    for (std::size_t i = 0; i < n_options; ++i) {
+        flags[i].aliases = {"--option-" + std::to_string(i) + "-long"};
+        flags[i].description = "Description for flag";
+        parser.register_option(flags[i]);
+    }
+    parser.match_prefixes().freeze();
+
+    std::vector<std::string> args = {"bench"};
+    for (std::size_t i = 1; i < argc; ++i)
+        args.push_back("--option-" + std::to_string(i % n_options) + "-l");
+    std::vector<const char*> argv;
+    for (const auto& arg : args)
+        argv.push_back(arg.c_str());
+
+    {
+        const allocation_scope scope;
+        for (auto _ : state)
+            parser.parse(static_cast<int>(argv.size()), argv.data());
+    }
+    report(state, argv.size());
+}
+
+BENCHMARK(BM_ParsePrefixes)->ArgNames({"argc", "options"})->ArgsProduct({{1'000}, {5, 100, 10'000}});
+
+// Parses argc arguments alternating between a cluster of short options ending in an attached value ('-vqj8') and a long
+// option with an inline value ('--threads=8'), each split without copying.
+static void BM_ParseClusters(benchmark::State& state)
+{
+    const auto argc = static_cast<std::size_t>(state.range(0));
+
+    lwcli::FlagOption verbose;
+    verbose.aliases = {"-v", "--verbose"};
+    verbose.description = "Description for verbose";
+    lwcli::FlagOption quiet;
+    quiet.aliases = {"-q", "--quiet"};
+    quiet.description = "Description for quiet";
+    lwcli::KeyValueOption<int> threads;
+    threads.aliases = {"-j", "--threads"};
+    threads.description = "Description for threads";
+
+    lwcli::CLIParser parser;
+    parser.register_options(verbose, quiet, threads).freeze();
+
+    std::vector<const char*> argv = {"bench"};
+    for (std::size_t i = 1; i < argc; ++i)
+        argv.push_back(i % 2 == 0 ? "-vqj8" : "--threads=8");
+
+    {
+        const allocation_scope scope;
+        for (auto _ : state)
+            parser.parse(static_cast<int>(argv.size()), argv.data());
+    }
+    report(state, argv.size());
+}
+
+BENCHMARK(BM_ParseClusters)->ArgName("argc")->Arg(1'000)->Arg(100'000);
+
+// Parses argc arguments repeating a single append option ('--input <path>'), whose values are counted before the
+// container is reserved once, then converted straight from argv.
+static void BM_ParseAppended(benchmark::State& state)
+{
+    const auto argc = static_cast<std::size_t>(state.range(0));
+
+    lwcli::AppendKeyValueOption<std::string> inputs;
+    inputs.aliases = {"-i", "--input"};
+    inputs.description = "Description for inputs";
+
+    lwcli::CLIParser parser;
+    parser.register_option(inputs).freeze();
+
+    std::vector<const char*> argv = {"bench"};
+    while (argv.size() + 1 < argc) {
+        argv.push_back("--input");
+        argv.push_back("path/to/some/input/file.txt");
+    }
+
+    {
+        const allocation_scope scope;
+        for (auto _ : state)
+            parser.parse(static_cast<int>(argv.size()), argv.data());
+    }
+    report(state, argv.size());
+}
+
+BENCHMARK(BM_ParseAppended)->ArgName("argc")->Arg(1'000)->Arg(100'000);
+
+// Parses argc arguments giving (eagerly or lazily converted) double options, none of which are then accessed.
+template<bool Lazy>
+static void BM_ParseLazy(benchmark::State& state)
+{
+    constexpr std::size_t n_options = 100;
+    const auto argc = static_cast<std::size_t>(state.range(0));
+
+    using option_t = std::conditional_t<
+        Lazy,
+        lwcli::LazyKeyValueOption<std::optional<double>>,
+        lwcli::KeyValueOption<std::optional<double>>>;
+    std::vector<option_t> options(n_options);
+    std::vector<std::string> args = {"bench"};
+
+    lwcli::CLIParser parser;
+    for (std::size_t i = 0; i < n_options; ++i) {
+        options[i].aliases = {"--key-" + std::to_string(i)};
+        options[i].description = "Description for key-value";
+        parser.register_option(options[i]);
+    }
+    parser.freeze();
+
+    while (args.size() + 1 < argc) {
+        args.push_back("--key-" + std::to_string(args.size() % n_options));
+        args.emplace_back("3.14159265358979");
+    }
+    std::vector<const char*> argv;
+    for (const auto& arg : args)
+        argv.push_back(arg.c_str());
+
+    {
+        const allocation_scope scope;
+        for (auto _ : state)
+            parser.parse(static_cast<int>(argv.size()), argv.data());
+    }
+    report(state, argv.size());
+}
+
+BENCHMARK(BM_ParseLazy<false>)->ArgName("argc")->Arg(1'000)->Arg(100'000);
+BENCHMARK(BM_ParseLazy<true>)->ArgName("argc")->Arg(1'000)->Arg(100'000);
+
+/* Static parser benchmarks --------------------------------------------------------------------------------------- */
+
+namespace
+{
+struct static_settings
+{
+    unsigned verbose = 0;
+    unsigned quiet = 0;
+    std::optional<int> threads;
+    std::optional<int> level;
+};
+
+constexpr auto STATIC_SCHEMA = lwcli::make_static_schema<static_settings>(
+    lwcli::make_static_flag(&static_settings::verbose, {"-v", "--verbose"}, "Description for verbose"),
+    lwcli::make_static_flag(&static_settings::quiet, {"-q", "--quiet"}, "Description for quiet"),
+    lwcli::make_static_key_value(&static_settings::threads, {"-j", "--threads"}, "Description for threads"),
+    lwcli::make_static_key_value(&static_settings::level, {"-l", "--level"}, "Description for level"));
+
+// An argv of argc arguments cycling through every option of STATIC_SCHEMA, inline values included.
+[[nodiscard]] std::vector<const char*> make_static_argv(const std::size_t argc)
+{
+    static constexpr std::array<const char*, 6> ARGS = {"--verbose", "-j", "8", "-q", "--level=3", "-v"};
+
+    std::vector<const char*> argv = {"bench"};
+    while (argv.size() < argc)
+        argv.push_back(ARGS[(argv.size() - 1) % ARGS.size()]);
+    return argv;
+}
+} // namespace
+
+// Parses the schema of STATIC_SCHEMA, every option being dispatched by a switch instantiated at compile-time.
+static void BM_ParseStatic(benchmark::State& state)
+{
+    const auto argv = make_static_argv(static_cast<std::size_t>(state.range(0)));
+
+    const lwcli::StaticParser<STATIC_SCHEMA> parser;
+    static_settings settings;
+    {
+        const allocation_scope scope;
+        for (auto _ : state) {
+            settings = {};
+            benchmark::DoNotOptimize(parser.parse(static_cast<int>(argv.size()), argv.data(), settings));
+        }
+    }
+    report(state, argv.size());
+}
+
+// Parses the same schema and arguments as BM_ParseStatic, with a CLIParser.
+static void BM_ParseStaticBaseline(benchmark::State& state)
+{
+    const auto argv = make_static_argv(static_cast<std::size_t>(state.range(0)));
+
+    lwcli::FlagOption verbose;
+    verbose.aliases = {"-v", "--verbose"};
+    verbose.description = "Description for verbose";
+    lwcli::FlagOption quiet;
+    quiet.aliases = {"-q", "--quiet"};
+    quiet.description = "Description for quiet";
+    lwcli::KeyValueOption<std::optional<int>> threads;
+    threads.aliases = {"-j", "--threads"};
+    threads.description = "Description for threads";
+    lwcli::KeyValueOption<std::optional<int>> level;
+    level.aliases = {"-l", "--level"};
+    level.description = "Description for level";
+
+    lwcli::CLIParser parser;
+    parser.register_options(verbose, quiet, threads, level).freeze();
+    {
+        const allocation_scope scope;
+        for (auto _ : state)
+            parser.parse(static_cast<int>(argv.size()), argv.data());
+    }
+    report(state, argv.size());
+}
+
+BENCHMARK(BM_ParseStatic)->ArgName("argc")->Arg(10)->Arg(1'000)->Arg(100'000);
+BENCHMARK(BM_ParseStaticBaseline)->ArgName("argc")->Arg(10)->Arg(1'000)->Arg(100'000);
+
+/* Error path benchmarks -------------------------------------------------------------------------------------------- */
+
+namespace
+{
+// A parser with a flag and a required int option, which each error benchmark fails to parse in a different way.
+struct error_workload
+{
+    error_workload()
+    {
+        flag.aliases = {"-v"};
+        flag.description = "Description for flag";
+        required.aliases = {"--required"};
+        required.description = "Description for required";
+        parser.register_options(flag, required).freeze();
+    }
+
+    lwcli::FlagOption flag;
+    lwcli::KeyValueOption<int> required;
+    lwcli::CLIParser parser;
+};
+
+const std::vector<const char*> g_bad_value_argv = {"bench", "--required", "not-an-int"};
+const std::vector<const char*> g_missing_value_argv = {"bench", "--required"};
+const std::vector<const char*> g_extra_positional_argv = {"bench", "--required", "1", "positional"};
+const std::vector<const char*> g_missing_required_argv = {"bench", "-v"};
+} // namespace
+
+template<const std::vector<const char*>& Argv>
+static void BM_ParseError(benchmark::State& state)
+{
+    error_workload load;
+
+    {
+        const allocation_scope scope;
+        for (auto _ : state) {
+            try {
+                load.parser.parse(static_cast<int>(Argv.size()), Argv.data());
+            }
+            catch (const lwcli::bad_parse& e) {
+                benchmark::DoNotOptimize(e.what());
+            }
+        }
+    }
+    report(state, Argv.size());
+}
+
+BENCHMARK(BM_ParseError<g_bad_value_argv>);
+BENCHMARK(BM_ParseError<g_missing_value_argv>);
+BENCHMARK(BM_ParseError<g_extra_positional_argv>);
+BENCHMARK(BM_ParseError<g_missing_required_argv>);
+
+// Parses a misspelled option amongst n_options others, whose nearest aliases are suggested by the exception thrown.
+static void BM_ParseMisspelledOption(benchmark::State& state)
+{
+    const auto n_options = static_cast<std::size_t>(state.range(0));
+
+    std::vector<lwcli::FlagOption> flags(n_options);
+    lwcli::CLIParser parser;
+    for (std::size_t i = 0; i < n_options; ++i) {
+        flags[i].aliases = {"-o" + std::to_string(i), "--option-" + std::to_string(i) + "-long"};
+        flags[i].description = "Description for flag";
+        parser.register_option(flags[i]);
+    }
+    parser.freeze();
+
+    const std::string misspelled = "--optoin-" + std::to_string(n_options / 2) + "-long";
+    const auto argv = std::array{"bench", misspelled.c_str()};
+
+    {
+        const allocation_scope scope;
+        for (auto _ : state) {
+            try {
+                parser.parse(static_cast<int>(argv.size()), argv.data());
+            }
+            catch (const lwcli::bad_positional_count& e) {
+                benchmark::DoNotOptimize(e.suggestions.data());
+            }
+        }
+    }
+    report(state, argv.size());
+}
+
+BENCHMARK(BM_ParseMisspelledOption)->ArgName("options")->Arg(100)->Arg(10'000);
+
+#ifdef __cpp_lib_expected
+template<const std::vector<const char*>& Argv>
+static void BM_TryParseError(benchmark::State& state)
+{
+    error_workload load;
+
+    {
+        const allocation_scope scope;
+        for (auto _ : state) {
+            auto result = load.parser.try_parse(static_cast<int>(Argv.size()), Argv.data());
+            benchmark::DoNotOptimize(result);
+        }
+    }
+    report(state, Argv.size());
+}
+
+BENCHMARK(BM_TryParseError<g_bad_value_argv>);
+BENCHMARK(BM_TryParseError<g_missing_value_argv>);
+BENCHMARK(BM_TryParseError<g_extra_positional_argv>);
+BENCHMARK(BM_TryParseError<g_missing_required_argv>);
+#endif // __cpp_lib_expected
+
+/* Batch benchmarks ------------------------------------------------------------------------------------------------- */
+
+namespace
+{
+// A parser with a flag, a key-value and a positional option, along with n_rows command-lines which each set all three.
+struct batch_workload
+{
+    explicit batch_workload(const std::size_t n_rows)
+    {
+        verbose.aliases = {"-v", "--verbose"};
+        verbose.description = "Description for verbose";
+        threads.aliases = {"-j", "--threads"};
+        threads.description = "Description for threads";
+        input.name = "input";
+        input.description = "Description for input";
+        parser.register_options(verbose, threads, input).freeze();
+
+        lines.reserve(n_rows);
+        for (std::size_t row = 0; row < n_rows; ++row)
+            lines.push_back("bench -v --threads " + std::to_string(row % 64) + " 'input " + std::to_string(row) + "'");
+    }
+
+    lwcli::FlagOption verbose;
+    lwcli::KeyValueOption<int> threads;
+    lwcli::PositionalOption<std::string> input;
+    lwcli::CLIParser parser;
+
+    std::vector<std::string> lines;
+};
+} // namespace
+
+// Note: allocations are not counted, as the counter is not safe to update from the threads of the pool.
+static void BM_ParseBatch(benchmark::State& state)
+{
+    const batch_workload load(static_cast<std::size_t>(state.range(0)));
+    lwcli::BatchParser batch(load.parser, static_cast<unsigned int>(state.range(1)));
+
+    for (auto _ : state) {
+        auto result = batch.parse_lines(load.lines);
+        benchmark::DoNotOptimize(result);
+    }
+    state.counters["rows_per_second"] = benchmark::Counter(
+        static_cast<double>(load.lines.size()),
+        benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK(BM_ParseBatch)
+    ->ArgNames({"rows", "threads"})
+    ->ArgsProduct({{1'000, 100'000}, {1, 2, 4, 8}})
+    ->UseRealTime();
+
+/* Cast benchmarks -------------------------------------------------------------------------------------------------- */
+
+namespace
+{
+template<class Type>
+constexpr const char* g_cast_input = "1234567";
+
+template<>
+constexpr const char* g_cast_input<double> = "3.14159265358979";
+template<>
+constexpr const char* g_cast_input<float> = "2.71828";
+template<>
+constexpr const char* g_cast_input<bool> = "true";
+template<>
+constexpr const char* g_cast_input<std::string> = "some/path/to/a/file.txt";
+template<>
+constexpr const char* g_cast_input<std::vector<int>> = "1, 2, 3, 4, 5, 6, 7, 8";
+} // namespace
+
+template<class Type>
+static void BM_Cast(benchmark::State& state)
+{
+    const std::string_view input = g_cast_input<Type>;
+
+    {
+        const allocation_scope scope;
+        for (auto _ : state) {
+            auto result = lwcli::cast<Type>::from_string(input);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+    state.counters["allocs_per_cast"] =
+        benchmark::Counter(static_cast<double>(g_allocation_count), benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(BM_Cast<int>);
+BENCHMARK(BM_Cast<long long>);
+BENCHMARK(BM_Cast<unsigned int>);
+BENCHMARK(BM_Cast<float>);
+BENCHMARK(BM_Cast<double>);
+BENCHMARK(BM_Cast<bool>);
+BENCHMARK(BM_Cast<std::string>);
+BENCHMARK(BM_Cast<std::vector<int>>);
+
+template<class Type>
+static void BM_CastFailure(benchmark::State& state)
+{
+    for (auto _ : state) {
+        Type result{};
+        benchmark::DoNotOptimize(lwcli::cast<Type>::try_from_string("not-a-value", result));
+    }
+}
+
+BENCHMARK(BM_CastFailure<int>);
+BENCHMARK(BM_CastFailure<double>);
+BENCHMARK(BM_CastFailure<bool>);
@@ -0,0 +1,32 @@
+#ifndef LWCLI_INCLUDE_LWCLI_ENVIRONMENT_HPP
+#define LWCLI_INCLUDE_LWCLI_ENVIRONMENT_HPP
+
+#if defined(_WIN32)
+    #include <stdlib.h> // For access to _environ
+#elif defined(__APPLE__)
+    #include <crt_externs.h> // For access to _NSGetEnviron
+#else
+    #include <unistd.h> // For access to environ
+
+// Note: only declared by unistd.h under _GNU_SOURCE, redeclaring it is harmless otherwise.
+extern char** environ; // NOLINT(readability-redundant-declaration)
+#endif
+
+namespace lwcli
+{
+
+// The environment of the current process, as a null terminated array of 'NAME=VALUE' strings.
+[[nodiscard]] inline char** _environment() noexcept
+{
+#if defined(_WIN32)
+    return _environ;
+#elif defined(__APPLE__)
+    return *_NSGetEnviron();
+#else
+    return environ;
+#endif
+}
+
+} // namespace lwcli
+
+#endif // LWCLI_INCLUDE_LWCLI_ENVIRONMENT_HPP
@@ -0,0 +1,163 @@
+#ifndef LWCLI_INCLUDE_LWCLI_MAPPED_FILE_HPP
+#define LWCLI_INCLUDE_LWCLI_MAPPED_FILE_HPP
+
+#include <cstdint> // For access to size_t
+#include <utility> // For access to std::exchange
+
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+        #define LWCLI_UNDEF_WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+        #define LWCLI_UNDEF_NOMINMAX
+    #endif
+
+    #include <windows.h>
+
+    #ifdef LWCLI_UNDEF_WIN32_LEAN_AND_MEAN
+        #undef WIN32_LEAN_AND_MEAN
+        #undef LWCLI_UNDEF_WIN32_LEAN_AND_MEAN
+    #endif
+    #ifdef LWCLI_UNDEF_NOMINMAX
+        #undef NOMINMAX
+        #undef LWCLI_UNDEF_NOMINMAX
+    #endif
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace lwcli
+{
+
+// Read-only view of a file's contents, mapped copy-on-write. The mapped memory may be modified (e.g. to unescape tokens
+// in place) without affecting the file on disk, and without copying any page that is not written to.
+class _mapped_file
+{
+private:
+    void _unmap() noexcept
+    {
+        if (_data == nullptr)
+            return;
+#ifdef _WIN32
+        UnmapViewOfFile(_data);
+#else
+        munmap(_data, _size);
+#endif
+        _data = nullptr;
+        _size = 0;
+    }
+
+public:
+    _mapped_file() = default;
+
+    explicit _mapped_file(const char* const path) noexcept
+    {
+#ifdef _WIN32
+        const HANDLE file = CreateFileA(
+            path,
+            GENERIC_READ,
+            FILE_SHARE_READ,
+            nullptr,
+            OPEN_EXISTING,
+            FILE_FLAG_SEQUENTIAL_SCAN,
+            nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return;
+
+        LARGE_INTEGER size{};
+        if (GetFileSizeEx(file, &size) != 0) {
+            _open = true;
+            if (size.QuadPart > 0) {
+                const HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+                if (mapping != nullptr) {
+                    _data = static_cast<char*>(MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0));
+                    _size = static_cast<std::size_t>(size.QuadPart);
+                    // Note: the view keeps the mapping alive.
+                    CloseHandle(mapping);
+                }
+                _open = _data != nullptr;
+            }
+        }
+        CloseHandle(file);
+#else
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg, hicpp-vararg)
+        const int file = open(path, O_RDONLY | O_CLOEXEC);
+        if (file == -1)
+            return;
+
+        struct stat status{};
+        if (fstat(file, &status) == 0 && S_ISREG(status.st_mode)) {
+            _open = true;
+            if (status.st_size > 0) {
+                _size = static_cast<std::size_t>(status.st_size);
+                void* const data = mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+                if (data != MAP_FAILED) {
+                    _data = static_cast<char*>(data);
+                    madvise(data, _size, MADV_SEQUENTIAL);
+                }
+                else
+                    _size = 0;
+                _open = _data != nullptr;
+            }
+        }
+        // Note: the mapping remains valid after the file descriptor is closed.
+        close(file);
+#endif
+    }
+
+    _mapped_file(const _mapped_file&) = delete;
+    _mapped_file& operator=(const _mapped_file&) = delete;
+
+    _mapped_file(_mapped_file&& other) noexcept:
+        _data(std::exchange(other._data, nullptr)),
+        _size(std::exchange(other._size, 0)),
+        _open(std::exchange(other._open, false))
+    {}
+
+    _mapped_file& operator=(_mapped_file&& other) noexcept
+    {
+        if (this != &other) {
+            _unmap();
+            _data = std::exchange(other._data, nullptr);
+            _size = std::exchange(other._size, 0);
+            _open = std::exchange(other._open, false);
+        }
+        return *this;
+    }
+
+    ~_mapped_file()
+    {
+        _unmap();
+    }
+
+public:
+    // Note: empty files are successfully opened, but have no data.
+    [[nodiscard]] bool is_open() const noexcept
+    {
+        return _open;
+    }
+
+    [[nodiscard]] char* data() const noexcept
+    {
+        return _data;
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return _size;
+    }
+
+private:
+    char* _data = nullptr;
+    std::size_t _size = 0;
+    bool _open = false;
+};
+
+} // namespace lwcli
+
+#endif // LWCLI_INCLUDE_LWCLI_MAPPED_FILE_HPP
@@ -1,15 +1,27 @@
 #ifndef LWCLI_INCLUDE_LWCLI_OPTIONS_STORES_HPP
 #define LWCLI_INCLUDE_LWCLI_OPTIONS_STORES_HPP
 
-#include <cassert>       // For access to assert
-#include <cstdint>       // For access to size_t
-#include <functional>    // For access to std::invoke
-#include <string>        // For access to std::string
-#include <unordered_map> // For access to std::unordered_map
-#include <vector>        // For access to std::vector
-
+#include <algorithm>       // For access to std::ranges::find, std::ranges::sort, std::ranges::lower_bound
+#include <array>           // For access to std::array
+#include <cassert>         // For access to assert
+#include <concepts>        // For access to std::invocable
+#include <cstdint>         // For access to size_t
+#include <functional>      // For access to std::invoke, std::equal_to
+#include <limits>          // For access to std::numeric_limits
+#include <memory_resource> // For access to std::pmr::memory_resource, std::pmr::get_default_resource
+#include <ranges>          // For access to std::views::keys
+#include <span>            // For access to std::span
+#include <string>          // For access to std::string, std::pmr::string
+#include <string_view>     // For access to std::string_view
+#include <typeinfo>        // For access to typeid
+#include <unordered_map>   // For access to std::pmr::unordered_map
+#include <utility>         // For access to std::move
+#include <vector>          // For access to std::vector, std::pmr::vector
+
+#include "LWCLI/_perfect_hash.hpp"
+#include "LWCLI/_prefix_trie.hpp"
+#include "LWCLI/_suggest.hpp"
 #include "LWCLI/cast.hpp"
-#include "LWCLI/exceptions.hpp"
 #include "LWCLI/options.hpp"
 #include "LWCLI/type_utility.hpp"
 #include "LWCLI/unreachable.hpp"
@@ -28,6 +40,8 @@ public:
     enum class Type : uint8_t {
         FLAG,
         KEY_VALUE,
+        // Reserved for '-h' and '--help'.
+        HELP,
     };
 
     using value_t = unsigned int;
@@ -50,6 +64,12 @@ public:
         return _type;
     }
 
+    // The index of this id amongst those of the same type, dense from zero in registration order.
+    [[nodiscard]] value_t index() const noexcept
+    {
+        return _index;
+    }
+
     [[nodiscard]] bool operator!=(const _named_id&) const noexcept = default;
     [[nodiscard]] bool operator==(const _named_id&) const noexcept = default;
 
@@ -61,69 +81,298 @@ private:
 // Note: all default constructed `_named_id`s are marked as invalid.
 constexpr _named_id _invalid_id{};
 
+// Converts value and writes it to result_ptr (A pointer to Type), returning whether conversion succeeded. Casts
+// defining try_from_string(...) are used without exceptions, those only defining from_string(...) have their exceptions
+// caught. Either way, the result is left untouched unless conversion succeeds.
 template<class Type>
-void _on_invoke_valued_option(const char* const value, void* const result_ptr)
+[[nodiscard]] bool _on_invoke_valued_option(const std::string_view value, void* const result_ptr)
 {
     using naked_type = unwrapped_t<Type>;
-    try {
-        *static_cast<Type*>(result_ptr) = cast<naked_type>::from_string(value);
+    auto& result = *static_cast<Type*>(result_ptr);
+
+    if constexpr (_non_throwing_cast<naked_type>) {
+        // Note: casts may write to their output before failing (e.g. the parsed prefix of "12x"), hence the local.
+        naked_type naked_result{};
+        if (cast<naked_type>::try_from_string(value, naked_result) != std::errc{})
+            return false;
+        result = std::move(naked_result);
+        return true;
     }
-    catch (...) {
-        // TODO(Caetano): perhaps add method of displaying pretty names
-        throw _bad_cast(value, typeid(naked_type).name());
+    else {
+        try {
+            result = _from_string<naked_type>(value);
+            return true;
+        }
+        catch (...) {
+            return false;
+        }
     }
 }
 
+// Transparent hash allowing `_alias_to_id` to be queried by std::string_view (and, by extension, const char*) without
+// first materialising a std::string.
+struct _string_hash
+{
+    using is_transparent = void;
+
+    [[nodiscard]] std::size_t operator()(const std::string_view str) const noexcept
+    {
+        return std::hash<std::string_view>{}(str);
+    }
+};
+
+template<class Value>
+using _string_map = std::pmr::unordered_map<std::pmr::string, Value, _string_hash, std::equal_to<>>;
+
+using _alias_map = _string_map<_named_id>;
+
+// Converts value and appends it to the container at container_ptr (A pointer to Container), returning whether
+// conversion succeeded.
+template<class Type, class Container>
+[[nodiscard]] bool _on_invoke_append_option(const std::string_view value, void* const container_ptr)
+{
+    Type element{};
+    if (!_on_invoke_valued_option<Type>(value, &element))
+        return false;
+    static_cast<Container*>(container_ptr)->push_back(std::move(element));
+    return true;
+}
+
+// Empties the container at container_ptr (A pointer to Container), making room for n_values values.
+template<class Container>
+void _on_prepare_append_option(void* const container_ptr, const std::size_t n_values)
+{
+    auto& container = *static_cast<Container*>(container_ptr);
+    container.clear();
+    if constexpr (requires { container.reserve(n_values); })
+        container.reserve(n_values);
+}
+
+// The operations of a lazy option (See LazyValue), whose value is recorded by the parse rather than converted.
+struct _lazy_operations
+{
+    // Records the value, along with the key naming it (Empty for positional options).
+    void (*record)(void*, std::string_view key, std::string_view value) noexcept;
+    // Converts the value recorded, returning false if it could not be converted.
+    bool (*convert)(void*);
+    // Forgets the value recorded, as though none were given.
+    void (*discard)(void*) noexcept;
+};
+
 struct _erased_valued_option
 {
     void* result;
-    void (*callback)(const char*, void*);
+    bool (*callback)(std::string_view, void*);
+    // TODO(Caetano): perhaps add method of displaying pretty names
+    const char* type_name;
+    // Set only for append options, whose values are all counted before the first is appended.
+    void (*prepare)(void*, std::size_t) = nullptr;
+    // Set only for lazy options, in which case callback is unused.
+    const _lazy_operations* lazy = nullptr;
 };
 
+template<class Type>
+[[nodiscard]] _erased_valued_option _erase_valued_option(Type& result) noexcept
+{
+    return {&result, _on_invoke_valued_option<Type>, typeid(unwrapped_t<Type>).name()};
+}
+
+template<class Type, class Container>
+[[nodiscard]] _erased_valued_option _erase_append_option(Container& values) noexcept
+{
+    return {
+        &values,
+        _on_invoke_append_option<Type, Container>,
+        typeid(unwrapped_t<Type>).name(),
+        _on_prepare_append_option<Container>};
+}
+
+// Converts value and writes it to destination, returning whether conversion succeeded. Lazy options merely record it
+// (Along with key), unless validate_lazy is set, in which case it is converted at once all the same.
+[[nodiscard]] inline bool _invoke_valued_option(
+    const _erased_valued_option& option,
+    const std::string_view key,
+    const std::string_view value,
+    void* const destination,
+    const bool validate_lazy)
+{
+    if (option.lazy == nullptr) [[likely]]
+        return std::invoke(option.callback, value, destination);
+
+    option.lazy->record(destination, key, value);
+    return !validate_lazy || option.lazy->convert(destination);
+}
+
+// Discards the value recorded by each lazy option amongst options.
+inline void _discard_lazy_values(const std::span<const _erased_valued_option> options) noexcept
+{
+    for (const auto& option : options) {
+        if (option.lazy != nullptr)
+            option.lazy->discard(option.result);
+    }
+}
+
+[[nodiscard]] inline std::size_t _index_of_result(
+    const std::span<const _erased_valued_option> options,
+    const void* const result_ptr) noexcept
+{
+    const auto loc = std::ranges::find(options, result_ptr, &_erased_valued_option::result);
+    return static_cast<std::size_t>(loc - options.begin());
+}
+
 // Helper class to store and retrieve named options (i.e. flag and key-value options) in O(1) time. Interfacing with
 // this class involves first registering an option using register_flag(...), returning an id object which may then be
 // used to:
 // - parse the option using invoke_flag(...) and invoke_key_value(...).
 // - retrieving the description of the option with description_of(...).
 //
-// Id's can also be retrieved by alias, via the id_of(...) member.
+// Id's can also be retrieved by alias, via the id_of(...) member. Once all options have been registered, freeze()
+// may be called to switch alias lookups over to a minimal perfect hash. Similarly, index_prefixes() enables the lookup
+// of long aliases (i.e. those prefixed by '--') by their unambiguous prefixes, via match_prefix(...). The aliases
+// nearest to a misspelled one are found by nearest_aliases(...), and those starting with a prefix (e.g. to complete it)
+// by aliases_starting_with(...), both from indices built by freeze().
+//
+// The '-h' and '--help' aliases are reserved, and always map to an id of type _named_id::Type::HELP. This allows the
+// parser to detect requests for help whilst classifying each argument, rather than in a separate pass.
+//
+// All storage is allocated from the memory resource given upon construction.
 class _named_option_store
 {
 private:
     void _register_aliases(const _named_id id, const std::vector<std::string>& aliases)
     {
         assert(!aliases.empty() && "Named options must define atleast one identifier.");
+        assert(!is_frozen() && "Options cannot be registered after freezing.");
 
-        _alias_to_id.reserve(_alias_to_id.size() + aliases.size());
+        // Note: not reserving here, growing by exactly aliases.size() on every call would defeat the geometric growth
+        // of _alias_to_id and rehash on (almost) every registration. Use reserve(...) for bulk registration instead.
         for (const auto& alias : aliases) {
 #ifndef LWCLI_DO_NOT_ENFORCE_PREFIXES
             assert(alias.starts_with("-") || alias.starts_with("--"));
 #endif // LWCLI_DO_NOT_ENFORCE_PREFIXES
 
-            assert(!_alias_to_id.contains(alias) && "Duplicate option alias detected.");
             assert(alias.find(' ') == std::string::npos && "Aliases should contain no spaces.");
 
+            if (const auto loc = _alias_to_id.find(std::string_view(alias)); loc != _alias_to_id.end()) {
+                // Note: options defining a reserved alias are simply never matched by it.
+                assert(loc->second.type() == _named_id::Type::HELP && "Duplicate option alias detected.");
+                continue;
+            }
             _alias_to_id.emplace(alias, id);
+            _set_short_id(alias, id);
         }
+        _ids.push_back(id);
+        _prefixes_indexed = false;
+        _suggestions_indexed = false;
     }
 
 public:
-    void register_flag(FlagOption& option)
+    explicit _named_option_store(std::pmr::memory_resource* const resource = std::pmr::get_default_resource()):
+        _alias_to_id(resource),
+        _frozen_alias_to_id(resource),
+        _prefixes(resource),
+        _suggestions(resource),
+        _sorted_aliases(resource),
+        _ids(resource),
+        _flag_count_ptrs(resource),
+        _flag_descriptions(resource),
+        _flag_aliases(resource),
+        _key_value_options(resource),
+        _key_value_descriptions(resource),
+        _key_value_aliases(resource)
+    {
+        for (const char* const alias : {"-h", "--help"}) {
+            _alias_to_id.emplace(alias, _named_id(_named_id::Type::HELP, 0));
+            _set_short_id(alias, _named_id(_named_id::Type::HELP, 0));
+        }
+    }
+
+    void reserve(const std::size_t n_aliases)
+    {
+        _alias_to_id.reserve(n_aliases);
+    }
+
+    void freeze()
+    {
+        std::pmr::memory_resource* const resource = _ids.get_allocator().resource();
+
+        _frozen_alias_to_id = _frozen_string_map<_named_id>(_alias_to_id, resource);
+        const auto aliases = _alias_to_id | std::views::keys;
+        _suggestions = _suggestion_index(aliases, resource);
+        _suggestions_indexed = true;
+        _sorted_aliases.assign(aliases.begin(), aliases.end());
+        std::ranges::sort(_sorted_aliases);
+        _frozen = true;
+    }
+
+    [[nodiscard]] bool is_frozen() const noexcept
+    {
+        return _frozen;
+    }
+
+    // Builds the trie of long aliases searched by match_prefix(...), which must be rebuilt after registering another
+    // option.
+    void index_prefixes()
+    {
+        std::pmr::memory_resource* const resource = _ids.get_allocator().resource();
+
+        std::pmr::vector<std::pair<std::string_view, _named_id>> long_aliases(resource);
+        for (const auto& [alias, id] : _alias_to_id) {
+            if (_is_long_alias(alias))
+                long_aliases.emplace_back(alias, id);
+        }
+        _prefixes = _prefix_trie<_named_id>(long_aliases, resource);
+        _prefixes_indexed = true;
+    }
+
+    [[nodiscard]] bool prefixes_indexed() const noexcept
+    {
+        return _prefixes_indexed;
+    }
+
+public:
+    [[nodiscard]] _named_id register_flag(FlagOption& option)
     {
         // To keep with CLI best practices, flag options must always have a description
         assert(!option.description.empty());
 
-        _register_aliases(
-            _named_id(_named_id::Type::FLAG, static_cast<_named_id::value_t>(_flag_count_ptrs.size())),
-            option.aliases);
+        const _named_id id(_named_id::Type::FLAG, static_cast<_named_id::value_t>(_flag_count_ptrs.size()));
+        _register_aliases(id, option.aliases);
 
         _flag_count_ptrs.push_back(&option.count);
         _flag_descriptions.push_back(&option.description);
+        _flag_aliases.push_back(&option.aliases);
         assert(_flag_count_ptrs.size() == _flag_descriptions.size());
+
+        return id;
     }
 
     template<class Type>
     [[nodiscard]] _named_id register_key_value(KeyValueOption<Type>& option)
+    {
+        return _register_key_value(option, _erase_valued_option(option.value));
+    }
+
+    template<class Type, class Container>
+    [[nodiscard]] _named_id register_key_value(AppendKeyValueOption<Type, Container>& option)
+    {
+        _has_append_options = true;
+        return _register_key_value(option, _erase_append_option<Type>(option.values));
+    }
+
+    // Registers a lazy option, given its value already erased (See _erase_lazy_option(...)).
+    template<class Option>
+    [[nodiscard]] _named_id register_lazy_key_value(Option& option, const _erased_valued_option erased)
+    {
+        assert(erased.lazy != nullptr);
+
+        _has_lazy_options = true;
+        return _register_key_value(option, erased);
+    }
+
+private:
+    template<class Option>
+    [[nodiscard]] _named_id _register_key_value(Option& option, const _erased_valued_option erased)
     {
         // To keep with CLI best practices, key-value options must always have a description.
         assert(!option.description.empty());
@@ -131,20 +380,80 @@ public:
         const _named_id id(_named_id::Type::KEY_VALUE, static_cast<_named_id::value_t>(_key_value_options.size()));
         _register_aliases(id, option.aliases);
 
-        _key_value_options.emplace_back(&option.value, _on_invoke_valued_option<Type>);
+        _key_value_options.push_back(erased);
         _key_value_descriptions.push_back(&option.description);
+        _key_value_aliases.push_back(&option.aliases);
         assert(_key_value_options.size() == _key_value_descriptions.size());
 
         return id;
     }
 
 public:
-    [[nodiscard]] _named_id id_of(const std::string& alias) const
+    [[nodiscard]] _named_id id_of(const std::string_view alias) const noexcept
     {
+        if (_frozen) {
+            const _named_id* const id = _frozen_alias_to_id.find(alias);
+            return id != nullptr ? *id : _invalid_id;
+        }
+
         const auto loc = _alias_to_id.find(alias);
         return loc != _alias_to_id.end() ? loc->second : _invalid_id;
     }
 
+    // Resolves a prefix of the long aliases of exactly one option to its id, in time proportional to the length of
+    // prefix (Regardless of the number of aliases). Prefixes of the aliases of several options are AMBIGUOUS, whilst
+    // those of none, or that are not themselves long (i.e. '--' alone), match NONE.
+    //
+    // Note: index_prefixes() must have been called since the last registration.
+    [[nodiscard]] _prefix_match<_named_id> match_prefix(const std::string_view prefix) const noexcept
+    {
+        assert(_prefixes_indexed && "Prefixes must be indexed before being matched.");
+
+        if (!_is_long_alias(prefix))
+            return {};
+        return _prefixes.find(prefix);
+    }
+
+    // The aliases nearest to query (Each a few edits away from it), see _suggestion_index::nearest(...).
+    // Note: until frozen, the index is built upon the first call following a registration. Once frozen, it is never
+    // rebuilt, so may be searched concurrently.
+    [[nodiscard]] std::vector<std::string> nearest_aliases(const std::string_view query) const
+    {
+        if (!_suggestions_indexed) {
+            _suggestions = _suggestion_index(_alias_to_id | std::views::keys, _ids.get_allocator().resource());
+            _suggestions_indexed = true;
+        }
+        return _suggestions.nearest(query);
+    }
+
+    // The id of the short option (i.e. that with an alias of a single character prefixed by '-') named by chr, as would
+    // id_of(...) for its alias, without hashing.
+    [[nodiscard]] _named_id short_id_of(const char chr) const noexcept
+    {
+        return _short_ids[static_cast<unsigned char>(chr)];
+    }
+
+    // The aliases starting with prefix, in lexicographical order.
+    // Note: until frozen, every alias is compared upon every call.
+    [[nodiscard]] std::vector<std::string_view> aliases_starting_with(const std::string_view prefix) const
+    {
+        std::vector<std::string_view> aliases;
+        if (_frozen) {
+            for (auto loc = std::ranges::lower_bound(_sorted_aliases, prefix);
+                 loc != _sorted_aliases.end() && loc->starts_with(prefix);
+                 ++loc)
+                aliases.push_back(*loc);
+            return aliases;
+        }
+
+        for (const auto& [alias, id] : _alias_to_id) {
+            if (alias.starts_with(prefix))
+                aliases.emplace_back(alias);
+        }
+        std::ranges::sort(aliases);
+        return aliases;
+    }
+
     [[nodiscard]] const std::string& description_of(const _named_id id) const noexcept
     {
         switch (id.type()) {
@@ -152,43 +461,209 @@ public:
             return *_flag_descriptions[id._index];
         case _named_id::Type::KEY_VALUE:
             return *_key_value_descriptions[id._index];
+        case _named_id::Type::HELP:
+            break;
         }
         // Note: needed to stop clang-tidy from complaining (Even though enums are exhausted)...
         _unreachable();
     }
 
+    // The aliases the option was registered with (Including any reserved alias it may define).
+    [[nodiscard]] const std::vector<std::string>& aliases_of(const _named_id id) const noexcept
+    {
+        switch (id.type()) {
+        case _named_id::Type::FLAG:
+            return *_flag_aliases[id._index];
+        case _named_id::Type::KEY_VALUE:
+            return *_key_value_aliases[id._index];
+        case _named_id::Type::HELP:
+            break;
+        }
+        _unreachable();
+    }
+
+    [[nodiscard]] _named_id key_value_at(const std::size_t index) const noexcept
+    {
+        assert(index < _key_value_options.size());
+
+        return {_named_id::Type::KEY_VALUE, static_cast<_named_id::value_t>(index)};
+    }
+
+    // The index of the flag option counting into count_ptr, or flag_count() if there is none.
+    [[nodiscard]] std::size_t flag_index_of(const FlagOption::count_t* const count_ptr) const noexcept
+    {
+        return static_cast<std::size_t>(std::ranges::find(_flag_count_ptrs, count_ptr) - _flag_count_ptrs.begin());
+    }
+
+    // The index of the key-value option storing its value at result_ptr, or key_value_count() if there is none.
+    [[nodiscard]] std::size_t key_value_index_of(const void* const result_ptr) const noexcept
+    {
+        return _index_of_result(_key_value_options, result_ptr);
+    }
+
+    [[nodiscard]] std::size_t flag_count() const noexcept
+    {
+        return _flag_count_ptrs.size();
+    }
+
+    [[nodiscard]] std::size_t key_value_count() const noexcept
+    {
+        return _key_value_options.size();
+    }
+
     void invoke_flag_option(const _named_id id) const noexcept
     {
         assert(id.type() == _named_id::Type::FLAG);
 
-        ++*static_cast<FlagOption::count_t*>(_flag_count_ptrs[id._index]);
+        ++*_flag_count_ptrs[id._index];
     }
 
-    void invoke_key_value_option(const _named_id id, const char* const value) const noexcept(false)
+    // Returns false if value (Given by key) could not be converted to the type expected by the option.
+    [[nodiscard]] bool invoke_key_value_option(
+        const _named_id id,
+        const std::string_view key,
+        const std::string_view value) const
     {
         assert(id.type() == _named_id::Type::KEY_VALUE);
 
+        const auto& option = _key_value_options[id._index];
+        return _invoke_valued_option(option, key, value, option.result, _validate_lazy_options);
+    }
+
+    // As above, but writes the value to destination (Which must point to an object of the option's type) rather than
+    // to the option itself.
+    [[nodiscard]] bool invoke_key_value_option(
+        const _named_id id,
+        const std::string_view key,
+        const std::string_view value,
+        void* const destination) const
+    {
+        assert(id.type() == _named_id::Type::KEY_VALUE);
+
+        return _invoke_valued_option(_key_value_options[id._index], key, value, destination, _validate_lazy_options);
+    }
+
+    // Whether lazy options convert their values as they are parsed, rather than upon first access.
+    void validate_lazy_options(const bool enable) noexcept
+    {
+        _validate_lazy_options = enable;
+    }
+
+    // Discards the values recorded by lazy options (Their own, rather than those of any ParseResult).
+    void discard_lazy_values() const noexcept
+    {
+        if (_has_lazy_options)
+            _discard_lazy_values(_key_value_options);
+    }
+
+    [[nodiscard]] bool has_append_options() const noexcept
+    {
+        return _has_append_options;
+    }
+
+    // Whether id names an append option, whose values must be counted before any is appended (See
+    // prepare_key_value_option(...)).
+    [[nodiscard]] bool is_append_option(const _named_id id) const noexcept
+    {
+        assert(id.type() == _named_id::Type::KEY_VALUE);
+
+        return _key_value_options[id._index].prepare != nullptr;
+    }
+
+    // Empties the container of the append option id, making room for n_values values.
+    void prepare_key_value_option(const _named_id id, const std::size_t n_values) const
+    {
+        assert(is_append_option(id));
+
         const auto option = _key_value_options[id._index];
-        // Note: this is expected to throw lwcli::_bad_cast
-        std::invoke(option.callback, value, option.result);
+        std::invoke(option.prepare, option.result, n_values);
+    }
+
+    // As above, but prepares the container at destination rather than the option's own.
+    void prepare_key_value_option(const _named_id id, const std::size_t n_values, void* const destination) const
+    {
+        assert(is_append_option(id));
+
+        std::invoke(_key_value_options[id._index].prepare, destination, n_values);
+    }
+
+    [[nodiscard]] const char* type_name_of(const _named_id id) const noexcept
+    {
+        assert(id.type() == _named_id::Type::KEY_VALUE);
+
+        return _key_value_options[id._index].type_name;
     }
 
 public:
-    [[nodiscard]] const std::unordered_map<std::string, _named_id>& alias_to_id() const noexcept
+    [[nodiscard]] const _alias_map& alias_to_id() const noexcept
     {
         return _alias_to_id;
     }
 
+    // The ids of all registered options, in registration order.
+    [[nodiscard]] std::span<const _named_id> ids() const noexcept
+    {
+        return _ids;
+    }
+
 private:
-    std::unordered_map<std::string, _named_id> _alias_to_id;
+    [[nodiscard]] static bool _is_long_alias(const std::string_view alias) noexcept
+    {
+        return alias.size() > 2 && alias.starts_with("--");
+    }
 
-    std::vector<void*> _flag_count_ptrs;
-    std::vector<const std::string*> _flag_descriptions;
+    void _set_short_id(const std::string_view alias, const _named_id id) noexcept
+    {
+        if (alias.size() == 2 && alias.front() == '-' && alias.back() != '-')
+            _short_ids[static_cast<unsigned char>(alias.back())] = id;
+    }
 
-    std::vector<_erased_valued_option> _key_value_options;
-    std::vector<const std::string*> _key_value_descriptions;
+    _alias_map _alias_to_id;
+    _frozen_string_map<_named_id> _frozen_alias_to_id;
+    // Indexed by the character of each short alias, see short_id_of(...).
+    std::array<_named_id, 256> _short_ids{};
+    bool _frozen = false;
+    _prefix_trie<_named_id> _prefixes;
+    bool _prefixes_indexed = false;
+    // Note: built lazily by nearest_aliases(...) until frozen, see freeze().
+    mutable _suggestion_index _suggestions;
+    mutable bool _suggestions_indexed = false;
+    // Views of the keys of _alias_to_id, sorted once frozen.
+    std::pmr::vector<std::string_view> _sorted_aliases;
+    std::pmr::vector<_named_id> _ids;
+
+    std::pmr::vector<FlagOption::count_t*> _flag_count_ptrs;
+    std::pmr::vector<const std::string*> _flag_descriptions;
+    std::pmr::vector<const std::vector<std::string>*> _flag_aliases;
+
+    std::pmr::vector<_erased_valued_option> _key_value_options;
+    std::pmr::vector<const std::string*> _key_value_descriptions;
+    std::pmr::vector<const std::vector<std::string>*> _key_value_aliases;
+    bool _has_append_options = false;
+    bool _has_lazy_options = false;
+    bool _validate_lazy_options = false;
 };
 
+// Converts value and hands it to the consumer of the PositionalSink at sink_ptr, returning whether conversion
+// succeeded. Note: the consumer is called directly from here, so is free to be inlined alongside the conversion itself.
+template<class Type, class Consumer>
+[[nodiscard]] bool _on_invoke_positional_sink(const std::string_view value, void* const sink_ptr)
+{
+    auto& sink = *static_cast<PositionalSink<Type, Consumer>*>(sink_ptr);
+
+    Type result{};
+    if (!_on_invoke_valued_option<Type>(value, &result))
+        return false;
+
+    if constexpr (std::invocable<Consumer&, Type&&>)
+        std::invoke(sink.consumer, std::move(result));
+    else
+        *sink.consumer++ = std::move(result);
+
+    ++sink.count;
+    return true;
+}
+
 struct _positional_description
 {
     std::string* name_ptr;
@@ -198,6 +673,12 @@ struct _positional_description
 class _positional_options_store
 {
 public:
+    explicit _positional_options_store(
+        std::pmr::memory_resource* const resource = std::pmr::get_default_resource()) noexcept:
+        _options(resource),
+        _descriptions(resource)
+    {}
+
     template<class Type>
     void register_option(PositionalOption<Type>& option)
     {
@@ -205,31 +686,119 @@ public:
         assert(!option.name.empty());
         assert(!option.description.empty());
 
-        _options.emplace_back(&option.value, _on_invoke_valued_option<Type>);
-        _descriptions.emplace_back(&option.name, &option.description);
+        _options.push_back(_erase_valued_option(option.value));
+        _add_description(option.name, option.description);
     }
 
-    void invoke_at(const size_t position, const char* const value) const noexcept(false)
+    // Registers a lazy option, given its value already erased (See _erase_lazy_option(...)).
+    template<class Option>
+    void register_lazy_option(Option& option, const _erased_valued_option erased)
     {
-        const auto max_positional = _options.size();
-        if (position < max_positional) {
-            const auto option = _options[position];
-            // Note: this is expected to throw lwcli::_bad_cast
-            std::invoke(option.callback, value, option.result);
-        }
-        else
-            throw bad_positional_count(value, max_positional);
+        assert(!option.name.empty());
+        assert(!option.description.empty());
+        assert(erased.lazy != nullptr);
+
+        _options.push_back(erased);
+        _add_description(option.name, option.description);
+        _has_lazy_options = true;
+    }
+
+    template<class Type, class Consumer>
+    void register_sink(PositionalSink<Type, Consumer>& sink)
+    {
+        assert(!sink.name.empty());
+        assert(!sink.description.empty());
+        assert(!has_sink() && "Only one positional sink may be registered.");
+
+        _sink = {&sink, _on_invoke_positional_sink<Type, Consumer>, typeid(Type).name()};
+        _descriptions.emplace_back(&sink.name, &sink.description);
+    }
+
+    // Returns false if value could not be converted to the type expected by the option at position.
+    [[nodiscard]] bool invoke_at(const size_t position, const std::string_view value) const
+    {
+        assert(accepts(position));
+
+        const auto& option = _option_at(position);
+        return _invoke_valued_option(option, {}, value, option.result, _validate_lazy_options);
+    }
+
+    // As above, but writes the value to destination (Which must point to an object of the option's type) rather than
+    // to the option itself. Not applicable to the sink.
+    [[nodiscard]] bool invoke_at(const size_t position, const std::string_view value, void* const destination) const
+    {
+        assert(position < _options.size());
+
+        return _invoke_valued_option(_options[position], {}, value, destination, _validate_lazy_options);
+    }
+
+    // Whether lazy options convert their values as they are parsed, rather than upon first access.
+    void validate_lazy_options(const bool enable) noexcept
+    {
+        _validate_lazy_options = enable;
+    }
+
+    // Discards the values recorded by lazy options (Their own, rather than those of any ParseResult).
+    void discard_lazy_values() const noexcept
+    {
+        if (_has_lazy_options)
+            _discard_lazy_values(_options);
+    }
+
+    // The position of the option storing its value at result_ptr, or size() if there is none.
+    [[nodiscard]] size_t position_of(const void* const result_ptr) const noexcept
+    {
+        return _index_of_result(_options, result_ptr);
+    }
+
+    [[nodiscard]] const char* type_name_at(const size_t position) const noexcept
+    {
+        return _option_at(position).type_name;
+    }
+
+    // Whether a positional argument at the given position may be parsed (i.e. is within the number of registered
+    // positional options, or is consumed by a sink).
+    [[nodiscard]] bool accepts(const size_t position) const noexcept
+    {
+        return position < _options.size() || has_sink();
+    }
+
+    [[nodiscard]] bool has_sink() const noexcept
+    {
+        return _sink.result != nullptr;
+    }
+
+    // The number of positional options registered, excluding any sink.
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return _options.size();
+    }
+
+private:
+    [[nodiscard]] const _erased_valued_option& _option_at(const size_t position) const noexcept
+    {
+        return position < _options.size() ? _options[position] : _sink;
+    }
+
+    // Note: the sink receives the positionals beyond all others, so is described last (Whenever it was registered).
+    void _add_description(std::string& name, std::string& description)
+    {
+        const auto position = _descriptions.end() - (has_sink() ? 1 : 0);
+        _descriptions.insert(position, {&name, &description});
     }
 
 public:
-    [[nodiscard]] const std::vector<_positional_description>& descriptions() const noexcept
+    [[nodiscard]] std::span<const _positional_description> descriptions() const noexcept
     {
         return _descriptions;
     }
 
 private:
-    std::vector<_erased_valued_option> _options;
-    std::vector<_positional_description> _descriptions;
+    std::pmr::vector<_erased_valued_option> _options;
+    _erased_valued_option _sink{nullptr, nullptr, nullptr};
+    std::pmr::vector<_positional_description> _descriptions;
+    bool _has_lazy_options = false;
+    bool _validate_lazy_options = false;
 };
 
 } // namespace lwcli
@@ -240,13 +809,15 @@ struct std::hash<lwcli::_named_id>
     [[nodiscard]] std::size_t operator()(const lwcli::_named_id& id) const noexcept
     {
         const auto index = static_cast<size_t>(id._index);
-        assert(index < std::numeric_limits<size_t>::max() / 2 && "id too large, uniqueness of hash not guaranteed.");
+        assert(index < std::numeric_limits<size_t>::max() / 3 && "id too large, uniqueness of hash not guaranteed.");
 
         switch (id.type()) {
         case lwcli::_named_id::Type::FLAG:
-            return 2 * index;
+            return 3 * index;
         case lwcli::_named_id::Type::KEY_VALUE:
-            return 2 * index + 1;
+            return 3 * index + 1;
+        case lwcli::_named_id::Type::HELP:
+            return 3 * index + 2;
         }
         lwcli::_unreachable();
     }
@@ -0,0 +1,43 @@
+#ifndef LWCLI_INCLUDE_LWCLI_OUTPUT_HPP
+#define LWCLI_INCLUDE_LWCLI_OUTPUT_HPP
+
+#include <cstdio>      // For access to std::fflush, std::fwrite
+#include <string_view> // For access to std::string_view
+
+#ifndef _WIN32
+    #include <cerrno>   // For access to errno
+    #include <unistd.h> // For access to write, STDOUT_FILENO
+#endif
+
+namespace lwcli
+{
+
+// Writes text to the standard output in its entirety, with as few system calls as the platform allows (A single
+// write(2), bar interruptions or partial writes). Anything already buffered by stdio (And, by extension, std::cout when
+// synchronised with stdio) is flushed first, so as to preserve ordering.
+inline void _write_stdout(void* /*context*/, const std::string_view text) noexcept
+{
+    std::fflush(stdout);
+
+#ifdef _WIN32
+    std::fwrite(text.data(), 1, text.size(), stdout);
+    std::fflush(stdout);
+#else
+    const char* data = text.data();
+    std::size_t remaining = text.size();
+    while (remaining != 0) {
+        const auto written = write(STDOUT_FILENO, data, remaining);
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+            return;
+        }
+        data += written;
+        remaining -= static_cast<std::size_t>(written);
+    }
+#endif
+}
+
+} // namespace lwcli
+
+#endif // LWCLI_INCLUDE_LWCLI_OUTPUT_HPP
@@ -0,0 +1,335 @@
+#ifndef LWCLI_INCLUDE_LWCLI_PERFECT_HASH_HPP
+#define LWCLI_INCLUDE_LWCLI_PERFECT_HASH_HPP
+
+#include <algorithm>       // For access to std::ranges::sort, std::ranges::find, std::max
+#include <array>           // For access to std::array
+#include <bit>             // For access to std::endian
+#include <cstdint>         // For access to uint32_t, uint64_t
+#include <cstring>         // For access to std::memcpy, std::memcmp
+#include <memory_resource> // For access to std::pmr::memory_resource, std::pmr::get_default_resource
+#include <span>            // For access to std::span
+#include <string>          // For access to std::pmr::string
+#include <string_view>     // For access to std::string_view
+#include <type_traits>     // For access to std::is_constant_evaluated
+#include <utility>         // For access to std::pair
+#include <vector>          // For access to std::pmr::vector
+
+namespace lwcli
+{
+
+// Finaliser taken from MurmurHash3's fmix64, cheap and with good avalanche properties.
+[[nodiscard]] constexpr std::uint64_t _mix64(std::uint64_t value) noexcept
+{
+    value ^= value >> 33U;
+    value *= 0xFF51AFD7ED558CCDULL;
+    value ^= value >> 33U;
+    value *= 0xC4CEB9FE1A85EC53ULL;
+    value ^= value >> 33U;
+    return value;
+}
+
+// Loads size (At most 8) bytes as would std::memcpy into a zeroed word, which cannot be called whilst constant
+// evaluating, hence the bytes are then shifted into place according to the byte order of the target.
+[[nodiscard]] constexpr std::uint64_t _load_word(const char* const data, const std::size_t size) noexcept
+{
+    std::uint64_t word = 0;
+    if (!std::is_constant_evaluated()) {
+        std::memcpy(&word, data, size);
+        return word;
+    }
+
+    for (std::size_t i = 0; i < size; ++i) {
+        const std::size_t shift = std::endian::native == std::endian::little ? i * 8 : (7 - i) * 8;
+        word |= std::uint64_t{static_cast<unsigned char>(data[i])} << shift;
+    }
+    return word;
+}
+
+// Hashes 8 bytes at a time, which is plenty for the short strings aliases tend to be. Note: hashes computed whilst
+// constant evaluating are identical to those computed at runtime.
+[[nodiscard]] constexpr std::uint64_t _hash_bytes(const std::string_view str, const std::uint64_t salt) noexcept
+{
+    constexpr std::uint64_t golden_ratio = 0x9E3779B97F4A7C15ULL;
+    constexpr std::size_t word_size = sizeof(std::uint64_t);
+
+    std::uint64_t hash = salt ^ (str.size() * golden_ratio);
+    const char* data = str.data();
+    std::size_t remaining = str.size();
+    for (; remaining >= word_size; remaining -= word_size, data += word_size)
+        hash = _mix64(hash ^ _load_word(data, word_size)) * golden_ratio;
+
+    if (remaining > 0)
+        hash = _mix64(hash ^ _load_word(data, remaining)) * golden_ratio;
+    return _mix64(hash);
+}
+
+// Maps a 64-bit hash uniformly onto [0, range) without a division.
+[[nodiscard]] constexpr std::uint32_t _reduce(const std::uint64_t hash, const std::uint32_t range) noexcept
+{
+    return static_cast<std::uint32_t>(((hash >> 32U) * range) >> 32U);
+}
+
+// Immutable string-to-value map backed by a minimal perfect hash (hash-and-displace, see Belazzougui et al. "Hash,
+// displace, and compress"). Keys are stored back to back in a single string table, so a lookup amounts to: one pass
+// over the key to hash it, two array reads, and a single memcmp.
+//
+// Every allocation, including those made only whilst building, is made from the given memory resource.
+template<class Value>
+class _frozen_string_map
+{
+private:
+    struct _slot
+    {
+        std::uint32_t offset;
+        std::uint32_t length;
+        Value value;
+    };
+
+    // Average number of keys per displacement bucket, larger values trade build time for a smaller seed table.
+    static constexpr std::size_t KEYS_PER_BUCKET = 4;
+    static constexpr std::uint32_t MAX_SEED_ATTEMPTS = 1U << 16U;
+
+    [[nodiscard]] std::uint32_t _bucket_of(const std::uint64_t hash) const noexcept
+    {
+        return static_cast<std::uint32_t>(hash % _seeds.size());
+    }
+
+    [[nodiscard]] std::uint32_t _slot_of(const std::uint64_t hash, const std::uint32_t seed) const noexcept
+    {
+        return _reduce(_mix64(hash ^ seed), static_cast<std::uint32_t>(_slots.size()));
+    }
+
+    // Attempts to place every key with the given salt, returns false if two keys could not be separated. On success,
+    // slot_entries[i] holds the index (into keys) of the key placed in slot i.
+    [[nodiscard]] bool _try_build(
+        const std::pmr::vector<std::string_view>& keys,
+        const std::uint64_t salt,
+        std::pmr::vector<std::uint32_t>& slot_entries)
+    {
+        const auto n_keys = static_cast<std::uint32_t>(keys.size());
+        std::pmr::memory_resource* const resource = _seeds.get_allocator().resource();
+
+        _salt = salt;
+        _seeds.assign(std::max<std::size_t>(1, n_keys / KEYS_PER_BUCKET), 0);
+        _slots.assign(n_keys, _slot{0, 0, Value{}});
+
+        std::pmr::vector<std::pmr::vector<std::pair<std::uint64_t, std::uint32_t>>> buckets(_seeds.size(), resource);
+        for (std::uint32_t i = 0; i < n_keys; ++i) {
+            const auto hash = _hash_bytes(keys[i], _salt);
+            buckets[_bucket_of(hash)].emplace_back(hash, i);
+        }
+
+        std::pmr::vector<std::uint32_t> bucket_order(buckets.size(), resource);
+        for (std::uint32_t i = 0; i < bucket_order.size(); ++i)
+            bucket_order[i] = i;
+        // Place the largest buckets first, whilst the table is still sparse.
+        std::ranges::sort(bucket_order, [&](const auto lhs, const auto rhs) {
+            return buckets[lhs].size() > buckets[rhs].size();
+        });
+
+        std::pmr::vector<bool> occupied(n_keys, false, resource);
+        std::pmr::vector<std::uint32_t> candidate_slots(resource);
+        slot_entries.assign(n_keys, 0);
+        for (const auto bucket : bucket_order) {
+            if (buckets[bucket].empty())
+                break;
+
+            std::uint32_t seed = 1;
+            for (; seed < MAX_SEED_ATTEMPTS; ++seed) {
+                candidate_slots.clear();
+                for (const auto& [hash, index] : buckets[bucket]) {
+                    const auto slot = _slot_of(hash, seed);
+                    if (occupied[slot] || std::ranges::find(candidate_slots, slot) != candidate_slots.end())
+                        break;
+                    candidate_slots.push_back(slot);
+                }
+
+                if (candidate_slots.size() == buckets[bucket].size())
+                    break;
+            }
+
+            if (seed == MAX_SEED_ATTEMPTS)
+                return false;
+
+            _seeds[bucket] = seed;
+            for (std::size_t i = 0; i < candidate_slots.size(); ++i) {
+                occupied[candidate_slots[i]] = true;
+                slot_entries[candidate_slots[i]] = buckets[bucket][i].second;
+            }
+        }
+        return true;
+    }
+
+public:
+    explicit _frozen_string_map(std::pmr::memory_resource* const resource = std::pmr::get_default_resource()) noexcept:
+        _seeds(resource),
+        _slots(resource),
+        _strings(resource)
+    {}
+
+    /// @param entries A sized range of (key, value) pairs, with unique keys.
+    template<class Range>
+    explicit _frozen_string_map(
+        const Range& entries,
+        std::pmr::memory_resource* const resource = std::pmr::get_default_resource()):
+        _frozen_string_map(resource)
+    {
+        if (std::size(entries) == 0)
+            return;
+
+        std::pmr::vector<std::string_view> keys(resource);
+        std::pmr::vector<Value> values(resource);
+        keys.reserve(std::size(entries));
+        values.reserve(std::size(entries));
+        for (const auto& [key, value] : entries) {
+            keys.emplace_back(key);
+            values.push_back(value);
+        }
+
+        // Note: in practice building only fails if two keys share a full 64-bit hash, changing the salt resolves it.
+        std::pmr::vector<std::uint32_t> slot_entries(resource);
+        for (std::uint64_t salt = 0; !_try_build(keys, _mix64(salt), slot_entries); ++salt) {}
+
+        std::size_t total_length = 0;
+        for (const auto key : keys)
+            total_length += key.size();
+        _strings.reserve(total_length);
+
+        for (std::size_t i = 0; i < _slots.size(); ++i) {
+            auto& slot = _slots[i];
+            const auto index = slot_entries[i];
+            slot.offset = static_cast<std::uint32_t>(_strings.size());
+            slot.length = static_cast<std::uint32_t>(keys[index].size());
+            slot.value = values[index];
+            _strings.append(keys[index]);
+        }
+    }
+
+public:
+    [[nodiscard]] const Value* find(const std::string_view key) const noexcept
+    {
+        if (_slots.empty())
+            return nullptr;
+
+        const auto hash = _hash_bytes(key, _salt);
+        const _slot& slot = _slots[_slot_of(hash, _seeds[_bucket_of(hash)])];
+
+        if (slot.length != key.size() || std::memcmp(_strings.data() + slot.offset, key.data(), key.size()) != 0)
+            return nullptr;
+        return &slot.value;
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return _slots.size();
+    }
+
+private:
+    std::uint64_t _salt = 0;
+    std::pmr::vector<std::uint32_t> _seeds;
+    std::pmr::vector<_slot> _slots;
+    std::pmr::string _strings;
+};
+
+// Perfect hash over a fixed set of N keys, built whilst constant evaluating by the same hash-and-displace scheme as
+// _frozen_string_map. Slots outnumber keys two to one, such that each bucket is placed within a few seeds, sparing the
+// compiler's evaluation limits. The keys themselves are not stored, a lookup instead compares against the one key (Of
+// those given upon construction) which may match.
+template<std::size_t N>
+class _static_perfect_hash
+{
+public:
+    static constexpr std::size_t N_SLOTS = std::max<std::size_t>(1, 2 * N);
+    static constexpr std::size_t N_BUCKETS = std::max<std::size_t>(1, N / 2);
+    // The index marking an empty slot, or a key that was not found.
+    static constexpr std::uint32_t NO_KEY = N;
+
+    consteval explicit _static_perfect_hash(const std::array<std::string_view, N>& keys)
+    {
+        for (std::uint64_t salt = 0; !_try_build(keys, _mix64(salt)); ++salt) {}
+    }
+
+    // Returns the index of key amongst keys (Those given upon construction), or NO_KEY if it is none of them.
+    [[nodiscard]] constexpr std::uint32_t find(
+        const std::string_view key,
+        const std::array<std::string_view, N>& keys) const noexcept
+    {
+        const std::uint64_t hash = _hash_bytes(key, _salt);
+        const std::uint32_t index = _slots[_slot_of(hash, _seeds[hash % N_BUCKETS])];
+        return index != NO_KEY && keys[index] == key ? index : NO_KEY;
+    }
+
+private:
+    static constexpr std::uint32_t MAX_SEED_ATTEMPTS = 1U << 10U;
+
+    [[nodiscard]] static constexpr std::uint32_t _slot_of(const std::uint64_t hash, const std::uint32_t seed) noexcept
+    {
+        return _reduce(_mix64(hash ^ seed), static_cast<std::uint32_t>(N_SLOTS));
+    }
+
+    // Attempts to place every key with the given salt, returns false if two keys could not be separated.
+    [[nodiscard]] consteval bool _try_build(const std::array<std::string_view, N>& keys, const std::uint64_t salt)
+    {
+        _salt = salt;
+        _seeds.fill(0);
+        _slots.fill(NO_KEY);
+
+        std::array<std::uint64_t, N> hashes{};
+        std::array<std::size_t, N_BUCKETS> bucket_sizes{};
+        for (std::size_t i = 0; i < N; ++i) {
+            hashes[i] = _hash_bytes(keys[i], _salt);
+            ++bucket_sizes[hashes[i] % N_BUCKETS];
+        }
+
+        std::array<std::size_t, N_BUCKETS> bucket_order{};
+        for (std::size_t i = 0; i < N_BUCKETS; ++i)
+            bucket_order[i] = i;
+        // Place the largest buckets first, whilst the table is still sparse.
+        std::ranges::sort(bucket_order, [&](const auto lhs, const auto rhs) {
+            return bucket_sizes[lhs] > bucket_sizes[rhs];
+        });
+
+        std::array<std::uint32_t, N> candidate_slots{};
+        for (const std::size_t bucket : bucket_order) {
+            if (bucket_sizes[bucket] == 0)
+                break;
+
+            std::uint32_t seed = 1;
+            for (; seed < MAX_SEED_ATTEMPTS; ++seed) {
+                std::size_t n_placed = 0;
+                for (std::size_t i = 0; i < N && n_placed != bucket_sizes[bucket]; ++i) {
+                    if (hashes[i] % N_BUCKETS != bucket)
+                        continue;
+
+                    const std::uint32_t slot = _slot_of(hashes[i], seed);
+                    const auto placed = std::span(candidate_slots).first(n_placed);
+                    if (_slots[slot] != NO_KEY || std::ranges::find(placed, slot) != placed.end())
+                        break;
+                    candidate_slots[n_placed++] = slot;
+                }
+
+                if (n_placed == bucket_sizes[bucket])
+                    break;
+            }
+
+            if (seed == MAX_SEED_ATTEMPTS)
+                return false;
+
+            _seeds[bucket] = seed;
+            std::size_t n_placed = 0;
+            for (std::uint32_t i = 0; i < N; ++i) {
+                if (hashes[i] % N_BUCKETS == bucket)
+                    _slots[candidate_slots[n_placed++]] = i;
+            }
+        }
+        return true;
+    }
+
+    std::uint64_t _salt = 0;
+    std::array<std::uint32_t, N_BUCKETS> _seeds{};
+    std::array<std::uint32_t, N_SLOTS> _slots{};
+};
+
+} // namespace lwcli
+
+#endif // LWCLI_INCLUDE_LWCLI_PERFECT_HASH_HPP
@@ -0,0 +1,182 @@
+#ifndef LWCLI_INCLUDE_LWCLI_PREFIX_TRIE_HPP
+#define LWCLI_INCLUDE_LWCLI_PREFIX_TRIE_HPP
+
+#include <algorithm>       // For access to std::ranges::sort, std::min
+#include <cstdint>         // For access to uint8_t, uint32_t
+#include <cstring>         // For access to std::memchr, std::memcmp
+#include <memory_resource> // For access to std::pmr::memory_resource, std::pmr::get_default_resource
+#include <string>          // For access to std::pmr::string
+#include <string_view>     // For access to std::string_view
+#include <utility>         // For access to std::pair
+#include <vector>          // For access to std::pmr::vector
+
+namespace lwcli
+{
+
+enum class _prefix_status : std::uint8_t {
+    // No key starts with the prefix.
+    NONE,
+    // Every key starting with the prefix maps to the same value.
+    UNIQUE,
+    // Keys starting with the prefix map to different values.
+    AMBIGUOUS,
+};
+
+template<class Value>
+struct _prefix_match
+{
+    _prefix_status status = _prefix_status::NONE;
+    // Note: default constructed unless status is UNIQUE.
+    Value value{};
+};
+
+// Immutable radix trie, resolving a prefix to the value shared by every key starting with it, if any. Each node stores
+// the outcome of a lookup ending within its edge, so a lookup amounts to one pass over the prefix, with no traversal of
+// the subtree below it: its cost depends on the length of the prefix alone, not on the number of keys.
+//
+// Nodes are stored in a single array, the children of each node contiguously (With the first bytes of their edges in a
+// parallel array, scanned by memchr), and edge labels back to back in a single string table. Every allocation is made
+// from the given memory resource.
+template<class Value>
+class _prefix_trie
+{
+private:
+    struct _node
+    {
+        std::uint32_t label_offset;
+        std::uint32_t label_length;
+        std::uint32_t first_child;
+        std::uint32_t n_children;
+        _prefix_match<Value> match;
+    };
+
+    using _entry = std::pair<std::string_view, Value>;
+
+    // Fills in the node at index, covering entries[first, last) (Which share their first depth characters), then
+    // builds its children.
+    void _build(
+        const std::uint32_t index,
+        const std::pmr::vector<_entry>& entries,
+        const std::size_t first,
+        const std::size_t last,
+        const std::size_t depth)
+    {
+        _prefix_match<Value> match{_prefix_status::UNIQUE, entries[first].second};
+        for (std::size_t i = first + 1; i < last; ++i) {
+            if (entries[i].second != match.value) {
+                match = {_prefix_status::AMBIGUOUS, Value{}};
+                break;
+            }
+        }
+        _nodes[index].match = match;
+
+        // Note: sorted, hence any key ending at depth comes first.
+        std::size_t begin = first;
+        if (entries[begin].first.size() == depth)
+            ++begin;
+
+        std::uint32_t n_children = 0;
+        for (std::size_t i = begin; i < last; ++i)
+            n_children += i == begin || entries[i].first[depth] != entries[i - 1].first[depth] ? 1 : 0;
+
+        // Note: children are reserved up-front, such that they are contiguous.
+        const auto first_child = static_cast<std::uint32_t>(_nodes.size());
+        _nodes[index].first_child = first_child;
+        _nodes[index].n_children = n_children;
+        _nodes.resize(_nodes.size() + n_children);
+        _first_bytes.resize(_nodes.size());
+
+        std::uint32_t child = first_child;
+        for (std::size_t group = begin; group < last; ++child) {
+            const char first_byte = entries[group].first[depth];
+            std::size_t group_end = group + 1;
+            while (group_end < last && entries[group_end].first[depth] == first_byte)
+                ++group_end;
+
+            // Note: sorted, hence the prefix shared by the first and last keys is shared by every key in between.
+            const std::string_view lhs = entries[group].first.substr(depth);
+            const std::string_view rhs = entries[group_end - 1].first.substr(depth);
+            std::size_t length = 1;
+            while (length < std::min(lhs.size(), rhs.size()) && lhs[length] == rhs[length])
+                ++length;
+
+            _nodes[child].label_offset = static_cast<std::uint32_t>(_labels.size());
+            _nodes[child].label_length = static_cast<std::uint32_t>(length);
+            _first_bytes[child] = first_byte;
+            _labels.append(lhs.substr(0, length));
+
+            _build(child, entries, group, group_end, depth + length);
+            group = group_end;
+        }
+    }
+
+public:
+    explicit _prefix_trie(std::pmr::memory_resource* const resource = std::pmr::get_default_resource()) noexcept:
+        _nodes(resource),
+        _first_bytes(resource),
+        _labels(resource)
+    {}
+
+    /// @param entries A sized range of (key, value) pairs, with unique keys.
+    template<class Range>
+    explicit _prefix_trie(
+        const Range& entries,
+        std::pmr::memory_resource* const resource = std::pmr::get_default_resource()):
+        _prefix_trie(resource)
+    {
+        if (std::size(entries) == 0)
+            return;
+
+        std::pmr::vector<_entry> sorted(resource);
+        sorted.reserve(std::size(entries));
+        for (const auto& [key, value] : entries)
+            sorted.emplace_back(key, value);
+        std::ranges::sort(sorted, {}, &_entry::first);
+
+        // Note: the root has an empty label.
+        _nodes.push_back({0, 0, 0, 0, {}});
+        _first_bytes.push_back('\0');
+        _build(0, sorted, 0, sorted.size(), 0);
+    }
+
+    // Resolves prefix to the value shared by every key starting with it (Including a key equal to it).
+    [[nodiscard]] _prefix_match<Value> find(const std::string_view prefix) const noexcept
+    {
+        if (_nodes.empty())
+            return {};
+
+        std::uint32_t index = 0;
+        for (std::size_t position = 0; position < prefix.size();) {
+            const _node& parent = _nodes[index];
+            if (parent.n_children == 0)
+                return {};
+
+            const char* const first_bytes = _first_bytes.data() + parent.first_child;
+            const void* const loc = std::memchr(first_bytes, prefix[position], parent.n_children);
+            if (loc == nullptr)
+                return {};
+
+            index = parent.first_child + static_cast<std::uint32_t>(static_cast<const char*>(loc) - first_bytes);
+            const _node& child = _nodes[index];
+            const std::size_t length = std::min<std::size_t>(child.label_length, prefix.size() - position);
+            if (std::memcmp(_labels.data() + child.label_offset, prefix.data() + position, length) != 0)
+                return {};
+            position += length;
+        }
+        return _nodes[index].match;
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return _nodes.empty();
+    }
+
+private:
+    std::pmr::vector<_node> _nodes;
+    std::pmr::vector<char> _first_bytes;
+    std::pmr::string _labels;
+};
+
+} // namespace lwcli
+
+#endif // LWCLI_INCLUDE_LWCLI_PREFIX_TRIE_HPP
@@ -0,0 +1,155 @@
+#ifndef LWCLI_INCLUDE_LWCLI_SCAN_HPP
+#define LWCLI_INCLUDE_LWCLI_SCAN_HPP
+
+#include <bit>         // For access to std::popcount, std::countr_zero
+#include <cstdint>     // For access to uint32_t
+#include <string_view> // For access to std::string_view
+
+// Note: define LWCLI_DISABLE_SIMD to force the use of the scalar fallbacks.
+#ifndef LWCLI_DISABLE_SIMD
+    #if defined(__AVX2__)
+        #define LWCLI_SCAN_AVX2
+        #include <immintrin.h>
+    #elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define LWCLI_SCAN_SSE2
+        #include <emmintrin.h>
+    #endif
+#endif // LWCLI_DISABLE_SIMD
+
+namespace lwcli
+{
+
+[[nodiscard]] constexpr bool _is_shell_space(const char chr) noexcept
+{
+    return chr == ' ' || chr == '\t' || chr == '\n' || chr == '\r' || chr == '\v' || chr == '\f';
+}
+
+// Whether chr either separates or alters the meaning of shell tokens.
+[[nodiscard]] constexpr bool _is_shell_special(const char chr) noexcept
+{
+    return _is_shell_space(chr) || chr == '\'' || chr == '"' || chr == '\\';
+}
+
+#if defined(LWCLI_SCAN_AVX2)
+inline constexpr std::size_t _SCAN_BLOCK_SIZE = 32;
+
+// Returns a mask with bit i set iff block[i] == chr.
+[[nodiscard]] inline std::uint32_t _match_block(const char* const block, const char chr) noexcept
+{
+    const __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+    const __m256i matches = _mm256_cmpeq_epi8(data, _mm256_set1_epi8(chr));
+    return static_cast<std::uint32_t>(_mm256_movemask_epi8(matches));
+}
+
+// Returns a mask with bit i set iff block[i] is shell whitespace, a quote or a backslash, see _is_shell_special(...).
+[[nodiscard]] inline std::uint32_t _match_shell_special_block(const char* const block) noexcept
+{
+    const __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+    // Note: '\t' through '\r' are contiguous, hence (unsigned) data - '\t' <= '\r' - '\t' matches all of them at once.
+    const __m256i offset = _mm256_sub_epi8(data, _mm256_set1_epi8('\t'));
+    __m256i matches = _mm256_cmpeq_epi8(_mm256_min_epu8(offset, _mm256_set1_epi8('\r' - '\t')), offset);
+    matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(data, _mm256_set1_epi8(' ')));
+    matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(data, _mm256_set1_epi8('\'')));
+    matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(data, _mm256_set1_epi8('"')));
+    matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(data, _mm256_set1_epi8('\\')));
+    return static_cast<std::uint32_t>(_mm256_movemask_epi8(matches));
+}
+#elif defined(LWCLI_SCAN_SSE2)
+inline constexpr std::size_t _SCAN_BLOCK_SIZE = 16;
+
+// Returns a mask with bit i set iff block[i] == chr.
+[[nodiscard]] inline std::uint32_t _match_block(const char* const block, const char chr) noexcept
+{
+    const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+    const __m128i matches = _mm_cmpeq_epi8(data, _mm_set1_epi8(chr));
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(matches));
+}
+
+// Returns a mask with bit i set iff block[i] is shell whitespace, a quote or a backslash, see _is_shell_special(...).
+[[nodiscard]] inline std::uint32_t _match_shell_special_block(const char* const block) noexcept
+{
+    const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+    // Note: '\t' through '\r' are contiguous, hence (unsigned) data - '\t' <= '\r' - '\t' matches all of them at once.
+    const __m128i offset = _mm_sub_epi8(data, _mm_set1_epi8('\t'));
+    __m128i matches = _mm_cmpeq_epi8(_mm_min_epu8(offset, _mm_set1_epi8('\r' - '\t')), offset);
+    matches = _mm_or_si128(matches, _mm_cmpeq_epi8(data, _mm_set1_epi8(' ')));
+    matches = _mm_or_si128(matches, _mm_cmpeq_epi8(data, _mm_set1_epi8('\'')));
+    matches = _mm_or_si128(matches, _mm_cmpeq_epi8(data, _mm_set1_epi8('"')));
+    matches = _mm_or_si128(matches, _mm_cmpeq_epi8(data, _mm_set1_epi8('\\')));
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(matches));
+}
+#else
+inline constexpr std::size_t _SCAN_BLOCK_SIZE = 8;
+
+// Returns a mask with bit i set iff block[i] == chr.
+[[nodiscard]] constexpr std::uint32_t _match_block(const char* const block, const char chr) noexcept
+{
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < _SCAN_BLOCK_SIZE; ++i)
+        mask |= static_cast<std::uint32_t>(block[i] == chr) << i;
+    return mask;
+}
+
+// Returns a mask with bit i set iff block[i] is shell whitespace, a quote or a backslash, see _is_shell_special(...).
+[[nodiscard]] constexpr std::uint32_t _match_shell_special_block(const char* const block) noexcept
+{
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < _SCAN_BLOCK_SIZE; ++i)
+        mask |= static_cast<std::uint32_t>(_is_shell_special(block[i])) << i;
+    return mask;
+}
+#endif
+
+// Counts the occurrences of chr in str, a block at a time.
+[[nodiscard]] inline std::size_t _count_occurrences(const std::string_view str, const char chr) noexcept
+{
+    std::size_t count = 0;
+    std::size_t offset = 0;
+    for (; offset + _SCAN_BLOCK_SIZE <= str.size(); offset += _SCAN_BLOCK_SIZE)
+        count += static_cast<std::size_t>(std::popcount(_match_block(str.data() + offset, chr)));
+
+    for (; offset < str.size(); ++offset)
+        count += static_cast<std::size_t>(str[offset] == chr);
+    return count;
+}
+
+// Invokes callback(index) for every index of str at which chr occurs, in ascending order, stopping early if the
+// callback returns false. Returns whether every invocation of callback returned true.
+template<class Callback>
+bool _for_each_occurrence(const std::string_view str, const char chr, Callback&& callback)
+{
+    std::size_t offset = 0;
+    for (; offset + _SCAN_BLOCK_SIZE <= str.size(); offset += _SCAN_BLOCK_SIZE) {
+        for (auto mask = _match_block(str.data() + offset, chr); mask != 0; mask &= mask - 1) {
+            if (!callback(offset + static_cast<std::size_t>(std::countr_zero(mask))))
+                return false;
+        }
+    }
+
+    for (; offset < str.size(); ++offset) {
+        if (str[offset] == chr && !callback(offset))
+            return false;
+    }
+    return true;
+}
+
+// Returns the index of the first character of str which is shell whitespace, a quote or a backslash (Or str.size() if
+// there is none), a block at a time.
+[[nodiscard]] inline std::size_t _find_shell_special(const std::string_view str) noexcept
+{
+    std::size_t offset = 0;
+    for (; offset + _SCAN_BLOCK_SIZE <= str.size(); offset += _SCAN_BLOCK_SIZE) {
+        if (const auto mask = _match_shell_special_block(str.data() + offset); mask != 0)
+            return offset + static_cast<std::size_t>(std::countr_zero(mask));
+    }
+
+    for (; offset < str.size(); ++offset) {
+        if (_is_shell_special(str[offset]))
+            return offset;
+    }
+    return str.size();
+}
+
+} // namespace lwcli
+
+#endif // LWCLI_INCLUDE_LWCLI_SCAN_HPP
@@ -0,0 +1,223 @@
+#ifndef LWCLI_INCLUDE_LWCLI_SUGGEST_HPP
+#define LWCLI_INCLUDE_LWCLI_SUGGEST_HPP
+
+#include <algorithm>       // For access to std::ranges::sort, std::max
+#include <array>           // For access to std::array
+#include <bit>             // For access to std::popcount
+#include <cassert>         // For access to assert
+#include <cstdint>         // For access to uint8_t, uint32_t, uint64_t
+#include <memory_resource> // For access to std::pmr::memory_resource, std::pmr::get_default_resource
+#include <string>          // For access to std::string, std::pmr::string
+#include <string_view>     // For access to std::string_view
+#include <vector>          // For access to std::vector, std::pmr::vector
+
+namespace lwcli
+{
+
+// Bounded Levenshtein distance from a fixed pattern (Of at most 64 characters) to any text, computed a column at a
+// time using the bit-parallel algorithm of Myers ("A fast bit-vector algorithm for approximate string matching based
+// on dynamic programming"), as adapted to edit distance by Hyyrö. Each character of the text costs a handful of word
+// operations, regardless of the length of the pattern.
+class _edit_distance
+{
+public:
+    static constexpr std::size_t MAX_PATTERN_LENGTH = 64;
+
+    explicit _edit_distance(const std::string_view pattern) noexcept:
+        _length(pattern.size())
+    {
+        assert(!pattern.empty() && pattern.size() <= MAX_PATTERN_LENGTH);
+
+        for (std::size_t i = 0; i < pattern.size(); ++i)
+            _peq[static_cast<unsigned char>(pattern[i])] |= std::uint64_t{1} << i;
+    }
+
+    // Returns the distance from the pattern to text, or any value greater than bound if it exceeds bound.
+    //
+    // Rather than the last row of the matrix, this tracks the cell of each column on the diagonal leading to the last
+    // cell. Every alignment passes through that column, at a cost of at least that cell (As neighbouring cells differ
+    // by at most one), so the computation ends as soon as it exceeds bound (Ukkonen's cut-off), rather than once the
+    // text runs out. Moving to the next column, the cell moves a row down, by a horizontal and a vertical delta.
+    [[nodiscard]] std::size_t operator()(const std::string_view text, const std::size_t bound) const noexcept
+    {
+        // Note: the cell on the diagonal of the first column (Or row) in which it lies is the difference in length.
+        std::size_t diagonal = text.size() > _length ? text.size() - _length : _length - text.size();
+        if (diagonal > bound)
+            return bound + 1;
+
+        std::uint64_t positive_vertical = _length == 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << _length) - 1;
+        std::uint64_t negative_vertical = 0;
+
+        for (std::size_t i = 0; i < text.size(); ++i) {
+            const std::uint64_t equal = _peq[static_cast<unsigned char>(text[i])];
+            const std::uint64_t x_vertical = equal | negative_vertical;
+            const std::uint64_t x_horizontal =
+                (((equal & positive_vertical) + positive_vertical) ^ positive_vertical) | equal;
+
+            // Note: the first row of the matrix increases by one per column, hence the carried in bit.
+            const std::uint64_t positive_horizontal =
+                ((negative_vertical | ~(x_horizontal | positive_vertical)) << 1U) | 1U;
+            const std::uint64_t negative_horizontal = (positive_vertical & x_horizontal) << 1U;
+            positive_vertical = negative_horizontal | ~(x_vertical | positive_horizontal);
+            negative_vertical = positive_horizontal & x_vertical;
+
+            // Note: the diagonal enters the matrix at the first row, if the text is the longer.
+            if (i + _length < text.size())
+                continue;
+
+            const std::size_t row = i + _length - text.size();
+            diagonal += ((positive_horizontal >> row) & 1U) + ((positive_vertical >> row) & 1U);
+            diagonal -= ((negative_horizontal >> row) & 1U) + ((negative_vertical >> row) & 1U);
+            if (diagonal > bound)
+                return bound + 1;
+        }
+        return diagonal;
+    }
+
+private:
+    std::array<std::uint64_t, 256> _peq{};
+    std::size_t _length;
+};
+
+// Index over a set of strings, answering which are nearest to a query (By edit distance). Strings are bucketed by their
+// length, and the buckets visited outwards from the length of the query, whilst the bound on the distance (A third of
+// the length of the query but at least one, tightening as nearer strings are found) permits: the difference in length
+// alone prunes any bucket beyond it. Within a bucket, each string carries a signature of the characters it contains.
+// As an edit changes at most two bits of it, the bits differing from the signature of the query bound the distance
+// from below, and prune most strings before any distance is computed.
+//
+// Strings are stored back to back in a single string table, and every allocation is made from the given memory
+// resource.
+class _suggestion_index
+{
+private:
+    struct _entry
+    {
+        std::uint32_t offset;
+        std::uint32_t length;
+        std::uint64_t signature;
+    };
+
+    // Maps each character to a bit of the signature: letters and digits to their own bit, the rest share the last two.
+    static constexpr std::array<std::uint8_t, 256> SIGNATURE_BITS = [] {
+        std::array<std::uint8_t, 256> bits{};
+        for (std::size_t chr = 0; chr < bits.size(); ++chr) {
+            if (chr >= 'a' && chr <= 'z')
+                bits[chr] = static_cast<std::uint8_t>(chr - 'a');
+            else if (chr >= 'A' && chr <= 'Z')
+                bits[chr] = static_cast<std::uint8_t>(chr - 'A' + 26);
+            else if (chr >= '0' && chr <= '9')
+                bits[chr] = static_cast<std::uint8_t>(chr - '0' + 52);
+            else
+                bits[chr] = chr == '-' ? 62 : 63;
+        }
+        return bits;
+    }();
+
+    [[nodiscard]] static std::uint64_t _signature_of(const std::string_view str) noexcept
+    {
+        std::uint64_t signature = 0;
+        for (const char chr : str)
+            signature |= std::uint64_t{1} << SIGNATURE_BITS[static_cast<unsigned char>(chr)];
+        return signature;
+    }
+
+public:
+    explicit _suggestion_index(std::pmr::memory_resource* const resource = std::pmr::get_default_resource()) noexcept:
+        _entries(resource),
+        _buckets(resource),
+        _strings(resource)
+    {}
+
+    /// @param strings A sized range of unique strings.
+    template<class Range>
+    explicit _suggestion_index(
+        const Range& strings,
+        std::pmr::memory_resource* const resource = std::pmr::get_default_resource()):
+        _suggestion_index(resource)
+    {
+        std::size_t total_length = 0;
+        std::size_t max_length = 0;
+        for (const std::string_view str : strings) {
+            total_length += str.size();
+            max_length = std::max(max_length, str.size());
+        }
+
+        // Note: a counting sort by length, _buckets[length] is the index of the first entry of that length.
+        _buckets.assign(max_length + 2, 0);
+        for (const std::string_view str : strings)
+            ++_buckets[str.size() + 1];
+        for (std::size_t length = 1; length < _buckets.size(); ++length)
+            _buckets[length] += _buckets[length - 1];
+
+        _entries.resize(std::size(strings));
+        _strings.reserve(total_length);
+        std::pmr::vector<std::uint32_t> next(_buckets.begin(), _buckets.end() - 1, resource);
+        for (const std::string_view str : strings) {
+            const auto offset = static_cast<std::uint32_t>(_strings.size());
+            _entries[next[str.size()]++] = {offset, static_cast<std::uint32_t>(str.size()), _signature_of(str)};
+            _strings.append(str);
+        }
+    }
+
+    // Returns the strings nearest to query (In lexicographical order), of those within a third of its length in edits.
+    // Note: a single edit is always allowed, such that short queries (e.g. '-x' for '-y') are suggested for.
+    [[nodiscard]] std::vector<std::string> nearest(const std::string_view query) const
+    {
+        std::vector<std::string> nearest;
+        if (query.empty() || query.size() > _edit_distance::MAX_PATTERN_LENGTH || _entries.empty())
+            return nearest;
+
+        const _edit_distance distance_to(query);
+        const std::uint64_t query_signature = _signature_of(query);
+        std::size_t bound = std::max<std::size_t>(query.size() / 3, 1);
+
+        const auto search_bucket = [&](const std::size_t length) {
+            if (length + 1 >= _buckets.size())
+                return;
+
+            for (std::uint32_t i = _buckets[length]; i < _buckets[length + 1]; ++i) {
+                const _entry& entry = _entries[i];
+                const auto differing = static_cast<std::size_t>(std::popcount(entry.signature ^ query_signature));
+                if ((differing + 1) / 2 > bound)
+                    continue;
+
+                const std::string_view candidate(_strings.data() + entry.offset, entry.length);
+                const std::size_t distance = distance_to(candidate, bound);
+                if (distance > bound)
+                    continue;
+
+                if (distance < bound) {
+                    nearest.clear();
+                    bound = distance;
+                }
+                nearest.emplace_back(candidate);
+            }
+        };
+
+        // Note: nearer lengths first, such that the bound tightens as early as possible.
+        search_bucket(query.size());
+        for (std::size_t difference = 1; difference <= bound; ++difference) {
+            if (difference < query.size())
+                search_bucket(query.size() - difference);
+            search_bucket(query.size() + difference);
+        }
+
+        std::ranges::sort(nearest);
+        return nearest;
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return _entries.size();
+    }
+
+private:
+    std::pmr::vector<_entry> _entries;
+    std::pmr::vector<std::uint32_t> _buckets;
+    std::pmr::string _strings;
+};
+
+} // namespace lwcli
+
+#endif // LWCLI_INCLUDE_LWCLI_SUGGEST_HPP
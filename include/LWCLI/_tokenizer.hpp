@@ -0,0 +1,176 @@
+#ifndef LWCLI_INCLUDE_LWCLI_TOKENIZER_HPP
+#define LWCLI_INCLUDE_LWCLI_TOKENIZER_HPP
+
+#include <cstdint>     // For access to uint8_t
+#include <string>      // For access to std::char_traits
+#include <string_view> // For access to std::string_view
+
+#include "LWCLI/_scan.hpp"
+
+namespace lwcli
+{
+
+enum class _token_status : std::uint8_t {
+    TOKEN,
+    END,
+    UNTERMINATED_QUOTE,
+};
+
+// Characters which a backslash escapes within double quotes, as per POSIX shell.
+[[nodiscard]] constexpr bool _is_double_quote_escapable(const char chr) noexcept
+{
+    return chr == '\\' || chr == '"' || chr == '$' || chr == '`' || chr == '\n';
+}
+
+// Unescapes the token starting at read (Which must not be whitespace), following POSIX shell quoting rules:
+// - '...' preserves its contents literally.
+// - "..." preserves its contents, except for backslashes preceding one of: \ " $ ` or a newline.
+// - Outside of quotes, a backslash preserves the next character literally.
+// - A backslash followed by a newline (Outside single quotes) is removed entirely, as a line continuation.
+//
+// Each run of the unescaped token is passed to put(first, last) as a range of the source, in order. Runs free of
+// quotes and escapes are found a block at a time (See _find_shell_special(...)). Upon returning _token_status::TOKEN,
+// read is advanced past the token.
+template<class Put>
+[[nodiscard]] _token_status _scan_shell_token(const char*& read, const char* const end, Put&& put)
+{
+    while (true) {
+        const std::size_t n_plain = _find_shell_special(std::string_view(read, static_cast<std::size_t>(end - read)));
+        if (n_plain != 0)
+            put(read, read + n_plain);
+        read += n_plain;
+
+        if (read == end || _is_shell_space(*read))
+            return _token_status::TOKEN;
+
+        switch (*read) {
+        case '\'': {
+            const auto n_remaining = static_cast<std::size_t>(end - read - 1);
+            const char* const close = std::char_traits<char>::find(read + 1, n_remaining, '\'');
+            if (close == nullptr)
+                return _token_status::UNTERMINATED_QUOTE;
+            if (close != read + 1)
+                put(read + 1, close);
+            read = close + 1;
+            break;
+        }
+
+        case '"':
+            ++read;
+            while (read != end && *read != '"') {
+                if (*read == '\\' && read + 1 != end && _is_double_quote_escapable(read[1])) {
+                    ++read;
+                    if (*read == '\n') {
+                        ++read;
+                        continue;
+                    }
+                }
+                put(read, read + 1);
+                ++read;
+            }
+            if (read == end)
+                return _token_status::UNTERMINATED_QUOTE;
+            ++read;
+            break;
+
+        default: // i.e. '\\'
+            // Note: a trailing backslash is preserved literally.
+            if (++read == end)
+                put(read - 1, read);
+            else if (*read == '\n')
+                ++read;
+            else {
+                put(read, read + 1);
+                ++read;
+            }
+            break;
+        }
+    }
+}
+
+// Extracts the next whitespace separated token from [cursor, end), see _scan_shell_token(...).
+//
+// Tokens are unescaped in place: the unescaped token is written over the start of its own (escaped) representation,
+// which is never shorter. Characters are only written if they have actually moved, so a token without quotes or escapes
+// never touches the buffer. Upon returning _token_status::TOKEN, token views the result and cursor is advanced past it.
+[[nodiscard]] inline _token_status _next_shell_token(char*& cursor, char* const end, std::string_view& token) noexcept
+{
+    while (cursor != end && _is_shell_space(*cursor))
+        ++cursor;
+
+    if (cursor == end)
+        return _token_status::END;
+
+    char* const begin = cursor;
+    char* write = cursor;
+    const char* read = cursor;
+    const auto status = _scan_shell_token(read, end, [&write](const char* const first, const char* const last) {
+        const auto size = static_cast<std::size_t>(last - first);
+        if (write != first)
+            std::char_traits<char>::move(write, first, size);
+        write += size;
+    });
+    if (status != _token_status::TOKEN)
+        return status;
+
+    token = std::string_view(begin, static_cast<std::size_t>(write - begin));
+    // Note: read only ever advances through [cursor, end), hence refers to the same (mutable) buffer.
+    cursor = begin + (read - begin);
+    return _token_status::TOKEN;
+}
+
+enum class _config_line : std::uint8_t {
+    BLANK,
+    SECTION,
+    KEY,
+    KEY_VALUE,
+    BAD_SECTION,
+};
+
+[[nodiscard]] constexpr std::string_view _trim_shell_space(std::string_view str) noexcept
+{
+    while (!str.empty() && _is_shell_space(str.front()))
+        str.remove_prefix(1);
+    while (!str.empty() && _is_shell_space(str.back()))
+        str.remove_suffix(1);
+    return str;
+}
+
+// Classifies a single line of an INI-style configuration file, without copying any of it:
+// - Empty lines, and those starting with '#' or ';', are _config_line::BLANK.
+// - '[section]' is a _config_line::SECTION, key views its (trimmed) name.
+// - 'key = value' is a _config_line::KEY_VALUE. Both are trimmed, and a value surrounded by matching quotes (Either '
+//   or ") has them removed. Quotes are otherwise preserved literally, with no escaping.
+// - 'key' alone is a _config_line::KEY.
+[[nodiscard]] constexpr _config_line _classify_config_line(
+    std::string_view line,
+    std::string_view& key,
+    std::string_view& value) noexcept
+{
+    line = _trim_shell_space(line);
+    if (line.empty() || line.front() == '#' || line.front() == ';')
+        return _config_line::BLANK;
+
+    if (line.front() == '[') {
+        if (line.back() != ']' || line.size() == 1)
+            return _config_line::BAD_SECTION;
+        key = _trim_shell_space(line.substr(1, line.size() - 2));
+        return _config_line::SECTION;
+    }
+
+    const std::size_t separator = line.find('=');
+    if (separator == std::string_view::npos) {
+        key = line;
+        return _config_line::KEY;
+    }
+
+    key = _trim_shell_space(line.substr(0, separator));
+    value = _trim_shell_space(line.substr(separator + 1));
+    if (value.size() >= 2 && (value.front() == '"' || value.front() == '\'') && value.back() == value.front())
+        value = value.substr(1, value.size() - 2);
+    return _config_line::KEY_VALUE;
+}
+
+} // namespace lwcli
+
+#endif // LWCLI_INCLUDE_LWCLI_TOKENIZER_HPP
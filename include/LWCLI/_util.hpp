@@ -1,31 +1,146 @@
 #ifndef LWCLI_INCLUDE_LWCLI_UTIL_HPP
 #define LWCLI_INCLUDE_LWCLI_UTIL_HPP
 
-#include <algorithm>
-#include <cstring>
-#include <ranges>
+#include <algorithm>       // For access to std::ranges::fill
+#include <bit>             // For access to std::countr_zero
+#include <cassert>         // For access to assert
+#include <cstdint>         // For access to uint64_t
+#include <memory_resource> // For access to std::pmr::memory_resource, std::pmr::get_default_resource
+#include <vector>          // For access to std::vector
 
 namespace lwcli
 {
 
-[[nodiscard]] inline bool streq(const char* const lhs, const char* const rhs)
+// Note: std::hardware_destructive_interference_size is not used, as its value may differ between translation units.
+inline constexpr std::size_t _CACHE_LINE_SIZE = 64;
+
+[[nodiscard]] constexpr std::size_t _align_up(const std::size_t size, const std::size_t alignment) noexcept
 {
-    return std::strcmp(lhs, rhs) == 0;
+    return (size + alignment - 1) / alignment * alignment;
 }
 
-template<
-    std::ranges::forward_range LHSRange,
-    std::ranges::forward_range RHSRange,
-    class Predicate = std::ranges::equal_to>
-requires std::indirect_binary_predicate<Predicate, std::ranges::iterator_t<LHSRange>, std::ranges::iterator_t<RHSRange>>
-[[nodiscard]] constexpr bool contains_any_of(LHSRange&& lhs, RHSRange&& rhs, Predicate&& pred = {})
+// Allocates whole, aligned cache lines (From the given memory resource), such that memory written by one thread never
+// shares a cache line with another allocation (Which may be written by another thread).
+template<class Type>
+class _cache_line_allocator
 {
-    const auto result = std::ranges::find_first_of(
-        std::forward<LHSRange>(lhs),
-        std::forward<RHSRange>(rhs),
-        std::forward<Predicate>(pred));
-    return result != std::ranges::end(lhs);
-}
+public:
+    using value_type = Type;
+
+    _cache_line_allocator() noexcept:
+        _cache_line_allocator(std::pmr::get_default_resource())
+    {}
+
+    // NOLINTNEXTLINE(google-explicit-constructor, hicpp-explicit-conversions)
+    _cache_line_allocator(std::pmr::memory_resource* const resource) noexcept:
+        _resource(resource)
+    {}
+
+    template<class Other>
+    // NOLINTNEXTLINE(google-explicit-constructor, hicpp-explicit-conversions)
+    _cache_line_allocator(const _cache_line_allocator<Other>& other) noexcept:
+        _resource(other.resource())
+    {}
+
+    [[nodiscard]] Type* allocate(const std::size_t n)
+    {
+        return static_cast<Type*>(
+            _resource->allocate(_align_up(n * sizeof(Type), _CACHE_LINE_SIZE), _CACHE_LINE_SIZE));
+    }
+
+    void deallocate(Type* const ptr, const std::size_t n) noexcept
+    {
+        _resource->deallocate(ptr, _align_up(n * sizeof(Type), _CACHE_LINE_SIZE), _CACHE_LINE_SIZE);
+    }
+
+    [[nodiscard]] std::pmr::memory_resource* resource() const noexcept
+    {
+        return _resource;
+    }
+
+    template<class Other>
+    [[nodiscard]] bool operator==(const _cache_line_allocator<Other>& other) const noexcept
+    {
+        return *_resource == *other.resource();
+    }
+
+private:
+    std::pmr::memory_resource* _resource;
+};
+
+// Dynamically sized bitset, only ever allocating upon resize(...). Used to track which (densely indexed) options have
+// been visited during a parse, without any per-parse allocation or hashing. Words occupy whole cache lines, so bitsets
+// written by concurrent parses never falsely share one.
+class _dynamic_bitset
+{
+private:
+    using _word_t = std::uint64_t;
+    static constexpr std::size_t _WORD_BITS = 64;
+
+public:
+    _dynamic_bitset() = default;
+
+    explicit _dynamic_bitset(std::pmr::memory_resource* const resource) noexcept:
+        _words(resource)
+    {}
+
+    // Note: newly added bits are cleared.
+    void resize(const std::size_t n_bits)
+    {
+        _words.resize((n_bits + _WORD_BITS - 1) / _WORD_BITS, 0);
+        _size = n_bits;
+    }
+
+    void set(const std::size_t index) noexcept
+    {
+        assert(index < _size);
+        _words[index / _WORD_BITS] |= _word_t{1} << (index % _WORD_BITS);
+    }
+
+    [[nodiscard]] bool test(const std::size_t index) const noexcept
+    {
+        assert(index < _size);
+        return ((_words[index / _WORD_BITS] >> (index % _WORD_BITS)) & 1U) != 0;
+    }
+
+    void reset() noexcept
+    {
+        std::ranges::fill(_words, _word_t{0});
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return _size;
+    }
+
+    // Invokes callback(index), in ascending order, for every bit set in this bitset but not in other (Of equal size).
+    template<class Callback>
+    void for_each_not_in(const _dynamic_bitset& other, Callback&& callback) const
+    {
+        assert(other._size == _size);
+
+        for (std::size_t word = 0; word < _words.size(); ++word) {
+            for (_word_t mask = _words[word] & ~other._words[word]; mask != 0; mask &= mask - 1)
+                callback(word * _WORD_BITS + static_cast<std::size_t>(std::countr_zero(mask)));
+        }
+    }
+
+    // Returns the index of the first bit set in this bitset but not in other (Of equal size), or size() if none is.
+    [[nodiscard]] std::size_t find_first_not_in(const _dynamic_bitset& other) const noexcept
+    {
+        assert(other._size == _size);
+
+        for (std::size_t word = 0; word < _words.size(); ++word) {
+            if (const _word_t mask = _words[word] & ~other._words[word]; mask != 0)
+                return word * _WORD_BITS + static_cast<std::size_t>(std::countr_zero(mask));
+        }
+        return _size;
+    }
+
+private:
+    std::vector<_word_t, _cache_line_allocator<_word_t>> _words;
+    std::size_t _size = 0;
+};
 
 } // namespace lwcli
 
@@ -0,0 +1,363 @@
+#ifndef LWCLI_INCLUDE_LWCLI_BATCH_HPP
+#define LWCLI_INCLUDE_LWCLI_BATCH_HPP
+
+#include <algorithm>   // For access to std::clamp, std::max, std::min, std::ranges::sort
+#include <atomic>      // For access to std::atomic, std::memory_order
+#include <cassert>     // For access to assert
+#include <cstdint>     // For access to size_t
+#include <cstring>     // For access to std::memcpy
+#include <exception>   // For access to std::exception_ptr, std::current_exception, std::rethrow_exception
+#include <memory>      // For access to std::unique_ptr, std::make_unique, std::make_unique_for_overwrite
+#include <ranges>      // For access to std::ranges::random_access_range, std::ranges::begin
+#include <string_view> // For access to std::string_view
+#include <thread>      // For access to std::thread
+#include <type_traits> // For access to std::remove_reference_t
+#include <utility>     // For access to std::as_const, std::move
+#include <vector>      // For access to std::vector
+
+#include "LWCLI/_util.hpp"
+#include "LWCLI/exceptions.hpp"
+#include "LWCLI/parse_result.hpp"
+#include "LWCLI/parser.hpp"
+#include "LWCLI/shell_tokenizer.hpp"
+
+namespace lwcli
+{
+
+// Append-only storage of strings, whose addresses remain stable as more are stored. Allocates once per chunk, rather
+// than once per string.
+class _string_arena
+{
+private:
+    static constexpr std::size_t _CHUNK_SIZE = 4096;
+
+public:
+    [[nodiscard]] std::string_view store(const std::string_view str)
+    {
+        if (str.empty())
+            return {};
+
+        if (str.size() > _remaining) {
+            const std::size_t size = std::max(_CHUNK_SIZE, str.size());
+            _cursor = _chunks.emplace_back(std::make_unique_for_overwrite<char[]>(size)).get();
+            _remaining = size;
+        }
+
+        std::memcpy(_cursor, str.data(), str.size());
+        const std::string_view stored(_cursor, str.size());
+        _cursor += str.size();
+        _remaining -= str.size();
+        return stored;
+    }
+
+    // Hands over every chunk stored so far, after which this arena is empty.
+    void release_into(std::vector<std::unique_ptr<char[]>>& chunks)
+    {
+        for (auto& chunk : _chunks)
+            chunks.push_back(std::move(chunk));
+
+        _chunks.clear();
+        _cursor = nullptr;
+        _remaining = 0;
+    }
+
+private:
+    std::vector<std::unique_ptr<char[]>> _chunks;
+    char* _cursor = nullptr;
+    std::size_t _remaining = 0;
+};
+
+/// @brief A row of a batch which failed to parse, see BatchParser.
+struct batch_error
+{
+    /// Index of the row within the batch.
+    std::size_t row = 0;
+    /// Describes the failure. Its string views refer to storage owned by the BatchResult holding it, whilst its missing
+    /// options (If any) are owned by the error itself.
+    parse_error error;
+};
+
+/// @brief The outcome of parsing a batch of command-lines, see BatchParser.
+class BatchResult
+{
+public:
+    /// @return The number of rows in the batch.
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return _n_rows;
+    }
+
+    /// @return Whether every row was parsed successfully.
+    [[nodiscard]] bool ok() const noexcept
+    {
+        return _errors.empty();
+    }
+
+    /// @return The rows which failed to parse, in input order.
+    [[nodiscard]] const std::vector<batch_error>& errors() const noexcept
+    {
+        return _errors;
+    }
+
+private:
+    friend class BatchParser;
+
+    std::size_t _n_rows = 0;
+    std::vector<batch_error> _errors;
+    // Note: backs the string views of every error.
+    std::vector<std::unique_ptr<char[]>> _strings;
+};
+
+/// @brief Parses batches of command-lines against a single (frozen) parser, split across a pool of threads.
+///
+/// Each thread parses into its own ParseResult (See CLIParser::parse_into(...)), and splits lines into its own buffers,
+/// all of which are reused from one row (and batch) to the next. Parsing a row therefore allocates nothing once warmed
+/// up, bar the storage of any error. Rows are divided evenly between the threads up-front, each of which steals chunks
+/// of rows from the others once its own are exhausted.
+///
+/// Successfully parsed rows are handed to a visitor, invoked as visitor(row, result) from whichever thread parsed the
+/// row, hence concurrently and in no particular order. The result is only valid for the duration of the call, so
+/// anything needed from it should be copied out (e.g. into slot row of a pre-sized vector, to retain input order).
+///
+/// @warning The parser must outlive this instance, and neither may be modified whilst it exists. A BatchParser may
+/// only parse one batch at a time.
+class BatchParser
+{
+private:
+    static constexpr std::size_t _MAX_CHUNK_SIZE = 256;
+    static constexpr std::size_t _CHUNKS_PER_WORKER = 32;
+
+    struct _no_visitor
+    {
+        void operator()(std::size_t /*row*/, const ParseResult& /*result*/) const noexcept
+        {}
+    };
+
+public:
+    /// @brief Starts the threads of the pool.
+    ///
+    /// @warning This function will raise an assertion if the parser is not frozen.
+    ///
+    /// @param[in] parser The parser against which every row is parsed.
+    /// @param[in] n_threads The number of threads parsing each batch, including the calling thread (Hence one spawns
+    /// no threads at all). Defaults to the number of hardware threads.
+    explicit BatchParser(const CLIParser& parser, const unsigned int n_threads = std::thread::hardware_concurrency()):
+        _parser(parser),
+        _n_workers(std::max(1U, n_threads)),
+        _workers(std::make_unique<_worker[]>(_n_workers))
+    {
+        assert(parser.is_frozen() && "Only frozen parsers may parse batches.");
+
+        _threads.reserve(_n_workers - 1);
+        for (std::size_t i = 1; i < _n_workers; ++i)
+            _threads.emplace_back([this, i] { _serve(i); });
+    }
+
+    BatchParser(const BatchParser&) = delete;
+    BatchParser& operator=(const BatchParser&) = delete;
+    BatchParser(BatchParser&&) = delete;
+    BatchParser& operator=(BatchParser&&) = delete;
+
+    ~BatchParser()
+    {
+        _stopping.store(true, std::memory_order_relaxed);
+        _generation.fetch_add(1, std::memory_order_release);
+        _generation.notify_all();
+
+        for (std::thread& thread : _threads)
+            thread.join();
+    }
+
+    /// @brief Parses every row, each an argument list (i.e. a contiguous range of const char*, such as
+    /// std::vector<const char*>) including the name of the binary.
+    ///
+    /// @throws Any exception thrown by visitor (One of them, should several threads throw), once every thread has
+    /// finished.
+    ///
+    /// @param[in] rows The argument lists to parse.
+    /// @param[in] visitor Invoked as visitor(row, result) for every row parsed successfully.
+    /// @return The errors of every row which failed to parse.
+    template<std::ranges::random_access_range Rows, class Visitor = _no_visitor>
+    [[nodiscard]] BatchResult parse(const Rows& rows, Visitor&& visitor = {})
+    {
+        return _run(std::ranges::size(rows), [&](_worker& worker, const std::size_t row) {
+            const auto& argv = std::ranges::begin(rows)[static_cast<std::ranges::range_difference_t<Rows>>(row)];
+            _parse_row(worker, row, static_cast<int>(std::ranges::size(argv)), std::ranges::data(argv), visitor);
+        });
+    }
+
+    /// @brief Parses every row, each a single command-line (i.e. convertible to std::string_view) split into arguments
+    /// as would a POSIX shell. The first argument of each is taken to be the name of the binary.
+    ///
+    /// Lines which cannot be split are reported as parse_errc::command_line (See bad_command_line).
+    ///
+    /// @throws Any exception thrown by visitor (One of them, should several threads throw), once every thread has
+    /// finished.
+    ///
+    /// @param[in] lines The command-lines to parse.
+    /// @param[in] visitor Invoked as visitor(row, result) for every row parsed successfully.
+    /// @return The errors of every row which failed to parse.
+    template<std::ranges::random_access_range Lines, class Visitor = _no_visitor>
+    [[nodiscard]] BatchResult parse_lines(const Lines& lines, Visitor&& visitor = {})
+    {
+        return _run(std::ranges::size(lines), [&](_worker& worker, const std::size_t row) {
+            const std::string_view line =
+                std::ranges::begin(lines)[static_cast<std::ranges::range_difference_t<Lines>>(row)];
+
+            if (!worker.tokenizer._split(line)) [[unlikely]] {
+                worker.errors.push_back({row, ShellTokenizer::_make_error(worker.strings.store(line))});
+                return;
+            }
+
+            const auto& args = worker.tokenizer._tokens;
+            _parse_row(worker, row, static_cast<int>(args.size()), args.data(), visitor);
+        });
+    }
+
+    /// @return The number of threads parsing each batch, including the calling thread.
+    [[nodiscard]] std::size_t thread_count() const noexcept
+    {
+        return _n_workers;
+    }
+
+private:
+    // State of a single thread. Note: aligned to a cache line, so the (frequently written) cursors of different workers
+    // never share one.
+    struct alignas(_CACHE_LINE_SIZE) _worker
+    {
+        // The next row to be claimed, and the end, of the rows initially assigned to this worker.
+        std::atomic<std::size_t> next{0};
+        std::size_t end = 0;
+
+        ParseResult result;
+        ShellTokenizer tokenizer;
+
+        std::vector<batch_error> errors;
+        _string_arena strings;
+        std::exception_ptr exception;
+    };
+
+    // A type-erased callable, processing a single row on behalf of a worker.
+    struct _job
+    {
+        void* context;
+        void (*process)(void* context, _worker& worker, std::size_t row);
+    };
+
+    template<class Arg, class Visitor>
+    void _parse_row(_worker& worker, const std::size_t row, const int argc, const Arg* argv, Visitor& visitor)
+    {
+        auto error = _parser._parse_into(argc, argv, worker.result);
+        if (error.code == parse_errc{}) [[likely]] {
+            visitor(row, std::as_const(worker.result));
+            return;
+        }
+
+        // Note: errors may refer to memory reused by the next row (e.g. an unescaped argument, or a mapped response
+        // file).
+        error.argument = worker.strings.store(error.argument);
+        error.value = worker.strings.store(error.value);
+        worker.errors.push_back({row, std::move(error)});
+    }
+
+    // Processes rows in chunks, first from those assigned to worker self, then stealing from those of the others.
+    void _work(const std::size_t self) noexcept
+    {
+        _worker& worker = _workers[self];
+        try {
+            for (std::size_t offset = 0; offset < _n_workers; ++offset) {
+                _worker& victim = _workers[(self + offset) % _n_workers];
+
+                for (std::size_t begin = victim.next.fetch_add(_chunk_size, std::memory_order_relaxed);
+                     begin < victim.end;
+                     begin = victim.next.fetch_add(_chunk_size, std::memory_order_relaxed)) {
+                    const std::size_t end = std::min(begin + _chunk_size, victim.end);
+                    for (std::size_t row = begin; row < end; ++row)
+                        _current_job.process(_current_job.context, worker, row);
+                }
+            }
+        }
+        catch (...) {
+            worker.exception = std::current_exception();
+        }
+    }
+
+    // Body of each pooled thread, working on every job posted until stopped.
+    void _serve(const std::size_t self)
+    {
+        std::size_t generation = 0;
+        while (true) {
+            _generation.wait(generation, std::memory_order_acquire);
+            generation = _generation.load(std::memory_order_acquire);
+            if (_stopping.load(std::memory_order_relaxed))
+                return;
+
+            _work(self);
+
+            if (_n_busy.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                _n_busy.notify_one();
+        }
+    }
+
+    // Invokes process(worker, row) for every row in [0, n_rows) across all workers (Including the calling thread), then
+    // gathers their errors in input order.
+    template<class Process>
+    [[nodiscard]] BatchResult _run(const std::size_t n_rows, Process&& process)
+    {
+        _chunk_size = std::clamp<std::size_t>(n_rows / (_n_workers * _CHUNKS_PER_WORKER), 1, _MAX_CHUNK_SIZE);
+        for (std::size_t i = 0; i < _n_workers; ++i) {
+            _worker& worker = _workers[i];
+            worker.next.store(n_rows * i / _n_workers, std::memory_order_relaxed);
+            worker.end = n_rows * (i + 1) / _n_workers;
+            worker.errors.clear();
+            worker.exception = nullptr;
+        }
+
+        _current_job = {&process, [](void* const context, _worker& worker, const std::size_t row) {
+                            (*static_cast<std::remove_reference_t<Process>*>(context))(worker, row);
+                        }};
+
+        // Note: incrementing the generation publishes the job (And the state above) to every thread.
+        _n_busy.store(_n_workers - 1, std::memory_order_relaxed);
+        _generation.fetch_add(1, std::memory_order_release);
+        _generation.notify_all();
+
+        _work(0);
+        for (std::size_t n_busy = 0; (n_busy = _n_busy.load(std::memory_order_acquire)) != 0;)
+            _n_busy.wait(n_busy, std::memory_order_acquire);
+
+        BatchResult result;
+        result._n_rows = n_rows;
+        for (std::size_t i = 0; i < _n_workers; ++i) {
+            _worker& worker = _workers[i];
+            if (worker.exception != nullptr)
+                std::rethrow_exception(worker.exception);
+
+            result._errors.insert(result._errors.end(), worker.errors.begin(), worker.errors.end());
+            worker.strings.release_into(result._strings);
+        }
+        // Note: stolen chunks leave each worker's errors only partially ordered.
+        std::ranges::sort(result._errors, {}, &batch_error::row);
+        return result;
+    }
+
+    const CLIParser& _parser;
+
+    std::size_t _n_workers;
+    std::unique_ptr<_worker[]> _workers;
+    std::vector<std::thread> _threads;
+
+    // Incremented to wake the pooled threads, either to work on a new job or to stop.
+    std::atomic<std::size_t> _generation{0};
+    // The number of pooled threads yet to finish the current job.
+    std::atomic<std::size_t> _n_busy{0};
+    std::atomic<bool> _stopping{false};
+
+    // Written only whilst every pooled thread is idle.
+    _job _current_job{nullptr, nullptr};
+    std::size_t _chunk_size = 1;
+};
+
+} // namespace lwcli
+
+#endif // LWCLI_INCLUDE_LWCLI_BATCH_HPP
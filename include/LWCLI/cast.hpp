@@ -1,76 +1,219 @@
 #ifndef LWCLI_INCLUDE_LWCLI_CAST_STRING_HPP
 #define LWCLI_INCLUDE_LWCLI_CAST_STRING_HPP
 
-#include <concepts> // For access to std::floating_point
-#include <string>   // For access to std::string
-#include <vector>   // For access to std::vector
+#include <charconv>     // For access to std::from_chars
+#include <concepts>     // For access to std::floating_point
+#include <stdexcept>    // For access to std::invalid_argument, std::out_of_range
+#include <string>       // For access to std::string
+#include <string_view>  // For access to std::string_view
+#include <system_error> // For access to std::errc
+#include <type_traits>  // For access to std::is_arithmetic_v
+#include <utility>      // For access to std::move
+#include <vector>       // For access to std::vector
+
+#include "LWCLI/_scan.hpp"
 
 namespace lwcli
 {
+/// @brief Customisation point converting command-line strings to values of type \p Type.
+///
+/// Specialisations must provide:
+///  - `static Type from_string(std::string_view)`, throwing upon failure.
+///
+/// And may optionally provide:
+///  - `static std::errc try_from_string(std::string_view, Type&) noexcept`, returning a non-zero std::errc upon
+///    failure.
+///
+/// When available, LWCLI prefers the latter, as it allows failures to be reported without throwing. Specialisations
+/// declaring the former `static Type from_string(const std::string&)` are still accepted, though each conversion then
+/// copies its argument into a std::string.
 template<class Type>
 struct cast;
 
+template<class Type>
+concept _non_throwing_cast = requires(const std::string_view str, Type& result) {
+    { cast<Type>::try_from_string(str, result) } -> std::same_as<std::errc>;
+};
+
+// Calls cast<Type>::from_string(str), first copying str into a std::string for casts declaring
+// from_string(const std::string&) (To which a std::string_view does not implicitly convert).
+template<class Type>
+[[nodiscard]] Type _from_string(const std::string_view str)
+{
+    if constexpr (requires { cast<Type>::from_string(str); })
+        return cast<Type>::from_string(str);
+    else
+        return cast<Type>::from_string(std::string(str));
+}
+
+[[noreturn]] inline void _throw_cast_error(const std::errc error, const std::string_view str)
+{
+    if (error == std::errc::result_out_of_range)
+        throw std::out_of_range("Value '" + std::string(str) + "' is out of range.");
+    throw std::invalid_argument("Value '" + std::string(str) + "' is not valid.");
+}
+
+// Implements from_string(...) in terms of try_from_string(...), for casts that are naturally non-throwing.
+template<class Type>
+struct _throwing_cast_adaptor
+{
+    [[nodiscard]] static Type from_string(const std::string_view str)
+    {
+        Type result{};
+        if (const auto error = cast<Type>::try_from_string(str, result); error != std::errc{})
+            _throw_cast_error(error, str);
+        return result;
+    }
+};
+
 /* String casts ----------------------------------------------------------------------------------------------------- */
 
 template<>
-struct cast<std::string>
+struct cast<std::string> : _throwing_cast_adaptor<std::string>
 {
-    [[nodiscard]] constexpr static std::string from_string(const std::string& str)
+    [[nodiscard]] static std::errc try_from_string(const std::string_view str, std::string& result)
     {
-        return str;
+        result.assign(str);
+        return {};
     }
 };
 
 /* Numeric casts ---------------------------------------------------------------------------------------------------- */
 
-// TODO(Caetano): Perhaps call each sto[x] function independently
+// Parses the entirety of str into result, rejecting strings which are only partially numeric (e.g. "10abc"). A single
+// leading '+' is accepted, for parity with the std::sto[x] family of functions.
+template<class Arithmetic>
+[[nodiscard]] std::errc _from_chars(std::string_view str, Arithmetic& result) noexcept
+{
+    if (str.size() > 1 && str.front() == '+' && str[1] != '-')
+        str.remove_prefix(1);
+
+    const char* const last = str.data() + str.size();
+    const auto [ptr, error] = std::from_chars(str.data(), last, result);
+    if (error != std::errc{})
+        return error;
+    return ptr == last ? std::errc{} : std::errc::invalid_argument;
+}
+
 template<std::floating_point FPType>
-struct cast<FPType>
+struct cast<FPType> : _throwing_cast_adaptor<FPType>
 {
-    [[nodiscard]] constexpr static FPType from_string(const std::string& str)
+    [[nodiscard]] static std::errc try_from_string(const std::string_view str, FPType& result) noexcept
     {
-        return static_cast<FPType>(std::stold(str));
+        return _from_chars(str, result);
     }
 };
 
-template<std::unsigned_integral UIType>
-struct cast<UIType>
+template<std::integral IType>
+requires(!std::same_as<IType, bool>)
+struct cast<IType> : _throwing_cast_adaptor<IType>
 {
-    [[nodiscard]] constexpr static UIType from_string(const std::string& str)
+    [[nodiscard]] static std::errc try_from_string(const std::string_view str, IType& result) noexcept
     {
-        return static_cast<UIType>(std::stoull(str));
+        return _from_chars(str, result);
     }
 };
 
-template<std::signed_integral SIType>
-struct cast<SIType>
+template<>
+struct cast<bool> : _throwing_cast_adaptor<bool>
 {
-    [[nodiscard]] constexpr static SIType from_string(const std::string& str)
+    [[nodiscard]] static std::errc try_from_string(const std::string_view str, bool& result) noexcept
     {
-        return static_cast<SIType>(std::stoll(str));
+        if (str == "1" || str == "true")
+            result = true;
+        else if (str == "0" || str == "false")
+            result = false;
+        else
+            return std::errc::invalid_argument;
+        return {};
     }
 };
 
 /* Misc casts ------------------------------------------------------------------------------------------------------- */
 
+[[nodiscard]] constexpr bool _is_space(const char chr) noexcept
+{
+    return chr == ' ' || (chr >= '\t' && chr <= '\r');
+}
+
+[[nodiscard]] constexpr std::string_view _trim(std::string_view str) noexcept
+{
+    while (!str.empty() && _is_space(str.front()))
+        str.remove_prefix(1);
+    while (!str.empty() && _is_space(str.back()))
+        str.remove_suffix(1);
+    return str;
+}
+
+/// @brief The delimiter separating the elements of a list-like \p Container (e.g. std::vector), when cast from a
+/// string. Specialise this variable template to change the delimiter used for a given container type.
+template<class Container>
+inline constexpr char list_delimiter_v = ',';
+
 template<class Type, class Alloc>
 struct cast<std::vector<Type, Alloc>>
 {
-    [[nodiscard]] constexpr static std::vector<Type, Alloc> from_string(const std::string& str)
+private:
+    [[nodiscard]] static std::errc _append_element(std::string_view element, std::vector<Type, Alloc>& result)
     {
-        constexpr auto delim = ',';
-
-        std::vector<Type> result;
-        if (!str.empty()) {
-            size_t substr_begin = 0;
-            for (size_t curr = 0; curr < str.size(); ++curr) {
-                if (str[curr] == delim) {
-                    result.push_back(cast<Type>::from_string(str.substr(substr_begin, curr - substr_begin)));
-                    substr_begin = curr + 1;
-                }
+        // Note: numeric elements are trimmed of surrounding whitespace (Which std::from_chars rejects), allowing for
+        // lists such as "10, 20, 30". Others, such as strings, keep their exact contents.
+        if constexpr (std::is_arithmetic_v<Type>)
+            element = _trim(element);
+
+        if constexpr (_non_throwing_cast<Type>) {
+            // Note: parsed into a local, as the elements of std::vector<bool> cannot be bound to a bool&.
+            Type value{};
+            if (const auto error = cast<Type>::try_from_string(element, value); error != std::errc{})
+                return error;
+            result.push_back(std::move(value));
+            return {};
+        }
+        else {
+            try {
+                result.push_back(_from_string<Type>(element));
+                return {};
+            }
+            catch (...) {
+                return std::errc::invalid_argument;
             }
-            result.push_back(cast<Type>::from_string(str.substr(substr_begin)));
         }
+    }
+
+public:
+    // Elements are counted (using SIMD where available) before any is parsed, such that result is only allocated once.
+    // Each element is then parsed in place, from a view into str.
+    [[nodiscard]] static std::errc try_from_string(
+        const std::string_view str,
+        std::vector<Type, Alloc>& result,
+        const char delimiter = list_delimiter_v<std::vector<Type, Alloc>>)
+    {
+        result.clear();
+        if (str.empty())
+            return {};
+
+        result.reserve(_count_occurrences(str, delimiter) + 1);
+
+        std::errc error{};
+        std::size_t element_begin = 0;
+        const bool succeeded = _for_each_occurrence(str, delimiter, [&](const std::size_t element_end) {
+            error = _append_element(str.substr(element_begin, element_end - element_begin), result);
+            element_begin = element_end + 1;
+            return error == std::errc{};
+        });
+
+        if (!succeeded)
+            return error;
+        return _append_element(str.substr(element_begin), result);
+    }
+
+    [[nodiscard]] static std::vector<Type, Alloc> from_string(
+        const std::string_view str,
+        const char delimiter = list_delimiter_v<std::vector<Type, Alloc>>)
+    {
+        std::vector<Type, Alloc> result;
+        if (const auto error = try_from_string(str, result, delimiter); error != std::errc{})
+            _throw_cast_error(error, str);
         return result;
     }
 };
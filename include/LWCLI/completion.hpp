@@ -0,0 +1,309 @@
+#ifndef LWCLI_INCLUDE_LWCLI_COMPLETION_HPP
+#define LWCLI_INCLUDE_LWCLI_COMPLETION_HPP
+
+#include <cstdint>     // For access to uint8_t
+#include <string>      // For access to std::string
+#include <string_view> // For access to std::string_view
+#include <utility>     // For access to std::pair
+#include <vector>      // For access to std::vector
+
+#include "LWCLI/unreachable.hpp"
+
+namespace lwcli
+{
+
+/// @brief The shells for which CLIParser::completion_script(...) generates completion scripts.
+enum class completion_shell : std::uint8_t {
+    /// Sourced from ~/.bashrc, or installed in the completions directory of bash-completion as '<program>'.
+    bash,
+    /// Installed in a directory of $fpath as '_<program>' (Or sourced, once compinit has run).
+    zsh,
+    /// Installed in ~/.config/fish/completions as '<program>.fish'.
+    fish,
+};
+
+// A named option, as completed by a completion script.
+struct _completion_option
+{
+    std::vector<std::string_view> aliases;
+    std::string_view description;
+    // Whether the option is followed by a value, i.e. is a key-value option.
+    bool takes_value = false;
+};
+
+// The completion tables of a parser, identified by the names of the subcommands leading to it (e.g. "/build/release"),
+// or an empty path for the binary itself.
+struct _completion_command
+{
+    std::string path;
+    std::vector<_completion_option> options;
+    // The name and description of each subcommand.
+    std::vector<std::pair<std::string_view, std::string_view>> subcommands;
+};
+
+// Descriptions are listed on a single line.
+[[nodiscard]] inline std::string _single_line(const std::string_view str)
+{
+    std::string line(str);
+    for (char& chr : line) {
+        if (chr == '\n' || chr == '\r' || chr == '\t')
+            chr = ' ';
+    }
+    return line;
+}
+
+// Quotes str for bash and zsh, within which only the single quote itself needs escaping (By closing the quotes).
+[[nodiscard]] inline std::string _posix_quote(const std::string_view str)
+{
+    std::string quoted = "'";
+    for (const char chr : str) {
+        if (chr == '\'')
+            quoted += "'\\''";
+        else
+            quoted += chr;
+    }
+    return quoted + "'";
+}
+
+// Quotes str for fish, within which backslashes and single quotes are escaped by a backslash.
+[[nodiscard]] inline std::string _fish_quote(const std::string_view str)
+{
+    std::string quoted = "'";
+    for (const char chr : str) {
+        if (chr == '\'' || chr == '\\')
+            quoted += '\\';
+        quoted += chr;
+    }
+    return quoted + "'";
+}
+
+// The name given to the shell functions of a script, which may only consist of letters, digits and underscores.
+[[nodiscard]] inline std::string _completion_function_name(const std::string_view program)
+{
+    std::string name = "_lwcli_";
+    for (const char chr : program) {
+        const bool is_word = (chr >= 'a' && chr <= 'z') || (chr >= 'A' && chr <= 'Z') || (chr >= '0' && chr <= '9');
+        name += is_word ? chr : '_';
+    }
+    return name;
+}
+
+// Both the bash and zsh scripts resolve the (Sub)command being completed the same way: starting from the binary, each
+// argument naming a subcommand of the last is appended to the path, until one does not. The tables of that path are
+// then loaded by the <function>_tables function, through the case statement written here.
+template<class WriteTables>
+void _append_tables_function(
+    std::string& script,
+    const std::string& function,
+    const std::vector<_completion_command>& commands,
+    const WriteTables& write_tables)
+{
+    script += function + "_tables()\n{\n    case $1 in\n";
+    for (const _completion_command& command : commands) {
+        script += "    " + _posix_quote(command.path) + ")\n";
+        write_tables(command);
+        script += "        ;;\n";
+    }
+    script += "    esac\n}\n\n";
+}
+
+[[nodiscard]] inline std::string _bash_completion_script(
+    const std::string_view program,
+    const std::vector<_completion_command>& commands)
+{
+    const std::string function = _completion_function_name(program);
+
+    std::string script = "# Bash completion for " + std::string(program) + ", generated by LWCLI.\n\n";
+    _append_tables_function(script, function, commands, [&](const _completion_command& command) {
+        // Note: values and subcommands are padded by spaces, such that words may be searched for as ' <word> '.
+        std::string aliases;
+        std::string values = " ";
+        for (const _completion_option& option : command.options) {
+            for (const std::string_view alias : option.aliases) {
+                aliases.append(aliases.empty() ? "" : " ").append(alias);
+                if (option.takes_value)
+                    values.append(alias).append(" ");
+            }
+        }
+
+        std::string subcommands = " ";
+        for (const auto& [name, description] : command.subcommands)
+            subcommands.append(name).append(" ");
+
+        script += "        aliases=" + _posix_quote(aliases) + "\n";
+        script += "        values=" + _posix_quote(values) + "\n";
+        script += "        subcommands=" + _posix_quote(subcommands) + "\n";
+    });
+
+    script += function + "()\n{\n";
+    script += "    local cur=${COMP_WORDS[COMP_CWORD]} command_path='' first=1 aliases values subcommands\n";
+    script += "    " + function + "_tables ''\n";
+    script += "    while ((first < COMP_CWORD)) && [[ $subcommands == *\" ${COMP_WORDS[first]} \"* ]]; do\n";
+    script += "        command_path+=/${COMP_WORDS[first]}\n";
+    script += "        ((++first))\n";
+    script += "        " + function + "_tables \"$command_path\"\n";
+    script += "    done\n\n";
+    script += "    # Note: values and positional arguments are left to the default completion (i.e. of file names).\n";
+    script += "    COMPREPLY=()\n";
+    script += "    if ((COMP_CWORD > first)) && [[ $values == *\" ${COMP_WORDS[COMP_CWORD - 1]} \"* ]]; then\n";
+    script += "        return\n";
+    script += "    elif [[ $cur == -* ]]; then\n";
+    script += "        mapfile -t COMPREPLY < <(compgen -W \"$aliases\" -- \"$cur\")\n";
+    script += "    elif ((COMP_CWORD == first)); then\n";
+    script += "        mapfile -t COMPREPLY < <(compgen -W \"$subcommands\" -- \"$cur\")\n";
+    script += "    fi\n}\n\n";
+    script += "complete -o default -F " + function + " " + _posix_quote(program) + "\n";
+    return script;
+}
+
+[[nodiscard]] inline std::string _zsh_completion_script(
+    const std::string_view program,
+    const std::vector<_completion_command>& commands)
+{
+    const std::string function = _completion_function_name(program);
+
+    // Note: entries of _describe are of the form 'name:description', in which any colon of the name is escaped.
+    const auto describe_entry = [](const std::string_view name, const std::string_view description) {
+        std::string entry;
+        for (const char chr : name) {
+            if (chr == ':')
+                entry += '\\';
+            entry += chr;
+        }
+        return _posix_quote(entry + ":" + _single_line(description));
+    };
+
+    std::string script = "#compdef " + std::string(program) + "\n\n";
+    script += "# Zsh completion for " + std::string(program) + ", generated by LWCLI.\n\n";
+    _append_tables_function(script, function, commands, [&](const _completion_command& command) {
+        std::string options;
+        std::string values;
+        for (const _completion_option& option : command.options) {
+            for (const std::string_view alias : option.aliases) {
+                options.append(options.empty() ? "" : " ").append(describe_entry(alias, option.description));
+                if (option.takes_value)
+                    values.append(values.empty() ? "" : " ").append(_posix_quote(alias));
+            }
+        }
+
+        std::string subcommands;
+        for (const auto& [name, description] : command.subcommands)
+            subcommands.append(subcommands.empty() ? "" : " ").append(describe_entry(name, description));
+
+        script += "        options=(" + options + ")\n";
+        script += "        values=(" + values + ")\n";
+        script += "        subcommands=(" + subcommands + ")\n";
+    });
+
+    // Note: path is tied to $PATH in zsh, hence command_path.
+    script += function + "()\n{\n";
+    script += "    local -a options values subcommands\n";
+    script += "    local command_path='' first=2\n";
+    script += "    " + function + "_tables ''\n";
+    script += "    while ((first < CURRENT)) && [[ -n ${(M)subcommands:#${(b)words[first]}:*} ]]; do\n";
+    script += "        command_path+=/${words[first]}\n";
+    script += "        ((++first))\n";
+    script += "        " + function + "_tables $command_path\n";
+    script += "    done\n\n";
+    script += "    if ((CURRENT > first)) && ((${values[(Ie)${words[CURRENT - 1]}]})); then\n";
+    script += "        _files\n";
+    script += "    elif [[ $PREFIX == -* ]]; then\n";
+    script += "        _describe -t options option options\n";
+    script += "    elif ((CURRENT == first)) && (($#subcommands)); then\n";
+    script += "        _describe -t subcommands subcommand subcommands\n";
+    script += "    else\n";
+    script += "        _files\n";
+    script += "    fi\n}\n\n";
+    // Note: autoloaded from $fpath, the script is the body of the function named by the file (i.e. _<program>).
+    script += "if [[ $funcstack[1] == _" + std::string(program) + " ]]; then\n";
+    script += "    " + function + " \"$@\"\n";
+    script += "else\n";
+    script += "    compdef " + function + " " + _posix_quote(program) + "\n";
+    script += "fi\n";
+    return script;
+}
+
+[[nodiscard]] inline std::string _fish_completion_script(
+    const std::string_view program,
+    const std::vector<_completion_command>& commands)
+{
+    const std::string function = _completion_function_name(program);
+    const std::string complete = "complete -c " + _fish_quote(program);
+
+    std::string script = "# Fish completion for " + std::string(program) + ", generated by LWCLI.\n\n";
+
+    script += "# Succeeds if the command-line is at the subcommand path $argv[1], and given --first, only if no\n";
+    script += "# argument follows it.\n";
+    script += "function " + function + "_at\n";
+    script += "    set -l tokens (commandline -opc)\n";
+    script += "    set -e tokens[1]\n";
+    script += "    set -l command_path ''\n";
+    script += "    set -l remaining (count $tokens)\n";
+    script += "    for token in $tokens\n";
+    script += "        switch \"$command_path $token\"\n";
+
+    std::string subcommand_paths;
+    for (const _completion_command& command : commands) {
+        for (const auto& [name, description] : command.subcommands)
+            subcommand_paths.append(" ").append(_fish_quote(command.path + " " + std::string(name)));
+    }
+    if (!subcommand_paths.empty()) {
+        script += "            case" + subcommand_paths + "\n";
+        script += "                set command_path \"$command_path/$token\"\n";
+        script += "                set remaining (math $remaining - 1)\n";
+    }
+    script += "            case '*'\n";
+    script += "                break\n";
+    script += "        end\n";
+    script += "    end\n";
+    script += "    test \"$command_path\" = \"$argv[1]\"; or return 1\n";
+    script += "    test \"$argv[2]\" != --first; or test $remaining -eq 0\n";
+    script += "end\n";
+
+    for (const _completion_command& command : commands) {
+        script += "\n";
+        const std::string condition = " -n " + _fish_quote(function + "_at " + _fish_quote(command.path));
+        // Note: fish completes options by their kind (Short, long or old-style), rather than by their aliases.
+        for (const _completion_option& option : command.options) {
+            script += complete + condition;
+            for (const std::string_view alias : option.aliases) {
+                if (alias.starts_with("--"))
+                    script += " -l " + _fish_quote(alias.substr(2));
+                else if (alias.starts_with("-") && alias.size() == 2)
+                    script += " -s " + _fish_quote(alias.substr(1));
+                else if (alias.starts_with("-"))
+                    script += " -o " + _fish_quote(alias.substr(1));
+            }
+            script += option.takes_value ? " -r" : "";
+            script += " -d " + _fish_quote(_single_line(option.description)) + "\n";
+        }
+
+        const std::string first_condition =
+            " -n " + _fish_quote(function + "_at " + _fish_quote(command.path) + " --first");
+        for (const auto& [name, description] : command.subcommands)
+            script += complete + first_condition + " -a " + _fish_quote(name) + " -d "
+                      + _fish_quote(_single_line(description)) + "\n";
+    }
+    return script;
+}
+
+// Generates the completion script of program for shell, from the tables of each of its (Sub)commands.
+[[nodiscard]] inline std::string _completion_script(
+    const completion_shell shell,
+    const std::string_view program,
+    const std::vector<_completion_command>& commands)
+{
+    switch (shell) {
+    case completion_shell::bash:
+        return _bash_completion_script(program, commands);
+    case completion_shell::zsh:
+        return _zsh_completion_script(program, commands);
+    case completion_shell::fish:
+        return _fish_completion_script(program, commands);
+    }
+    _unreachable();
+}
+
+} // namespace lwcli
+
+#endif // LWCLI_INCLUDE_LWCLI_COMPLETION_HPP
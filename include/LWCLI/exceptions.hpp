@@ -1,80 +1,167 @@
 #ifndef LWCLI_INCLUDE_LWCLI_EXCEPTIONS_HPP
 #define LWCLI_INCLUDE_LWCLI_EXCEPTIONS_HPP
 
-#include <cstdint>   // For access to size_t
-#include <ranges>    // For access to std::ranges::input_range
-#include <sstream>   // For access to std::stringstream
-#include <stdexcept> // For access to std::runtime_error
-#include <string>    // For access to std::string
+#include <array>       // For access to std::array
+#include <cstdint>     // For access to size_t, uint8_t
+#include <ranges>      // For access to std::ranges::input_range
+#include <sstream>     // For access to std::stringstream
+#include <stdexcept>   // For access to std::runtime_error
+#include <string>      // For access to std::string
+#include <string_view> // For access to std::string_view
+#include <utility>     // For access to std::move
+#include <vector>      // For access to std::vector
 
 namespace lwcli
 {
+[[nodiscard]] inline std::string _format_parse_error(
+    const std::string_view failed_expression,
+    const std::string& message)
+{
+    return "[FATAL] While parsing '" + std::string(failed_expression) + "': " + message;
+}
+
+[[nodiscard]] inline std::string _suggestions_message(const std::vector<std::string>& suggestions)
+{
+    if (suggestions.empty())
+        return {};
+
+    std::string message = suggestions.size() == 1 ? " Did you mean: " : " Did you mean one of: ";
+    for (std::size_t i = 0; i < suggestions.size(); ++i)
+        message.append(i == 0 ? "" : ", ").append(suggestions[i]);
+    return message + "?";
+}
+
+[[nodiscard]] inline std::string _positional_count_message(
+    const std::size_t n_max_positional,
+    const std::vector<std::string>& suggestions = {})
+{
+    return "Program expects at most " + std::to_string(n_max_positional) + " positional arguments, but at least "
+           + std::to_string(n_max_positional + 1) + " were provided." + _suggestions_message(suggestions);
+}
+
+[[nodiscard]] inline std::string _positional_conversion_message(
+    const std::string_view type_name,
+    const std::vector<std::string>& suggestions = {})
+{
+    return "No suitable conversion found to " + std::string(type_name) + " type." + _suggestions_message(suggestions);
+}
+
+[[nodiscard]] inline std::string _value_conversion_message(
+    const std::string_view value,
+    const std::string_view type_name)
+{
+    return "No suitable conversion found from '" + std::string(value) + "' to " + std::string(type_name) + " type.";
+}
+
+inline constexpr auto _key_value_format_message = "Expected a value, but none were provided";
+
+[[nodiscard]] inline std::string _response_file_message(const std::string_view reason)
+{
+    return "Could not read response file, it " + std::string(reason) + ".";
+}
+
+[[nodiscard]] inline std::string _config_file_message(const std::string_view reason)
+{
+    return "Could not apply configuration file, it " + std::string(reason) + ".";
+}
+
+[[nodiscard]] inline std::string _command_line_message(const std::string_view reason)
+{
+    return "Could not split command-line, it " + std::string(reason) + ".";
+}
+
+template<std::ranges::input_range Range>
+[[nodiscard]] std::string _ambiguous_prefix_message(const Range& candidates)
+{
+    std::string message = "Abbreviates more than one option";
+    std::string_view separator = ", could be any of: ";
+    for (const std::string_view candidate : candidates) {
+        message.append(separator).append(candidate);
+        separator = ", ";
+    }
+    return message + ".";
+}
+
+template<std::ranges::input_range Range>
+[[nodiscard]] std::string _required_options_message(const Range& missing_options)
+{
+    std::stringstream stream;
+    stream << "Arguments:\n";
+    for (const std::string_view arg_list : missing_options)
+        stream << "\t> " << arg_list << "\n";
+    stream << "were expected, but not provided.";
+    return stream.str();
+}
+
 /// @brief Base class from which all LWCLI parsing errors inherit.
 struct bad_parse : public std::runtime_error
 {
 protected:
     explicit bad_parse(const std::string& failed_expression, const std::string& message):
-        std::runtime_error("[FATAL] While parsing '" + failed_expression + "': " + message)
+        std::runtime_error(_format_parse_error(failed_expression, message))
     {}
 
 public:
     std::string failed_expression;
 };
 
-struct _bad_cast : public std::exception
-{
-    explicit _bad_cast(std::string value, std::string type_name):
-        std::exception("[ERROR] Internal error, should always be caught!"),
-        value(std::move(value)),
-        type_name(std::move(type_name))
-    {}
-
-    std::string value;
-    std::string type_name;
-};
-
-/// @brief Exception thrown if: More than the expected number of positional arguments are provided.
+/// @brief Exception thrown if: More than the expected number of positional arguments are provided (This is never the
+/// case if a PositionalSink has been registered).
 ///
 /// > [!NOTE]
 /// > Unrecognised key-value/flag options are parsed as positional arguments, hence, this exception may be thrown in
-/// > the event that their identifiers are misspelled.
+/// > the event that their identifiers are misspelled. The aliases nearest to the first such argument (i.e. the first
+/// > positional argument prefixed by '-', and not a number) are then listed in suggestions.
 struct bad_positional_count : public bad_parse
 {
 public:
-    explicit bad_positional_count(const std::string& failed_expression, size_t n_max_positional):
-        bad_parse(
-            failed_expression,
-            "Program expects at most " + std::to_string(n_max_positional) + " positional arguments, but at least "
-                + std::to_string(n_max_positional + 1) + " were provided."),
+    explicit bad_positional_count(
+        const std::string& failed_expression,
+        size_t n_max_positional,
+        std::vector<std::string> suggestions = {}):
+        bad_parse(failed_expression, _positional_count_message(n_max_positional, suggestions)),
+        suggestions(std::move(suggestions)),
         n_max_positional(n_max_positional)
     {}
 
+    /// The aliases nearest to the misspelled option (If any), in lexicographical order.
+    std::vector<std::string> suggestions;
+
 private:
     size_t n_max_positional;
 };
 
 /// @brief Exception thrown upon failure to convert from string to the expected type of a positional argument.
+///
+/// > [!NOTE]
+/// > As with bad_positional_count, this may be due to a misspelled option, in which case the aliases nearest to it are
+/// > listed in suggestions.
 struct bad_positional_conversion : public bad_parse
 {
-    explicit bad_positional_conversion(const _bad_cast& error_data):
-        bad_parse(error_data.value, "No suitable conversion found to " + error_data.type_name + " type."),
-        value(error_data.value),
-        type(error_data.type_name)
+    explicit bad_positional_conversion(
+        const std::string& value,
+        const std::string& type,
+        std::vector<std::string> suggestions = {}):
+        bad_parse(value, _positional_conversion_message(type, suggestions)),
+        value(value),
+        type(type),
+        suggestions(std::move(suggestions))
     {}
 
     std::string value;
     std::string type;
+    /// The aliases nearest to value (If it resembles an option), in lexicographical order.
+    std::vector<std::string> suggestions;
 };
 
 /// @brief Exception thrown upon failure to convert from string to the expected type of a key-value option.
 struct bad_value_conversion : public bad_parse
 {
-    explicit bad_value_conversion(const std::string& key, const _bad_cast& error_data):
-        bad_parse(
-            key,
-            "No suitable conversion found from '" + error_data.value + "' to " + error_data.type_name + " type."),
-        value(error_data.value),
-        type(error_data.type_name)
+    // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+    explicit bad_value_conversion(const std::string& key, const std::string& value, const std::string& type):
+        bad_parse(key, _value_conversion_message(value, type)),
+        value(value),
+        type(type)
     {}
 
     std::string value;
@@ -86,31 +173,152 @@ struct bad_value_conversion : public bad_parse
 struct bad_key_value_format : public bad_parse
 {
     explicit bad_key_value_format(const std::string& key):
-        bad_parse(key, "Expected a value, but none were provided")
+        bad_parse(key, _key_value_format_message)
     {}
 };
 
 /// @brief Exception thrown if not **all** *required* arguments have been provided.
 struct bad_required_options : public bad_parse
 {
-private:
-    template<std::ranges::input_range Range>
-    static std::string _build_error_message(const Range& missing_options)
-    {
-        std::stringstream stream;
-        stream << "Arguments:\n";
-        for (const std::string& arg_list : missing_options)
-            stream << "\t> " << arg_list << "\n";
-        stream << "were expected, but not provided.";
-        return stream.str();
-    }
-
-public:
     template<std::ranges::input_range Range>
     requires std::is_convertible_v<std::ranges::range_value_t<Range>, std::string>
     explicit bad_required_options(const Range& missing_options):
-        bad_parse("", _build_error_message(missing_options))
+        bad_parse("", _required_options_message(missing_options))
+    {}
+};
+
+/// @brief Exception thrown if a response file (An argument of the form '\@path') could not be expanded, see
+/// CLIParser::expand_response_files(...).
+struct bad_response_file : public bad_parse
+{
+    explicit bad_response_file(const std::string& argument, const std::string& reason):
+        bad_parse(argument, _response_file_message(reason)),
+        reason(reason)
+    {}
+
+    std::string reason;
+};
+
+/// @brief Exception thrown if a configuration file could not be applied, see CLIParser::config_file(...).
+///
+/// > [!NOTE]
+/// > Values within a configuration file that fail conversion raise bad_value_conversion (Or bad_key_value_format, for
+/// > key-value options lacking a value) instead, as they would on the command-line.
+struct bad_config_file : public bad_parse
+{
+    explicit bad_config_file(const std::string& argument, const std::string& reason):
+        bad_parse(argument, _config_file_message(reason)),
+        reason(reason)
+    {}
+
+    std::string reason;
+};
+
+/// @brief Exception thrown if a command-line given as a single string could not be split into arguments.
+struct bad_command_line : public bad_parse
+{
+    explicit bad_command_line(const std::string& command_line, const std::string& reason):
+        bad_parse(command_line, _command_line_message(reason)),
+        reason(reason)
     {}
+
+    std::string reason;
+};
+
+/// @brief Exception thrown if an argument abbreviates the long aliases of more than one option, see
+/// CLIParser::match_prefixes(...).
+struct bad_ambiguous_prefix : public bad_parse
+{
+    explicit bad_ambiguous_prefix(const std::string& prefix, std::vector<std::string> candidates):
+        bad_parse(prefix, _ambiguous_prefix_message(candidates)),
+        candidates(std::move(candidates))
+    {}
+
+    /// The aliases starting with the prefix, in lexicographical order.
+    std::vector<std::string> candidates;
+};
+
+/// @brief Identifies the kind of failure described by a parse_error, each corresponds to one of the exceptions thrown
+/// by CLIParser::parse(...).
+enum class parse_errc : std::uint8_t {
+    /// See bad_positional_count.
+    positional_count = 1,
+    /// See bad_positional_conversion.
+    positional_conversion,
+    /// See bad_value_conversion.
+    value_conversion,
+    /// See bad_key_value_format.
+    key_value_format,
+    /// See bad_required_options.
+    required_options,
+    /// See bad_response_file.
+    response_file,
+    /// See bad_config_file.
+    config_file,
+    /// See bad_command_line.
+    command_line,
+    /// See bad_ambiguous_prefix.
+    ambiguous_prefix,
+};
+
+/// @brief Compact description of a parsing failure, as returned by CLIParser::try_parse(...).
+///
+/// No message text is built until format() is called. Only errors for missing required options allocate, as they list
+/// every such option. Note that the suggestions for misspelled options (See bad_positional_count) and the candidates of
+/// ambiguous prefixes are found by searching the registered options, so are only listed by the exceptions thrown by
+/// CLIParser::parse(...).
+///
+/// > [!NOTE]
+/// > The string views held by this object refer to the parsed arguments, or to the aliases of the registered options,
+/// > and are only valid for as long as those are.
+struct parse_error
+{
+    parse_errc code{};
+    /// Index of the offending argument in argv, or argc if the error concerns the command-line as a whole. Errors
+    /// raised whilst expanding a response file refer to the index of the '\@path' argument naming it, whilst those
+    /// raised by a configuration file (Or environment variable) refer to argc.
+    int index = 0;
+    /// The offending argument. For key-value errors this is the key, and for missing required options it is (an alias
+    /// of) the first missing option.
+    std::string_view argument;
+    /// The value for which conversion failed, if any. For parse_errc::positional_count, the first positional argument
+    /// resembling an option (i.e. prefixed by '-', and not a number), if any.
+    std::string_view value;
+    /// Implementation defined name of the type conversion was attempted to, if any.
+    const char* type_name = nullptr;
+    /// The maximum number of positional arguments accepted by the parser, if relevant.
+    std::size_t n_max_positional = 0;
+    /// Static description of why a response (Or configuration) file or command-line could not be read, if relevant.
+    const char* reason = nullptr;
+    /// For parse_errc::required_options, the aliases (Joined by " | ") of every missing option, in registration order.
+    std::vector<std::string> missing_options;
+
+    /// @brief Builds the message that CLIParser::parse(...) would have reported for this error.
+    [[nodiscard]] std::string format() const
+    {
+        switch (code) {
+        case parse_errc::positional_count:
+            return _format_parse_error(argument, _positional_count_message(n_max_positional));
+        case parse_errc::positional_conversion:
+            return _format_parse_error(argument, _positional_conversion_message(type_name));
+        case parse_errc::value_conversion:
+            return _format_parse_error(argument, _value_conversion_message(value, type_name));
+        case parse_errc::key_value_format:
+            return _format_parse_error(argument, _key_value_format_message);
+        case parse_errc::required_options:
+            return _format_parse_error("", _required_options_message(missing_options));
+        case parse_errc::response_file:
+            return _format_parse_error(argument, _response_file_message(reason));
+        case parse_errc::config_file:
+            return _format_parse_error(argument, _config_file_message(reason));
+        case parse_errc::command_line:
+            return _format_parse_error(argument, _command_line_message(reason));
+        case parse_errc::ambiguous_prefix:
+            // Note: the candidates are only known to the parser, so are omitted.
+            return _format_parse_error(argument, _ambiguous_prefix_message(std::array<std::string_view, 0>{}));
+        }
+        return {};
+    }
 };
 } // namespace lwcli
 
@@ -0,0 +1,381 @@
+#ifndef LWCLI_INCLUDE_LWCLI_INSTRUMENTATION_HPP
+#define LWCLI_INCLUDE_LWCLI_INSTRUMENTATION_HPP
+
+#include <chrono>  // For access to std::chrono::steady_clock
+#include <cstdint> // For access to size_t
+#include <vector>  // For access to std::vector
+
+// Note: define LWCLI_INSTRUMENTATION (Before including any LWCLI header, in every translation unit) to record the
+// statistics of each parse. Otherwise, nothing is recorded, and the instrumentation compiles away entirely.
+//
+// Allocations are only counted if, additionally, LWCLI_INSTRUMENTATION_COUNT_ALLOCATIONS is defined in exactly one
+// translation unit, which then replaces the global allocation functions. It may also be defined alone, counting the
+// allocations of each thread (In _thread_allocations) without recording any parse, as do the allocation tests and the
+// parse benchmarks.
+#ifdef LWCLI_INSTRUMENTATION_COUNT_ALLOCATIONS
+    #include <cstdlib> // For access to std::malloc, std::aligned_alloc, std::free
+    #include <new>     // For access to std::bad_alloc, std::align_val_t
+#endif
+
+namespace lwcli
+{
+
+/// @brief Statistics of a single parse, handed to the sink given to CLIParser::instrument(...).
+///
+/// Only recorded if LWCLI_INSTRUMENTATION is defined. Timings are measured by std::chrono::steady_clock, reading which
+/// costs about as much as a single lookup, so fine-grained timings overestimate (And slow down) the parse.
+struct parse_stats
+{
+    using duration = std::chrono::steady_clock::duration;
+
+    /// Time spent by the parse as a whole, including building any error.
+    duration total_time{};
+
+    /// Time spent looking up arguments amongst the aliases of the named options, and the number of lookups.
+    duration lookup_time{};
+    std::size_t n_lookups = 0;
+
+    /// Time spent converting values (i.e. within cast<>), and the number of conversions, across every option.
+    duration conversion_time{};
+    std::size_t n_conversions = 0;
+    /// Time spent converting the values of each key-value option, indexed in registration order (Of key-value options
+    /// alone).
+    std::vector<duration> key_value_conversion_times;
+    /// Time spent converting the values of each positional option, indexed by position. Values given to a positional
+    /// sink are only included in conversion_time.
+    std::vector<duration> positional_conversion_times;
+
+    /// The number of times each flag option was given (By any source), indexed in registration order (Of flag options
+    /// alone).
+    std::vector<std::size_t> flag_hits;
+    /// The number of times each key-value option was given (By any source), indexed in registration order (Of
+    /// key-value options alone).
+    std::vector<std::size_t> key_value_hits;
+
+    /// Time spent building the exception thrown by a failed parse, if any. Note that the parse_error returned by the
+    /// try_ functions is built lazily, see parse_error::format().
+    duration error_time{};
+
+    /// The number of heap allocations, and the bytes requested by them, made by the parsing thread. Only counted if
+    /// LWCLI_INSTRUMENTATION_COUNT_ALLOCATIONS is defined (In one translation unit), otherwise zero.
+    std::size_t n_allocations = 0;
+    std::size_t allocated_bytes = 0;
+};
+
+/// @brief The destination of the statistics of each parse, see CLIParser::instrument(...).
+struct parse_stats_sink
+{
+    void (*record)(void* context, const parse_stats& stats);
+    void* context;
+};
+
+#if defined(LWCLI_INSTRUMENTATION) || defined(LWCLI_INSTRUMENTATION_COUNT_ALLOCATIONS)
+
+struct _allocation_count
+{
+    std::size_t n_allocations = 0;
+    std::size_t n_bytes = 0;
+};
+
+// Incremented by the replacement allocation functions (If any), see LWCLI_INSTRUMENTATION_COUNT_ALLOCATIONS.
+inline thread_local _allocation_count _thread_allocations;
+
+#endif // LWCLI_INSTRUMENTATION || LWCLI_INSTRUMENTATION_COUNT_ALLOCATIONS
+
+#ifdef LWCLI_INSTRUMENTATION
+
+// Records the statistics of the parses using the _parse_scratch holding it.
+class _parse_recorder
+{
+private:
+    using _clock = std::chrono::steady_clock;
+    using _duration = parse_stats::duration;
+
+public:
+    // Adds the time elapsed between its construction and destruction to total (and detail, if any).
+    class stopwatch
+    {
+    public:
+        explicit stopwatch(_duration& total, _duration* const detail = nullptr) noexcept:
+            _total(total),
+            _detail(detail),
+            _start(_clock::now())
+        {}
+
+        stopwatch(const stopwatch&) = delete;
+        stopwatch& operator=(const stopwatch&) = delete;
+
+        ~stopwatch()
+        {
+            const auto elapsed = _clock::now() - _start;
+            _total += elapsed;
+            if (_detail != nullptr)
+                *_detail += elapsed;
+        }
+
+    private:
+        _duration& _total;
+        _duration* _detail;
+        _clock::time_point _start;
+    };
+
+    // Hands the statistics to sink upon destruction, see _parse_recorder::report(...).
+    class reporter
+    {
+    public:
+        reporter(_parse_recorder& recorder, const parse_stats_sink& sink) noexcept:
+            _recorder(recorder),
+            _sink(sink)
+        {}
+
+        reporter(const reporter&) = delete;
+        reporter& operator=(const reporter&) = delete;
+
+        ~reporter()
+        {
+            _recorder.report(_sink);
+        }
+
+    private:
+        _parse_recorder& _recorder;
+        const parse_stats_sink& _sink;
+    };
+
+    void resize(const std::size_t n_flags, const std::size_t n_key_values, const std::size_t n_positionals)
+    {
+        _stats.flag_hits.resize(n_flags);
+        _stats.key_value_hits.resize(n_key_values);
+        _stats.key_value_conversion_times.resize(n_key_values);
+        _stats.positional_conversion_times.resize(n_positionals);
+    }
+
+    // Starts recording a new parse, discarding the statistics of the last.
+    void begin() noexcept
+    {
+        auto& stats = _stats;
+        stats.total_time = stats.lookup_time = stats.conversion_time = stats.error_time = _duration::zero();
+        stats.n_lookups = stats.n_conversions = 0;
+        for (auto& time : stats.key_value_conversion_times)
+            time = _duration::zero();
+        for (auto& time : stats.positional_conversion_times)
+            time = _duration::zero();
+        for (auto& hits : stats.flag_hits)
+            hits = 0;
+        for (auto& hits : stats.key_value_hits)
+            hits = 0;
+
+        _start_allocations = _thread_allocations;
+        _start = _clock::now();
+    }
+
+    [[nodiscard]] stopwatch time_lookup() noexcept
+    {
+        ++_stats.n_lookups;
+        return stopwatch(_stats.lookup_time);
+    }
+
+    [[nodiscard]] stopwatch time_flag_conversion() noexcept
+    {
+        ++_stats.n_conversions;
+        return stopwatch(_stats.conversion_time);
+    }
+
+    [[nodiscard]] stopwatch time_key_value_conversion(const std::size_t index) noexcept
+    {
+        ++_stats.n_conversions;
+        return stopwatch(_stats.conversion_time, &_stats.key_value_conversion_times[index]);
+    }
+
+    [[nodiscard]] stopwatch time_positional_conversion(const std::size_t position) noexcept
+    {
+        ++_stats.n_conversions;
+        auto& times = _stats.positional_conversion_times;
+        return stopwatch(_stats.conversion_time, position < times.size() ? &times[position] : nullptr);
+    }
+
+    [[nodiscard]] stopwatch time_error() noexcept
+    {
+        return stopwatch(_stats.error_time);
+    }
+
+    void hit_flag(const std::size_t index) noexcept
+    {
+        ++_stats.flag_hits[index];
+    }
+
+    void hit_key_value(const std::size_t index) noexcept
+    {
+        ++_stats.key_value_hits[index];
+    }
+
+    // Completes the statistics of the parse started by begin(), then hands them to sink (If any).
+    void report(const parse_stats_sink& sink) noexcept
+    {
+        _stats.total_time = _clock::now() - _start;
+        _stats.n_allocations = _thread_allocations.n_allocations - _start_allocations.n_allocations;
+        _stats.allocated_bytes = _thread_allocations.n_bytes - _start_allocations.n_bytes;
+
+        if (sink.record != nullptr)
+            sink.record(sink.context, _stats);
+    }
+
+    [[nodiscard]] const parse_stats& stats() const noexcept
+    {
+        return _stats;
+    }
+
+private:
+    parse_stats _stats;
+    _clock::time_point _start;
+    _allocation_count _start_allocations;
+};
+
+#else
+
+// Records nothing, such that every use compiles away.
+class _parse_recorder
+{
+public:
+    struct stopwatch
+    {};
+
+    struct reporter
+    {
+        reporter(_parse_recorder& /*recorder*/, const parse_stats_sink& /*sink*/) noexcept
+        {}
+    };
+
+    void resize(std::size_t /*n_flags*/, std::size_t /*n_key_values*/, std::size_t /*n_positionals*/) noexcept
+    {}
+
+    void begin() noexcept
+    {}
+
+    [[nodiscard]] stopwatch time_lookup() noexcept
+    {
+        return {};
+    }
+
+    [[nodiscard]] stopwatch time_flag_conversion() noexcept
+    {
+        return {};
+    }
+
+    [[nodiscard]] stopwatch time_key_value_conversion(std::size_t /*index*/) noexcept
+    {
+        return {};
+    }
+
+    [[nodiscard]] stopwatch time_positional_conversion(std::size_t /*position*/) noexcept
+    {
+        return {};
+    }
+
+    [[nodiscard]] stopwatch time_error() noexcept
+    {
+        return {};
+    }
+
+    void hit_flag(std::size_t /*index*/) noexcept
+    {}
+
+    void hit_key_value(std::size_t /*index*/) noexcept
+    {}
+};
+
+#endif // LWCLI_INSTRUMENTATION
+
+} // namespace lwcli
+
+#ifdef LWCLI_INSTRUMENTATION_COUNT_ALLOCATIONS
+
+// NOLINTBEGIN(cppcoreguidelines-no-malloc, hicpp-no-malloc)
+void* operator new(const std::size_t size)
+{
+    ++lwcli::_thread_allocations.n_allocations;
+    lwcli::_thread_allocations.n_bytes += size;
+
+    if (void* const ptr = std::malloc(size == 0 ? 1 : size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new(const std::size_t size, const std::align_val_t alignment)
+{
+    ++lwcli::_thread_allocations.n_allocations;
+    lwcli::_thread_allocations.n_bytes += size;
+
+    // Note: std::aligned_alloc requires the size to be a (non-zero) multiple of the alignment.
+    const auto align = static_cast<std::size_t>(alignment);
+    const std::size_t rounded_size = size == 0 ? align : (size + align - 1) / align * align;
+    #ifdef _WIN32
+    if (void* const ptr = _aligned_malloc(rounded_size, align))
+    #else
+    if (void* const ptr = std::aligned_alloc(align, rounded_size))
+    #endif
+        return ptr;
+    throw std::bad_alloc();
+}
+
+// Note: the array forms are replaced too, rather than relying on the standard library forwarding them to the above.
+void* operator new[](const std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void* operator new[](const std::size_t size, const std::align_val_t alignment)
+{
+    return ::operator new(size, alignment);
+}
+
+void operator delete(void* const ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* const ptr, std::size_t /*size*/) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* const ptr, std::align_val_t /*alignment*/) noexcept
+{
+    #ifdef _WIN32
+    _aligned_free(ptr);
+    #else
+    std::free(ptr);
+    #endif
+}
+
+void operator delete(void* const ptr, std::size_t /*size*/, std::align_val_t /*alignment*/) noexcept
+{
+    #ifdef _WIN32
+    _aligned_free(ptr);
+    #else
+    std::free(ptr);
+    #endif
+}
+void operator delete[](void* const ptr) noexcept
+{
+    ::operator delete(ptr);
+}
+
+void operator delete[](void* const ptr, const std::size_t size) noexcept
+{
+    ::operator delete(ptr, size);
+}
+
+void operator delete[](void* const ptr, const std::align_val_t alignment) noexcept
+{
+    ::operator delete(ptr, alignment);
+}
+
+void operator delete[](void* const ptr, const std::size_t size, const std::align_val_t alignment) noexcept
+{
+    ::operator delete(ptr, size, alignment);
+}
+// NOLINTEND(cppcoreguidelines-no-malloc, hicpp-no-malloc)
+
+#endif // LWCLI_INSTRUMENTATION_COUNT_ALLOCATIONS
+
+#endif // LWCLI_INCLUDE_LWCLI_INSTRUMENTATION_HPP
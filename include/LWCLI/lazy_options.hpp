@@ -0,0 +1,169 @@
+#ifndef LWCLI_INCLUDE_LWCLI_LAZY_OPTIONS_HPP
+#define LWCLI_INCLUDE_LWCLI_LAZY_OPTIONS_HPP
+
+#include <optional>    // For access to std::optional
+#include <string>      // For access to std::string
+#include <string_view> // For access to std::string_view
+#include <typeinfo>    // For access to typeid
+#include <utility>     // For access to std::move
+#include <vector>      // For access to std::vector
+
+#include "LWCLI/_options_stores.hpp"
+#include "LWCLI/exceptions.hpp"
+#include "LWCLI/type_utility.hpp"
+
+namespace lwcli
+{
+
+template<class Type>
+struct _lazy_callbacks;
+
+/// @brief The value of a lazy option, which is converted from its argument upon first access rather than by the parse.
+///
+/// Parsing merely records a view of the argument, such that options which are never read are never converted. The
+/// first call to value() converts it (Throwing, should it fail, as parsing would have), and the result is cached for
+/// subsequent calls. Should eager conversion be required after all, see CLIParser::validate_all(...).
+///
+/// @warning The argument is viewed rather than copied: argv must outlive the first access to the value, as must the
+/// command-line given to CLIParser::parse(std::string_view), whose arguments view it (Bar those unescaped by the
+/// parser, which are valid until the next parse). Arguments read from response or configuration files are valid until
+/// the next parse, and those read from the environment until it is modified. Each parse (Into the same option or
+/// ParseResult) discards any argument recorded by the last.
+///
+/// @note value() caches its result, hence concurrent first accesses to the same value must be synchronised.
+///
+/// @tparam Type The expected type of the value.
+template<class Type>
+class LazyValue
+{
+public:
+    using value_t = Type;
+
+    /// @brief Sets the value held whilst no argument is given, value-initialised otherwise.
+    void set_default(value_t default_value)
+    {
+        _default = std::move(default_value);
+    }
+
+    /// @brief Converts the argument given by the last parse upon the first call, or returns the default if none was.
+    ///
+    /// @throws bad_value_conversion (Or bad_positional_conversion, for positional options) if the argument could not be
+    /// converted. Later calls attempt the conversion again.
+    ///
+    /// @return The value of the option.
+    [[nodiscard]] const value_t& value() const
+    {
+        if (!_given)
+            return _default;
+
+        if (!_try_convert()) [[unlikely]]
+            _throw_conversion_error();
+        return *_converted;
+    }
+
+    /// @return Whether an argument was given by the last parse.
+    [[nodiscard]] bool given() const noexcept
+    {
+        return _given;
+    }
+
+    /// @return The argument given by the last parse, yet to be (or already) converted.
+    [[nodiscard]] std::string_view argument() const noexcept
+    {
+        return _argument;
+    }
+
+private:
+    template<class>
+    friend struct _lazy_callbacks;
+
+    // Converts the argument, unless already converted, returning false if it could not be.
+    [[nodiscard]] bool _try_convert() const
+    {
+        if (_converted.has_value())
+            return true;
+
+        value_t converted{};
+        if (!_on_invoke_valued_option<value_t>(_argument, &converted))
+            return false;
+        _converted = std::move(converted);
+        return true;
+    }
+
+    [[noreturn]] void _throw_conversion_error() const
+    {
+        const char* const type_name = typeid(unwrapped_t<value_t>).name();
+        // Note: only key-value options are named by a key.
+        if (_key.empty())
+            throw bad_positional_conversion(std::string(_argument), type_name);
+        throw bad_value_conversion(std::string(_key), std::string(_argument), type_name);
+    }
+
+    value_t _default{};
+    mutable std::optional<value_t> _converted;
+    std::string_view _key;
+    std::string_view _argument;
+    bool _given = false;
+};
+
+/// @brief A key-value option whose value is converted upon first access, see LazyValue.
+///
+/// As with KeyValueOption, the option is required unless \p Type is a std::optional.
+template<class Type>
+struct LazyKeyValueOption : public LazyValue<Type>
+{
+    std::vector<std::string> aliases;
+    std::string description;
+    /// Name of the environment variable (if any) from which the value is read, when not given on the command-line.
+    std::string env;
+};
+
+/// @brief A positional option whose value is converted upon first access, see LazyValue.
+template<class Type>
+struct LazyPositionalOption : public LazyValue<Type>
+{
+    std::string name;
+    std::string description;
+    /// Name of the environment variable (if any) from which the value is read, when not given on the command-line.
+    std::string env;
+};
+
+// The type erased operations of LazyValue<Type>, see _lazy_operations.
+template<class Type>
+struct _lazy_callbacks
+{
+    static void record(void* const lazy_ptr, const std::string_view key, const std::string_view value) noexcept
+    {
+        auto& lazy = *static_cast<LazyValue<Type>*>(lazy_ptr);
+        lazy._key = key;
+        lazy._argument = value;
+        lazy._given = true;
+        lazy._converted.reset();
+    }
+
+    [[nodiscard]] static bool convert(void* const lazy_ptr)
+    {
+        return static_cast<const LazyValue<Type>*>(lazy_ptr)->_try_convert();
+    }
+
+    static void discard(void* const lazy_ptr) noexcept
+    {
+        auto& lazy = *static_cast<LazyValue<Type>*>(lazy_ptr);
+        lazy._key = {};
+        lazy._argument = {};
+        lazy._given = false;
+        lazy._converted.reset();
+    }
+
+    static constexpr _lazy_operations OPERATIONS{record, convert, discard};
+};
+
+template<class Type>
+[[nodiscard]] _erased_valued_option _erase_lazy_option(LazyValue<Type>& lazy) noexcept
+{
+    return {&lazy, nullptr, typeid(unwrapped_t<Type>).name(), nullptr, &_lazy_callbacks<Type>::OPERATIONS};
+}
+
+} // namespace lwcli
+
+#endif // LWCLI_INCLUDE_LWCLI_LAZY_OPTIONS_HPP
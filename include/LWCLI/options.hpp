@@ -1,8 +1,11 @@
 #ifndef LWCLI_INCLUDE_LWCLI_OPTIONS_HPP
 #define LWCLI_INCLUDE_LWCLI_OPTIONS_HPP
 
-#include <string> // For access to std::string
-#include <vector> // For access to std::vector
+#include <cstdint>     // For access to size_t
+#include <string>      // For access to std::string
+#include <type_traits> // For access to std::decay_t
+#include <utility>     // For access to std::forward
+#include <vector>      // For access to std::vector
 
 namespace lwcli
 {
@@ -14,6 +17,9 @@ struct FlagOption
     std::vector<std::string> aliases;
     std::string description;
     count_t count = 0;
+    /// Name of the environment variable (if any) from which the flag is read, when not given on the command-line. Its
+    /// value must be one of 1, 0, true or false.
+    std::string env;
 };
 
 template<class Type>
@@ -24,6 +30,36 @@ struct KeyValueOption
     std::vector<std::string> aliases;
     std::string description;
     value_t value{};
+    /// Name of the environment variable (if any) from which the value is read, when not given on the command-line.
+    std::string env;
+};
+
+/// @brief A key-value option which may be given any number of times, appending each of its values to a container
+/// (e.g. '--input a --input b'), rather than overwriting the last.
+///
+/// The values given by a parse replace those held beforehand, such that the container may be given defaults. All of
+/// them, from every source (argv, response files, the environment and the configuration file), are counted before any
+/// is converted, so the container is reserved exactly once per parse (If it has a reserve member), and each value is
+/// converted directly into it from the argument.
+///
+/// > [!NOTE]
+/// > As conversion is deferred until every source has been read, a value which cannot be converted is reported after
+/// > any other error of the parse (e.g. a bad value of another option given later), bar missing required options.
+///
+/// @tparam Type The expected type of each value.
+/// @tparam Container The container of the values, which must provide clear() and push_back(...).
+template<class Type, class Container = std::vector<Type>>
+struct AppendKeyValueOption
+{
+    using value_t = Type;
+    using container_t = Container;
+
+    std::vector<std::string> aliases;
+    std::string description;
+    container_t values{};
+    /// Name of the environment variable (if any) from which a single value is read, when not given on the
+    /// command-line.
+    std::string env;
 };
 
 template<class Type>
@@ -34,8 +70,41 @@ struct PositionalOption
     std::string name;
     std::string description;
     value_t value{};
+    /// Name of the environment variable (if any) from which the value is read, when not given on the command-line.
+    std::string env;
+};
+
+/// @brief Receives every positional argument left over once all PositionalOption's have been filled, however many there
+/// are.
+///
+/// Each argument is converted to \p Type, then handed to the consumer, without being stored, such that memory use is
+/// independent of the number of arguments. The consumer may either be:
+///  - A callable accepting a \p Type rvalue, which is invoked once per argument.
+///  - An output iterator accepting \p Type, which is assigned to (and incremented) once per argument.
+///
+/// See make_positional_sink(...) for a means of deducing \p Consumer.
+template<class Type, class Consumer>
+struct PositionalSink
+{
+    using value_t = Type;
+    using consumer_t = Consumer;
+
+    std::string name;
+    std::string description;
+    consumer_t consumer;
+    std::size_t count = 0;
 };
 
+/// @brief Creates a PositionalSink of \p Type, deducing the type of its consumer.
+///
+/// @tparam Type The expected type of each positional argument.
+/// @param[in] consumer The callable or output iterator receiving each argument.
+template<class Type, class Consumer>
+[[nodiscard]] PositionalSink<Type, std::decay_t<Consumer>> make_positional_sink(Consumer&& consumer)
+{
+    return {{}, {}, std::forward<Consumer>(consumer)};
+}
+
 } // namespace lwcli
 
 #endif // LWCLI_INCLUDE_LWCLI_OPTIONS_HPP
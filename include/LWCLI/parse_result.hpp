@@ -0,0 +1,430 @@
+#ifndef LWCLI_INCLUDE_LWCLI_PARSE_RESULT_HPP
+#define LWCLI_INCLUDE_LWCLI_PARSE_RESULT_HPP
+
+#include <algorithm>       // For access to std::ranges::upper_bound, std::max, std::fill_n
+#include <cassert>         // For access to assert
+#include <cstddef>         // For access to std::byte
+#include <cstdint>         // For access to size_t
+#include <functional>      // For access to std::greater
+#include <memory>          // For access to std::shared_ptr, std::uninitialized_value_construct_n
+#include <memory_resource> // For access to std::pmr::memory_resource, std::pmr::get_default_resource
+#include <new>             // For access to std::align_val_t, std::launder
+#include <string>          // For access to std::pmr::string
+#include <string_view>     // For access to std::string_view
+#include <utility>         // For access to std::exchange, std::move
+#include <vector>          // For access to std::pmr::vector
+
+#include "LWCLI/_mapped_file.hpp"
+#include "LWCLI/_util.hpp"
+#include "LWCLI/instrumentation.hpp"
+#include "LWCLI/options.hpp"
+
+namespace lwcli
+{
+
+// State written throughout a single parse. Owned by whatever the parse writes its values to (i.e. either a CLIParser or
+// a ParseResult), such that concurrent parses never share any. Every allocation, including those only made whilst
+// parsing (e.g. of the paths of response files), is made from the memory resource given upon construction.
+struct _parse_scratch
+{
+    explicit _parse_scratch(std::pmr::memory_resource* const resource = std::pmr::get_default_resource()) noexcept:
+        visited_flags(resource),
+        visited_key_values(resource),
+        visited_positionals(resource),
+        shadowed_flags(resource),
+        shadowed_key_values(resource),
+        mapped_files(resource),
+        config_key(resource),
+        appended_values(resource),
+        append_counts(resource)
+    {}
+
+    void resize(const std::size_t n_flags, const std::size_t n_key_values, const std::size_t n_positionals)
+    {
+        visited_flags.resize(n_flags);
+        visited_key_values.resize(n_key_values);
+        visited_positionals.resize(n_positionals);
+        shadowed_flags.resize(n_flags);
+        shadowed_key_values.resize(n_key_values);
+        append_counts.resize(n_key_values);
+        recorder.resize(n_flags, n_key_values, n_positionals);
+    }
+
+    void reset() noexcept
+    {
+        recorder.begin();
+        mapped_files.clear();
+        // Note: the counts are left non-zero only by a parse failing before its values were appended.
+        for (const _appended_value& appended : appended_values)
+            append_counts[appended.key_value_index] = 0;
+        appended_values.clear();
+        visited_flags.reset();
+        visited_key_values.reset();
+        visited_positionals.reset();
+    }
+
+    [[nodiscard]] std::pmr::memory_resource* resource() const noexcept
+    {
+        return config_key.get_allocator().resource();
+    }
+
+    // Indexed by _named_id::index() of each option (Of the corresponding type), or by position.
+    _dynamic_bitset visited_flags;
+    _dynamic_bitset visited_key_values;
+    _dynamic_bitset visited_positionals;
+
+    // The options visited before the configuration file was parsed.
+    _dynamic_bitset shadowed_flags;
+    _dynamic_bitset shadowed_key_values;
+
+    // Response and configuration files mapped by the last parse.
+    std::pmr::vector<_mapped_file> mapped_files;
+    // Holds 'section.key' whilst looking up configuration file keys.
+    std::pmr::string config_key;
+
+    // A value of an append option, deferred until every value of the parse has been counted.
+    struct _appended_value
+    {
+        std::uint32_t key_value_index;
+        // The argument (Its index, and the key naming the option) from which the value originates.
+        int index;
+        std::string_view key;
+        std::string_view value;
+    };
+
+    // The values of append options in the order given, viewing the arguments (or mapped files) they originate from.
+    std::pmr::vector<_appended_value> appended_values;
+    // Indexed by _named_id::index() of each append option, the number of its values amongst appended_values.
+    std::pmr::vector<std::uint32_t> append_counts;
+
+    // Note: records nothing unless LWCLI_INSTRUMENTATION is defined.
+    [[no_unique_address]] _parse_recorder recorder;
+};
+
+// Describes a value (Of some erased type) held within the buffer of a ParseResult.
+struct _result_slot
+{
+    std::size_t size;
+    std::size_t alignment;
+    void (*construct)(void*);
+    void (*destroy)(void*) noexcept;
+    // Note: only assigned once the layout is finalised.
+    std::size_t offset = 0;
+};
+
+template<class Type>
+[[nodiscard]] _result_slot _make_result_slot() noexcept
+{
+    return {
+        sizeof(Type),
+        alignof(Type),
+        [](void* const ptr) { ::new (ptr) Type{}; },
+        [](void* const ptr) noexcept { static_cast<Type*>(ptr)->~Type(); },
+    };
+}
+
+// The layout of the buffer of a ParseResult: the count of every flag option, followed by the value of every key-value
+// and positional option. Values are ordered by decreasing alignment, so none is preceded by padding (Bar the first).
+//
+// Note: only the layout itself is allocated from the given memory resource, buffers are always allocated from the heap
+// (As they may be allocated concurrently).
+class _result_layout
+{
+private:
+    using _count_t = FlagOption::count_t;
+
+public:
+    explicit _result_layout(std::pmr::memory_resource* const resource = std::pmr::get_default_resource()) noexcept:
+        _key_values(resource),
+        _positionals(resource)
+    {}
+
+    void add_flag() noexcept
+    {
+        ++_n_flags;
+    }
+
+    template<class Type>
+    void add_key_value()
+    {
+        _key_values.push_back(_make_result_slot<Type>());
+    }
+
+    template<class Type>
+    void add_positional()
+    {
+        _positionals.push_back(_make_result_slot<Type>());
+    }
+
+    // Assigns the offset of every value, no value may be added afterwards.
+    void finalise()
+    {
+        // Note: ordered by insertion, rather than by std::ranges::stable_sort (Whose temporary buffer is allocated from
+        // the heap). Slots of equal alignment keep their relative order.
+        std::pmr::vector<_result_slot*> slots(_key_values.get_allocator());
+        slots.reserve(_key_values.size() + _positionals.size());
+        const auto insert = [&slots](_result_slot& slot) {
+            const auto by_alignment = &_result_slot::alignment;
+            slots.insert(std::ranges::upper_bound(slots, slot.alignment, std::greater<>{}, by_alignment), &slot);
+        };
+        for (_result_slot& slot : _key_values)
+            insert(slot);
+        for (_result_slot& slot : _positionals)
+            insert(slot);
+        _alignment = _CACHE_LINE_SIZE;
+        std::size_t offset = _n_flags * sizeof(_count_t);
+        for (_result_slot* const slot : slots) {
+            offset = _align_up(offset, slot->alignment);
+            slot->offset = offset;
+            offset += slot->size;
+            _alignment = std::max(_alignment, slot->alignment);
+        }
+        // Note: padded to whole cache lines, so no two buffers share one.
+        _size = _align_up(offset, _alignment);
+    }
+
+    // Allocates a buffer, in which every count and value is constructed.
+    [[nodiscard]] std::byte* allocate() const
+    {
+        if (_size == 0)
+            return nullptr;
+
+        auto* const buffer = static_cast<std::byte*>(::operator new(_size, std::align_val_t{_alignment}));
+        std::size_t n_constructed = 0;
+        try {
+            std::uninitialized_value_construct_n(reinterpret_cast<_count_t*>(buffer), _n_flags);
+            for (; n_constructed < _key_values.size() + _positionals.size(); ++n_constructed) {
+                const _result_slot& slot = _slot(n_constructed);
+                slot.construct(buffer + slot.offset);
+            }
+        }
+        catch (...) {
+            _destroy(buffer, n_constructed);
+            throw;
+        }
+        return buffer;
+    }
+
+    void deallocate(std::byte* const buffer) const noexcept
+    {
+        if (buffer == nullptr)
+            return;
+
+        _destroy(buffer, _key_values.size() + _positionals.size());
+    }
+
+    void reset_counts(std::byte* const buffer) const noexcept
+    {
+        if (_n_flags != 0)
+            std::fill_n(counts(buffer), _n_flags, _count_t{0});
+    }
+
+    [[nodiscard]] static _count_t* counts(std::byte* const buffer) noexcept
+    {
+        return std::launder(reinterpret_cast<_count_t*>(buffer));
+    }
+
+    [[nodiscard]] static const _count_t* counts(const std::byte* const buffer) noexcept
+    {
+        return std::launder(reinterpret_cast<const _count_t*>(buffer));
+    }
+
+    [[nodiscard]] std::size_t key_value_offset(const std::size_t index) const noexcept
+    {
+        return _key_values[index].offset;
+    }
+
+    [[nodiscard]] std::size_t positional_offset(const std::size_t position) const noexcept
+    {
+        return _positionals[position].offset;
+    }
+
+    [[nodiscard]] std::size_t flag_count() const noexcept
+    {
+        return _n_flags;
+    }
+
+    [[nodiscard]] std::size_t key_value_count() const noexcept
+    {
+        return _key_values.size();
+    }
+
+    [[nodiscard]] std::size_t positional_count() const noexcept
+    {
+        return _positionals.size();
+    }
+
+private:
+    [[nodiscard]] const _result_slot& _slot(const std::size_t index) const noexcept
+    {
+        return index < _key_values.size() ? _key_values[index] : _positionals[index - _key_values.size()];
+    }
+
+    void _destroy(std::byte* const buffer, const std::size_t n_constructed) const noexcept
+    {
+        for (std::size_t i = 0; i < n_constructed; ++i)
+            _slot(i).destroy(buffer + _slot(i).offset);
+        ::operator delete(buffer, std::align_val_t{_alignment});
+    }
+
+    std::size_t _n_flags = 0;
+    std::pmr::vector<_result_slot> _key_values;
+    std::pmr::vector<_result_slot> _positionals;
+
+    std::size_t _size = 0;
+    std::size_t _alignment = _CACHE_LINE_SIZE;
+};
+
+/// @brief Refers to the count of a flag option within a ParseResult, see CLIParser::handle_of(...).
+class FlagHandle
+{
+private:
+    friend class CLIParser;
+    friend class ParseResult;
+
+    explicit FlagHandle(const std::size_t index) noexcept:
+        _index(index)
+    {}
+
+    std::size_t _index;
+};
+
+/// @brief Refers to the value of a key-value or positional option within a ParseResult, see CLIParser::handle_of(...).
+///
+/// @tparam Type The value type of the option.
+template<class Type>
+class ValueHandle
+{
+private:
+    friend class CLIParser;
+    friend class ParseResult;
+
+    ValueHandle(
+        const std::size_t offset,
+        const std::size_t index,
+        const bool positional,
+        const Type* const default_value) noexcept:
+        _offset(offset),
+        _index(index),
+        _positional(positional),
+        _default_value(default_value)
+    {}
+
+    std::size_t _offset;
+    std::size_t _index;
+    bool _positional;
+    const Type* _default_value;
+};
+
+/// @brief Holds the values parsed by CLIParser::parse_into(...), in place of the registered options themselves.
+///
+/// Flag counts and option values are laid out contiguously within a single allocation, aligned to (and padded to a
+/// multiple of) the size of a cache line, as is the result itself. Results used by different threads therefore never
+/// share a cache line. A result allocates upon its first parse, and is reused without allocating by subsequent parses
+/// (Against the same parser).
+///
+/// Values are retrieved by the handles returned from CLIParser::handle_of(...), valid only for results of the parser
+/// which returned them. Options not provided by the last parse read as the value of the registered option itself, as do
+/// all options of a result never parsed into (Or moved from), whose flags read as never given.
+class alignas(_CACHE_LINE_SIZE) ParseResult
+{
+public:
+    ParseResult() = default;
+
+    ParseResult(const ParseResult&) = delete;
+    ParseResult& operator=(const ParseResult&) = delete;
+
+    ParseResult(ParseResult&& other) noexcept:
+        _layout(std::move(other._layout)),
+        _buffer(std::exchange(other._buffer, nullptr)),
+        _scratch(std::move(other._scratch)),
+        _help_requested(std::exchange(other._help_requested, false))
+    {}
+
+    ParseResult& operator=(ParseResult&& other) noexcept
+    {
+        if (this != &other) {
+            _release();
+            _layout = std::move(other._layout);
+            _buffer = std::exchange(other._buffer, nullptr);
+            _scratch = std::move(other._scratch);
+            _help_requested = std::exchange(other._help_requested, false);
+        }
+        return *this;
+    }
+
+    ~ParseResult()
+    {
+        _release();
+    }
+
+    /// @return The number of times the flag option was given during the last parse.
+    [[nodiscard]] FlagOption::count_t operator[](const FlagHandle handle) const noexcept
+    {
+        // Note: a result never parsed into (Or moved from) holds no buffer.
+        if (_layout == nullptr)
+            return 0;
+        assert(handle._index < _layout->flag_count());
+
+        return _result_layout::counts(_buffer)[handle._index];
+    }
+
+    /// @return The value of the option parsed by the last parse, or the value of the registered option if none was.
+    template<class Type>
+    [[nodiscard]] const Type& operator[](const ValueHandle<Type>& handle) const noexcept
+    {
+        if (!contains(handle))
+            return *handle._default_value;
+        return *std::launder(reinterpret_cast<const Type*>(_buffer + handle._offset));
+    }
+
+    /// @return Whether the option was provided (By any source) during the last parse.
+    template<class Type>
+    [[nodiscard]] bool contains(const ValueHandle<Type>& handle) const noexcept
+    {
+        if (_layout == nullptr)
+            return false;
+        return handle._positional ? _scratch.visited_positionals.test(handle._index)
+                                  : _scratch.visited_key_values.test(handle._index);
+    }
+
+    /// @return Whether the last parse requested help, in which case no other value was necessarily parsed.
+    [[nodiscard]] bool help_requested() const noexcept
+    {
+        return _help_requested;
+    }
+
+private:
+    friend class CLIParser;
+
+    // Readies this result to be parsed into with the given layout, allocating only if it differs from the last.
+    void _prepare(const std::shared_ptr<_result_layout>& layout)
+    {
+        if (_layout == layout) {
+            layout->reset_counts(_buffer);
+            return;
+        }
+
+        _release();
+        _buffer = layout->allocate();
+        _layout = layout;
+        _scratch.resize(layout->flag_count(), layout->key_value_count(), layout->positional_count());
+    }
+
+    void _release() noexcept
+    {
+        if (_layout != nullptr)
+            _layout->deallocate(std::exchange(_buffer, nullptr));
+        _layout = nullptr;
+    }
+
+    // Note: shared with the parser, such that the buffer can be destroyed regardless of which outlives the other.
+    std::shared_ptr<const _result_layout> _layout;
+    std::byte* _buffer = nullptr;
+    _parse_scratch _scratch;
+    bool _help_requested = false;
+};
+
+} // namespace lwcli
+
+#endif // LWCLI_INCLUDE_LWCLI_PARSE_RESULT_HPP
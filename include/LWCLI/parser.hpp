@@ -1,33 +1,106 @@
 #ifndef LWCLI_INCLUDE_LWCLI_PARSER_HPP
 #define LWCLI_INCLUDE_LWCLI_PARSER_HPP
 
-#include <array>
-#include <cassert>       // For access to assert
-#include <cstdint>       // For access to size_t
-#include <iostream>      // For access to std::cout
-#include <sstream>       // For access to std::stringstream
-#include <string>        // For access to std::string
-#include <unordered_set> // For access to std::unordered_set
-#include <vector>        // For access to std::vector
+#include <algorithm>       // For access to std::min, std::ranges::sort
+#include <array>           // For access to std::array
+#include <cassert>         // For access to assert
+#include <cstdint>         // For access to size_t
+#include <functional>      // For access to std::function
+#include <memory>          // For access to std::unique_ptr, std::shared_ptr, std::allocate_shared
+#include <memory_resource> // For access to std::pmr::memory_resource, std::pmr::polymorphic_allocator
+#include <string>          // For access to std::string, std::pmr::string
+#include <string_view>     // For access to std::string_view
+#include <system_error>    // For access to std::errc
+#include <type_traits>     // For access to std::is_same_v
+#include <typeinfo>        // For access to typeid
+#include <unordered_map>   // For access to std::pmr::unordered_map
+#include <utility>         // For access to std::exchange, std::move
+#include <vector>          // For access to std::vector, std::pmr::vector
+#include <version>         // For access to __cpp_lib_expected
 
+#ifdef __cpp_lib_expected
+    #include <expected> // For access to std::expected
+#endif
+
+#include "LWCLI/_environment.hpp"
+#include "LWCLI/_mapped_file.hpp"
 #include "LWCLI/_options_stores.hpp"
+#include "LWCLI/_output.hpp"
+#include "LWCLI/_scan.hpp"
+#include "LWCLI/_tokenizer.hpp"
 #include "LWCLI/_util.hpp"
+#include "LWCLI/completion.hpp"
 #include "LWCLI/exceptions.hpp"
+#include "LWCLI/instrumentation.hpp"
+#include "LWCLI/lazy_options.hpp"
 #include "LWCLI/options.hpp"
+#include "LWCLI/parse_result.hpp"
+#include "LWCLI/shell_tokenizer.hpp"
 #include "LWCLI/unreachable.hpp"
 
 namespace lwcli
 {
 
+/// @brief Destination of the help message, which is handed over in its entirety by a single call to write.
+struct help_sink
+{
+    void (*write)(void* context, std::string_view text);
+    void* context;
+};
+
+// Appends the entry of an option (Or subcommand) to a help message, its description wrapped every 80 characters. Note:
+// also used whilst constant evaluating, see StaticParser::help_message().
+// NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+template<class String>
+constexpr void _append_option_description(
+    String& message,
+    const std::string_view header,
+    const std::string_view description)
+{
+    constexpr std::size_t COL_WIDTH = 80;
+
+    message.append(header).append(":\n");
+    for (std::size_t offset = 0; offset < description.length(); offset += COL_WIDTH)
+        message.append("  ").append(description.substr(offset, COL_WIDTH)).append("\n");
+    message += '\n';
+}
+
 /// @brief Handles the parsing and help-text generation of a command-line interface.
 ///
 /// @warning When registering an option, CLIParser assumes all registered options remain valid until the last invocation
 /// of CLIParser::parse(...). If the memory representing an option is freed, at any point before the last invocation of
 /// CLIParser::parse(...), the correct behaviour of the function can no longer be guaranteed (And can potentially lead
-/// to undefined behaviour).
+/// to undefined behaviour). The same applies to CLIParser::parse_into(...), and to reading any ParseResult (Whose
+/// defaults are read from the options themselves).
 class CLIParser
 {
+    friend class BatchParser;
+
 public:
+    /// @brief Constructs a parser, allocating all of its storage from the default memory resource.
+    CLIParser():
+        CLIParser(std::pmr::get_default_resource())
+    {}
+
+    /// @brief Constructs a parser, allocating all of its storage from resource.
+    ///
+    /// This includes: the alias lookup, the registered options, the help message, the parsers of subcommands, and the
+    /// storage written by CLIParser::parse(...) (Bar exceptions, which may outlive the parser). Hence, given a
+    /// std::pmr::monotonic_buffer_resource, the parser may be released in one shot, and given one backed by a
+    /// fixed buffer (Whose upstream is std::pmr::null_memory_resource()), never touches the heap.
+    ///
+    /// @note CLIParser::parse_into(...) allocates from the resource of its result instead (The default resource), as
+    /// it may be invoked concurrently.
+    ///
+    /// @warning resource must outlive this instance, and every ParseResult parsed into by it.
+    ///
+    /// @param[in] resource The memory resource to allocate from.
+    explicit CLIParser(std::pmr::memory_resource* const resource):
+        _resource(resource)
+    {
+        assert(resource != nullptr);
+    }
+
     /// @brief Registers a flag option to be parsed from the command-line.
     ///
     /// @warning This function will raise an assertion in the event that either:
@@ -38,7 +111,12 @@ public:
     /// @return This instance of CLIParser.
     CLIParser& register_option(FlagOption& option)
     {
-        _named_options.register_flag(option);
+        const _named_id id = _named_options.register_flag(option);
+        _on_registration();
+
+        _layout->add_flag();
+        _add_config_keys(id);
+        _bind_env(option.env, {id, 0});
         return *this;
     }
 
@@ -55,9 +133,66 @@ public:
     CLIParser& register_option(KeyValueOption<Type>& option)
     {
         const _named_id id = _named_options.register_key_value(option);
+        _on_registration();
+
+        _required_key_values.resize(_named_options.key_value_count());
+        if constexpr (!is_optional_v<Type>)
+            _required_key_values.set(id.index());
+
+        _layout->add_key_value<Type>();
+        _add_config_keys(id);
+        _bind_env(option.env, {id, 0});
+        return *this;
+    }
+
+    /// @brief Registers an append option to be parsed from the command-line, any number of times.
+    ///
+    /// @warning This function will raise an assertion in the event that either:
+    /// - There is a clashing alias already registered
+    /// - The aliases aren't prefixed with '-' or '--'.
+    ///
+    /// @tparam Type The expected type of each value of the option.
+    /// @tparam Container The container of the values of the option.
+    /// @param[in, out] option A reference to the option to register.
+    /// @return This instance of CLIParser.
+    template<class Type, class Container>
+    CLIParser& register_option(AppendKeyValueOption<Type, Container>& option)
+    {
+        const _named_id id = _named_options.register_key_value(option);
+        _on_registration();
+
+        // Note: append options are never required, an empty container being a valid set of values.
+        _required_key_values.resize(_named_options.key_value_count());
+
+        _layout->add_key_value<Container>();
+        _add_config_keys(id);
+        _bind_env(option.env, {id, 0});
+        return *this;
+    }
+
+    /// @brief Registers a lazy key-value option to be parsed from the command-line, its value being converted upon
+    /// first access rather than by the parse (See LazyValue).
+    ///
+    /// @warning This function will raise an assertion in the event that either:
+    /// - There is a clashing alias already registered
+    /// - The aliases aren't prefixed with '-' or '--'.
+    ///
+    /// @tparam Type The expected value-type type of the key-value argument.
+    /// @param[in, out] option A reference to the option to register.
+    /// @return This instance of CLIParser.
+    template<class Type>
+    CLIParser& register_option(LazyKeyValueOption<Type>& option)
+    {
+        const _named_id id = _named_options.register_lazy_key_value(option, _erase_lazy_option<Type>(option));
+        _on_registration();
+
+        _required_key_values.resize(_named_options.key_value_count());
         if constexpr (!is_optional_v<Type>)
-            _required_options.push_back(id);
+            _required_key_values.set(id.index());
 
+        _layout->add_key_value<LazyValue<Type>>();
+        _add_config_keys(id);
+        _bind_env(option.env, {id, 0});
         return *this;
     }
 
@@ -69,115 +204,1604 @@ public:
     template<class Type>
     CLIParser& register_option(PositionalOption<Type>& option)
     {
+        assert(!is_frozen() && "Options cannot be registered after freezing.");
+
+        _bind_env(option.env, {_invalid_id, _positional_options.size()});
         _positional_options.register_option(option);
+        _on_registration();
+
+        _layout->add_positional<Type>();
         return *this;
     }
 
-private:
-    // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
-    static void _print_option_description(const std::string& header, const std::string& description)
+    /// @brief Registers a lazy positional option to be parsed from the command-line, its value being converted upon
+    /// first access rather than by the parse (See LazyValue).
+    ///
+    /// @tparam Type The expected type of the positional argument.
+    /// @param[in, out] option A reference to the option to register.
+    /// @return This instance of CLIParser.
+    template<class Type>
+    CLIParser& register_option(LazyPositionalOption<Type>& option)
     {
-        static constexpr std::size_t COL_WIDTH = 80;
+        assert(!is_frozen() && "Options cannot be registered after freezing.");
 
-        std::cout << header.c_str() << ":\n";
-        for (std::size_t offset = 0; offset < description.length(); offset += COL_WIDTH)
-            std::cout << "  " << std::string_view(description).substr(offset, COL_WIDTH) << "\n";
-        std::cout << "\n";
+        _bind_env(option.env, {_invalid_id, _positional_options.size()});
+        _positional_options.register_lazy_option(option, _erase_lazy_option<Type>(option));
+        _on_registration();
+
+        _layout->add_positional<LazyValue<Type>>();
+        return *this;
     }
 
-    void _print_help_message()
+    /// @brief Registers a positional sink, receiving all positional arguments beyond those consumed by positional
+    /// options (Regardless of registration order).
+    ///
+    /// @warning At most one sink may be registered, registering another will raise an assertion.
+    ///
+    /// @tparam Type The expected type of each positional argument.
+    /// @tparam Consumer The type of the callable (Or output iterator) receiving each argument.
+    /// @param[in, out] sink A reference to the sink to register.
+    /// @return This instance of CLIParser.
+    template<class Type, class Consumer>
+    CLIParser& register_option(PositionalSink<Type, Consumer>& sink)
     {
-        // TODO(Caetano): add usage
+        assert(!is_frozen() && "Options cannot be registered after freezing.");
 
-        for (const _positional_description& desc : _positional_options.descriptions())
-            _print_option_description(*desc.name_ptr, *desc.description_ptr);
+        _positional_options.register_sink(sink);
+        _on_registration();
+        return *this;
+    }
+
+    /// @brief Registers several options at once, reserving space for all of their aliases up-front.
+    ///
+    /// @param[in, out] options References to the options to register.
+    /// @return This instance of CLIParser.
+    template<class... Options>
+    CLIParser& register_options(Options&... options)
+    {
+        std::size_t n_aliases = _named_options.alias_to_id().size();
+        (
+            [&] {
+                if constexpr (requires { options.aliases; })
+                    n_aliases += options.aliases.size();
+            }(),
+            ...);
+        _named_options.reserve(n_aliases);
+
+        (register_option(options), ...);
+        return *this;
+    }
+
+    /// @brief Marks the end of option registration, rebuilding the alias lookup as a minimal perfect hash over a single
+    /// contiguous string table.
+    ///
+    /// The layout of ParseResult's is also fixed, and the help message rendered, such that (const) members may be
+    /// invoked concurrently from then on.
+    ///
+    /// @warning No option may be registered after calling this function, doing so will raise an assertion.
+    ///
+    /// @return This instance of CLIParser.
+    CLIParser& freeze()
+    {
+        _named_options.freeze();
+        if (_match_prefixes)
+            _named_options.index_prefixes();
+        _layout->finalise();
+        static_cast<void>(help_message());
+        return *this;
+    }
+
+    /// @return Whether CLIParser::freeze() has been called on this instance.
+    [[nodiscard]] bool is_frozen() const noexcept
+    {
+        return _named_options.is_frozen();
+    }
+
+    /// @brief Enables (or disables) the expansion of response files during parsing.
+    ///
+    /// When enabled, any argument of the form '\@path' is replaced by the whitespace separated arguments contained in
+    /// the file at path. Arguments may be quoted and escaped as they would in a POSIX shell, and may themselves name
+    /// further response files. Response files are memory mapped, and their arguments are parsed as they are read,
+    /// without being copied.
+    ///
+    /// @note Response files remain mapped until the next call to CLIParser::parse(...) (Or the destruction of this
+    /// instance), any string views referring to their contents (e.g. those in parse_error) are valid until then. Those
+    /// mapped by CLIParser::parse_into(...) likewise remain mapped until the next parse into the same result.
+    ///
+    /// @param[in] enable Whether response files should be expanded, disabled by default.
+    /// @return This instance of CLIParser.
+    CLIParser& expand_response_files(const bool enable = true) noexcept
+    {
+        _expand_response_files = enable;
+        return *this;
+    }
+
+    /// @brief Enables (or disables) the matching of long options (i.e. those with an alias prefixed by '--') by their
+    /// unambiguous prefixes, as with GNU getopt_long (e.g. '--verb' for '--verbose').
+    ///
+    /// Arguments matching no alias exactly, but prefixed by '--', are looked up amongst the long aliases of every
+    /// option. If they abbreviate the aliases of exactly one option, they are parsed as that option, whereas if they
+    /// abbreviate those of several, parsing fails with bad_ambiguous_prefix. Otherwise, they are parsed as positional
+    /// arguments, as before.
+    ///
+    /// Long aliases are indexed by a radix trie, so an abbreviation is resolved in time proportional to its length
+    /// (However many options are registered), and exact matches are unaffected.
+    ///
+    /// @param[in] enable Whether prefixes should be matched, disabled by default.
+    /// @return This instance of CLIParser.
+    CLIParser& match_prefixes(const bool enable = true)
+    {
+        _match_prefixes = enable;
+        if (_match_prefixes && is_frozen() && !_named_options.prefixes_indexed())
+            _named_options.index_prefixes();
+        return *this;
+    }
+
+    /// @brief Enables (or disables) the conversion of the values of lazy options as they are parsed, as for any other
+    /// option, rather than upon first access.
+    ///
+    /// Values which cannot be converted are then reported by CLIParser::parse(...) (Or CLIParser::try_parse(...)), at
+    /// the argument giving them, rather than by LazyValue::value(). Converted values remain cached, so are not
+    /// converted again upon access.
+    ///
+    /// @param[in] enable Whether lazy options should be validated eagerly, disabled by default.
+    /// @return This instance of CLIParser.
+    CLIParser& validate_all(const bool enable = true) noexcept
+    {
+        _named_options.validate_lazy_options(enable);
+        _positional_options.validate_lazy_options(enable);
+        return *this;
+    }
+
+    /// @brief Sets a configuration file, from which options not provided on the command-line are read during each
+    /// parse.
+    ///
+    /// The file is memory mapped, and consists of lines of the form:
+    ///  - 'key = value', providing the value of a key-value option. Values may be surrounded by (single or double)
+    ///    quotes, which are removed.
+    ///  - 'key' or 'key = true|false|1|0', enabling (Or not) a flag option.
+    ///  - '[section]', after which each key is prefixed by 'section.' (Until the next section, '[]' returning to keys
+    ///    without a prefix).
+    ///  - '# comment' or '; comment'.
+    ///
+    /// Keys are the aliases of the options they name, without their leading dashes (e.g. 'threads' for an option with
+    /// alias '--threads'). Options provided on the command-line take precedence over those in the file, and values from
+    /// either source satisfy required options.
+    ///
+    /// @note As with response files, the file remains mapped until the next call to CLIParser::parse(...).
+    ///
+    /// @param[in] path The path of the configuration file, or an empty string to read none (The default).
+    /// @return This instance of CLIParser.
+    CLIParser& config_file(const std::string& path)
+    {
+        _config_path = path;
+        return *this;
+    }
+
+    /// @brief Registers a subcommand, selected when named by the first command-line argument (e.g. 'app build ...').
+    ///
+    /// The options of a subcommand are registered by its factory, which is only invoked the first time the subcommand
+    /// is selected, on a parser owned by this instance. Once selected, the remaining arguments are parsed by that
+    /// parser alone, as though the subcommand's name were the name of the binary, hence none of the options registered
+    /// on this instance apply.
+    ///
+    /// The help sink and response file expansion of this instance are applied to the subcommand's parser each time it
+    /// is selected, so are shared with it even if changed afterwards (Overriding any set by the factory). Environment
+    /// variables and configuration files are bound to options, hence only those registered by the factory apply.
+    ///
+    /// @warning This function will raise an assertion in the event that either:
+    ///  - There is a clashing subcommand already registered.
+    ///  - The name is empty, or prefixed with '-'.
+    ///
+    /// @param[in] name The name of the subcommand.
+    /// @param[in] description The description of the subcommand, listed in the help message of this instance.
+    /// @param[in] factory Callable registering the options of the subcommand on the parser it is given.
+    /// @return This instance of CLIParser.
+    CLIParser& register_subcommand(
+        const std::string_view name,
+        const std::string_view description,
+        std::function<void(CLIParser&)> factory)
+    {
+        assert(!name.empty() && !name.starts_with('-') && "Subcommand names must be non-empty, not prefixed by '-'.");
+        assert(!_subcommand_ids.contains(name) && "Duplicate subcommand detected.");
+        assert(!description.empty());
+        assert(factory != nullptr);
+
+        _subcommand_ids.emplace(name, _subcommands.size());
+        _subcommands.push_back(
+            {std::pmr::string(name, _resource), std::pmr::string(description, _resource), std::move(factory), nullptr});
+        _on_registration();
+        return *this;
+    }
+
+    /// @return Whether the last parse answered a request for completions, in which case the binary should exit without
+    /// further ado.
+    ///
+    /// Invoked as 'program --__complete <index> <words...>', CLIParser::parse(...) writes the completions of
+    /// words[index] to the help sink (One per line), then returns without parsing anything else. Words are those of
+    /// the command-line being completed (Starting with the name of the binary), of which index may be one past the
+    /// last. Completions are as described by CLIParser::completion_script(...), aliases being looked up in the sorted
+    /// index built by CLIParser::freeze() (If frozen).
+    [[nodiscard]] bool completion_requested() const noexcept
+    {
+        return _selected_parser()._completion_requested;
+    }
+
+    /// @brief Generates a script completing the command-line of program in shell, from tables of the aliases of each
+    /// option (And the names of each subcommand) embedded in the script. Completions are hence answered without ever
+    /// running program.
+    ///
+    /// Arguments prefixed by '-' are completed with the aliases of options, and the first argument (Of the binary, or
+    /// of any subcommand) with the names of subcommands. The values of key-value options, and positional arguments,
+    /// are left to the default completion of the shell (i.e. of file names).
+    ///
+    /// @note The factory of every subcommand is invoked, so as to list its options.
+    ///
+    /// @param[in] shell The shell to generate a script for, see completion_shell for where to install it.
+    /// @param[in] program The name of the binary, as invoked from the shell.
+    /// @return The script.
+    [[nodiscard]] std::string completion_script(const completion_shell shell, const std::string_view program)
+    {
+        std::vector<_completion_command> commands;
+        _collect_completions("", commands);
+        return _completion_script(shell, program, commands);
+    }
+
+    /// @return The name of the subcommand selected by the last parse, or an empty string if none was.
+    [[nodiscard]] std::string_view selected_subcommand() const noexcept
+    {
+        return _selected_subcommand != _NO_SUBCOMMAND ? std::string_view(_subcommands[_selected_subcommand].name)
+                                                      : std::string_view();
+    }
+
+    /// @brief Redirects the help message, which is otherwise written to the standard output.
+    ///
+    /// @param[in] sink The destination of the help message.
+    /// @return This instance of CLIParser.
+    CLIParser& redirect_help(const help_sink sink) noexcept
+    {
+        assert(sink.write != nullptr);
 
-        std::unordered_map<_named_id, std::string> alias_lists;
-        for (const auto& [name, id] : _named_options.alias_to_id()) {
-            auto [loc, succeeded] = alias_lists.emplace(id, name);
-            if (!succeeded)
-                loc->second += " | " + name;
+        _help_sink = sink;
+        return *this;
+    }
+
+    /// @brief Hands the statistics of every subsequent parse (By CLIParser::parse(...), CLIParser::parse_into(...) or
+    /// their try_ counterparts) to sink, once the parse has finished. Statistics are only recorded if
+    /// LWCLI_INSTRUMENTATION is defined (See parse_stats), otherwise sink is never invoked.
+    ///
+    /// Parses of subcommands are reported to the sink of the parser dispatching to them. Note that
+    /// CLIParser::parse_into(...) may be called concurrently, in which case so is sink.
+    ///
+    /// @param[in] sink The destination of the statistics, or {nullptr, nullptr} to discard them.
+    /// @return This instance of CLIParser.
+    CLIParser& instrument(const parse_stats_sink sink) noexcept
+    {
+        _stats_sink = sink;
+        return *this;
+    }
+
+    /// @brief Retrieves the help message, listing positional options, subcommands and then named options (Each in
+    /// registration order).
+    ///
+    /// The message is rendered upon first use, then cached until another option is registered.
+    ///
+    /// @return The help message, valid until the next option is registered.
+    [[nodiscard]] std::string_view help_message()
+    {
+        if (!_help_rendered) {
+            _render_help_message(_help_message);
+            _help_rendered = true;
         }
+        return _help_message;
+    }
+
+    /// @brief Retrieves the handle by which the count of a flag option is read from a ParseResult.
+    ///
+    /// @warning This function will raise an assertion if either this instance is not frozen, or the option is not
+    /// registered with it.
+    ///
+    /// @param[in] option A reference to the (registered) option.
+    /// @return The handle of the option.
+    [[nodiscard]] FlagHandle handle_of(const FlagOption& option) const noexcept
+    {
+        assert(is_frozen() && "Handles may only be retrieved once frozen.");
 
-        for (const auto& [id, alias_list] : alias_lists)
-            _print_option_description(alias_list, _named_options.description_of(id));
+        const std::size_t index = _named_options.flag_index_of(&option.count);
+        assert(index != _named_options.flag_count() && "Option is not registered.");
+        return FlagHandle(index);
     }
 
-public:
-    /// @brief Parses the command-line arguments based on the options registered.
+    /// @brief Retrieves the handle by which the value of a key-value option is read from a ParseResult.
     ///
-    /// The '-h' and '--help' arguments are reserved for displaying the help menu, self-defined flags carrying these
-    /// aliases will be ignored during parsing. The help menu will also be displayed in the event that \p argv is empty
-    /// (Excluding the first argument which should be the name of the binary).
+    /// @warning This function will raise an assertion if either this instance is not frozen, or the option is not
+    /// registered with it.
     ///
-    /// @param[in] argc The number of arguments
-    /// @param[in] argv The argument list
-    void parse(const int argc, const char* const* argv)
+    /// @tparam Type The value type of the option.
+    /// @param[in] option A reference to the (registered) option.
+    /// @return The handle of the option.
+    template<class Type>
+    [[nodiscard]] ValueHandle<Type> handle_of(const KeyValueOption<Type>& option) const noexcept
     {
-        const auto arg_span = std::span(argv, static_cast<size_t>(argc));
-        if (argc == 1 || contains_any_of(arg_span, std::array{"-h", "--help"}, streq)) {
-            _print_help_message();
+        assert(is_frozen() && "Handles may only be retrieved once frozen.");
+
+        const std::size_t index = _named_options.key_value_index_of(&option.value);
+        assert(index != _named_options.key_value_count() && "Option is not registered.");
+        return {_layout->key_value_offset(index), index, false, &option.value};
+    }
+
+    /// @brief Retrieves the handle by which the values of an append option are read from a ParseResult.
+    ///
+    /// @warning This function will raise an assertion if either this instance is not frozen, or the option is not
+    /// registered with it.
+    ///
+    /// @tparam Type The type of each value of the option.
+    /// @tparam Container The container of the values of the option.
+    /// @param[in] option A reference to the (registered) option.
+    /// @return The handle of the option.
+    template<class Type, class Container>
+    [[nodiscard]] ValueHandle<Container> handle_of(const AppendKeyValueOption<Type, Container>& option) const noexcept
+    {
+        assert(is_frozen() && "Handles may only be retrieved once frozen.");
+
+        const std::size_t index = _named_options.key_value_index_of(&option.values);
+        assert(index != _named_options.key_value_count() && "Option is not registered.");
+        return {_layout->key_value_offset(index), index, false, &option.values};
+    }
+
+    /// @brief Retrieves the handle by which the value of a lazy key-value option is read from a ParseResult, the value
+    /// being converted upon first access to it (See LazyValue).
+    ///
+    /// @warning This function will raise an assertion if either this instance is not frozen, or the option is not
+    /// registered with it.
+    ///
+    /// @tparam Type The value type of the option.
+    /// @param[in] option A reference to the (registered) option.
+    /// @return The handle of the option.
+    template<class Type>
+    [[nodiscard]] ValueHandle<LazyValue<Type>> handle_of(const LazyKeyValueOption<Type>& option) const noexcept
+    {
+        assert(is_frozen() && "Handles may only be retrieved once frozen.");
+
+        const LazyValue<Type>& value = option;
+        const std::size_t index = _named_options.key_value_index_of(&value);
+        assert(index != _named_options.key_value_count() && "Option is not registered.");
+        return {_layout->key_value_offset(index), index, false, &value};
+    }
+
+    /// @brief Retrieves the handle by which the value of a positional option is read from a ParseResult.
+    ///
+    /// @warning This function will raise an assertion if either this instance is not frozen, or the option is not
+    /// registered with it.
+    ///
+    /// @tparam Type The value type of the option.
+    /// @param[in] option A reference to the (registered) option.
+    /// @return The handle of the option.
+    template<class Type>
+    [[nodiscard]] ValueHandle<Type> handle_of(const PositionalOption<Type>& option) const noexcept
+    {
+        assert(is_frozen() && "Handles may only be retrieved once frozen.");
+
+        const std::size_t position = _positional_options.position_of(&option.value);
+        assert(position != _positional_options.size() && "Option is not registered.");
+        return {_layout->positional_offset(position), position, true, &option.value};
+    }
+
+    /// @brief Retrieves the handle by which the value of a lazy positional option is read from a ParseResult, the value
+    /// being converted upon first access to it (See LazyValue).
+    ///
+    /// @warning This function will raise an assertion if either this instance is not frozen, or the option is not
+    /// registered with it.
+    ///
+    /// @tparam Type The value type of the option.
+    /// @param[in] option A reference to the (registered) option.
+    /// @return The handle of the option.
+    template<class Type>
+    [[nodiscard]] ValueHandle<LazyValue<Type>> handle_of(const LazyPositionalOption<Type>& option) const noexcept
+    {
+        assert(is_frozen() && "Handles may only be retrieved once frozen.");
+
+        const LazyValue<Type>& value = option;
+        const std::size_t position = _positional_options.position_of(&value);
+        assert(position != _positional_options.size() && "Option is not registered.");
+        return {_layout->positional_offset(position), position, true, &value};
+    }
+
+private:
+    // Destroys a parser allocated from resource.
+    struct _parser_deleter
+    {
+        std::pmr::memory_resource* resource;
+
+        void operator()(CLIParser* const parser) const noexcept
+        {
+            std::pmr::polymorphic_allocator<>(resource).delete_object(parser);
+        }
+    };
+
+    struct _subcommand
+    {
+        std::pmr::string name;
+        std::pmr::string description;
+        std::function<void(CLIParser&)> factory;
+        // Note: only created (By invoking factory) upon first selection, from the resource of the parent parser.
+        std::unique_ptr<CLIParser, _parser_deleter> parser;
+    };
+
+    static constexpr std::size_t _NO_SUBCOMMAND = static_cast<std::size_t>(-1);
+    // Reserved as the first argument, see CLIParser::completion_requested().
+    static constexpr std::string_view _COMPLETE_ARGUMENT = "--__complete";
+
+    [[nodiscard]] CLIParser& _subcommand_parser(const std::size_t index)
+    {
+        _subcommand& subcommand = _subcommands[index];
+        if (subcommand.parser == nullptr) {
+            subcommand.parser = std::unique_ptr<CLIParser, _parser_deleter>(
+                std::pmr::polymorphic_allocator<>(_resource).new_object<CLIParser>(_resource),
+                _parser_deleter{_resource});
+            subcommand.factory(*subcommand.parser);
+        }
+
+        // Note: applied upon every use, rather than upon creation, such that later changes to this instance apply.
+        subcommand.parser->_help_sink = _help_sink;
+        subcommand.parser->_expand_response_files = _expand_response_files;
+        return *subcommand.parser;
+    }
+
+    // The parser which parsed the arguments of the last parse, i.e. that of the selected subcommand (If any).
+    [[nodiscard]] const CLIParser& _selected_parser() const noexcept
+    {
+        return _selected_subcommand != _NO_SUBCOMMAND ? _subcommands[_selected_subcommand].parser->_selected_parser()
+                                                      : *this;
+    }
+
+    [[nodiscard]] CLIParser& _selected_parser() noexcept
+    {
+        return _selected_subcommand != _NO_SUBCOMMAND ? _subcommands[_selected_subcommand].parser->_selected_parser()
+                                                      : *this;
+    }
+
+    // Hands the statistics of the last parse (Recorded by the parser which parsed it) to the sink of this instance,
+    // upon destruction.
+    [[nodiscard]] _parse_recorder::reporter _report_parse() noexcept
+    {
+        return {_selected_parser()._scratch.recorder, _stats_sink};
+    }
+
+    // The option bound to an environment variable, either named (id) or positional (position, when id is invalid).
+    struct _env_binding
+    {
+        _named_id id;
+        std::size_t position;
+    };
+
+    void _bind_env(const std::string& name, const _env_binding binding)
+    {
+        if (name.empty())
             return;
+
+        assert(!_env_bindings.contains(std::string_view(name)) && "Duplicate environment variable binding detected.");
+        _env_bindings.emplace(name, binding);
+    }
+
+    // Maps each alias of the option, stripped of its leading dashes, to its id.
+    void _add_config_keys(const _named_id id)
+    {
+        for (const std::string& alias : _named_options.aliases_of(id)) {
+            const auto name = std::string_view(alias).substr(std::min(alias.find_first_not_of('-'), alias.size()));
+            if (!name.empty() && _named_options.id_of(alias) == id)
+                _config_keys.emplace(name, id);
         }
+    }
 
-        std::unordered_set not_visited(std::begin(_required_options), std::end(_required_options));
+    // Invalidates the help message, and makes room for the new option in the scratch state of CLIParser::parse(...).
+    void _on_registration()
+    {
+        _help_rendered = false;
+        _scratch.resize(_named_options.flag_count(), _named_options.key_value_count(), _positional_options.size());
+    }
 
-        size_t position = 0;
-        for (int i = 1; i < argc; ++i) {
-            const auto& arg = argv[i];
-            // Named option
-            if (const auto id = _named_options.id_of(argv[i]); id != _invalid_id) {
-                not_visited.erase(id);
-                switch (id.type()) {
-                case _named_id::Type::FLAG:
-                    _named_options.invoke_flag_option(id);
-                    break;
-
-                case _named_id::Type::KEY_VALUE:
-                    if (++i == argc)
-                        throw bad_key_value_format(arg);
-
-                    try {
-                        _named_options.invoke_key_value_option(id, argv[i]);
-                        break;
-                    }
-                    catch (const _bad_cast& e) {
-                        throw bad_value_conversion(arg, e);
-                    }
+    void _render_help_message(std::pmr::string& message) const
+    {
+        // TODO(Caetano): add usage
+        message.clear();
 
-                default:
-                    _unreachable();
-                }
-            }
-            // Positional option
-            else {
-                try {
-                    _positional_options.invoke_at(position++, arg);
-                }
-                catch (const _bad_cast& e) {
-                    throw bad_positional_conversion(e);
-                }
+        for (const _positional_description& desc : _positional_options.descriptions())
+            _append_option_description(message, *desc.name_ptr, *desc.description_ptr);
+
+        for (const _subcommand& subcommand : _subcommands)
+            _append_option_description(message, subcommand.name, subcommand.description);
+
+        std::pmr::string alias_list(_resource);
+        for (const _named_id id : _named_options.ids()) {
+            alias_list.clear();
+            for (const std::string& alias : _named_options.aliases_of(id)) {
+                // Note: reserved aliases (i.e. '-h' and '--help') are never matched by the option, so are not listed.
+                if (_named_options.id_of(alias) != id)
+                    continue;
+                if (!alias_list.empty())
+                    alias_list += " | ";
+                alias_list += alias;
             }
+            // Note: an option defining only reserved aliases can never be given, so is not described.
+            if (alias_list.empty())
+                continue;
+            _append_option_description(message, alias_list, _named_options.description_of(id));
         }
+    }
 
-        if (!not_visited.empty()) [[unlikely]] {
-            std::unordered_map<_named_id, std::string> aliases;
-            for (const auto& [alias, id] : _named_options.alias_to_id()) {
-                if (not_visited.contains(id)) {
-                    const auto [loc, success] = aliases.try_emplace(id, alias);
-                    if (!success)
-                        loc->second += " | " + alias;
-                }
+    void _print_help_message()
+    {
+        _help_sink.write(_help_sink.context, help_message());
+    }
+
+    // Appends the completion tables of this instance (At path), then those of its subcommands.
+    void _collect_completions(const std::string& path, std::vector<_completion_command>& commands)
+    {
+        _completion_command command{path, {}, {}};
+
+        _completion_option& help = command.options.emplace_back();
+        help.description = "Displays the help message.";
+        for (const auto& [alias, id] : _named_options.alias_to_id()) {
+            if (id.type() == _named_id::Type::HELP)
+                help.aliases.emplace_back(alias);
+        }
+        std::ranges::sort(help.aliases);
+
+        for (const _named_id id : _named_options.ids()) {
+            _completion_option option{{}, _named_options.description_of(id), id.type() == _named_id::Type::KEY_VALUE};
+            for (const std::string& alias : _named_options.aliases_of(id)) {
+                // Note: reserved aliases (i.e. '-h' and '--help') are never matched by the option.
+                if (_named_options.id_of(alias) == id)
+                    option.aliases.emplace_back(alias);
             }
-            throw bad_required_options(aliases | std::views::values);
+            if (!option.aliases.empty())
+                command.options.push_back(std::move(option));
         }
-    }
+
+        for (const _subcommand& subcommand : _subcommands)
+            command.subcommands.emplace_back(subcommand.name, subcommand.description);
+        commands.push_back(std::move(command));
+
+        for (std::size_t i = 0; i < _subcommands.size(); ++i)
+            _subcommand_parser(i)._collect_completions(path + "/" + std::string(_subcommands[i].name), commands);
+    }
+
+    // The completions of words[index], see CLIParser::completion_requested().
+    template<class Arg>
+    [[nodiscard]] std::vector<std::string_view> _complete(const std::size_t index, const int n_words, const Arg* words)
+    {
+        const auto word_at = [&](const std::size_t i) {
+            return i < static_cast<std::size_t>(n_words) ? std::string_view(words[i]) : std::string_view();
+        };
+
+        if (index == 0)
+            return {};
+
+        // Note: as when parsing, the remaining words are those of the subcommand named by the first.
+        if (index > 1) {
+            if (const auto loc = _subcommand_ids.find(word_at(1)); loc != _subcommand_ids.end())
+                return _subcommand_parser(loc->second)._complete(index - 1, n_words - 1, words + 1);
+        }
+
+        // Note: the values of key-value options are left to the shell.
+        if (const _named_id id = _named_options.id_of(word_at(index - 1));
+            index > 1 && id != _invalid_id && id.type() == _named_id::Type::KEY_VALUE)
+            return {};
+
+        const std::string_view word = word_at(index);
+        if (word.starts_with('-'))
+            return _named_options.aliases_starting_with(word);
+
+        std::vector<std::string_view> completions;
+        if (index == 1) {
+            for (const _subcommand& subcommand : _subcommands) {
+                if (subcommand.name.starts_with(word))
+                    completions.emplace_back(subcommand.name);
+            }
+            std::ranges::sort(completions);
+        }
+        return completions;
+    }
+
+    // Writes the completions requested by args (An index, followed by the words to complete), see
+    // CLIParser::completion_requested().
+    template<class Arg>
+    void _write_completions(const int n_args, const Arg* args)
+    {
+        std::size_t index = 0;
+        if (n_args < 1 || _from_chars(std::string_view(args[0]), index) != std::errc{})
+            return;
+
+        std::pmr::string completions(_resource);
+        for (const std::string_view completion : _complete(index, n_args - 1, args + 1))
+            completions.append(completion).push_back('\n');
+        _help_sink.write(_help_sink.context, completions);
+    }
+
+    [[nodiscard]] static parse_error _make_error(
+        const parse_errc code,
+        const int index,
+        const std::string_view argument) noexcept
+    {
+        parse_error error;
+        error.code = code;
+        error.index = index;
+        error.argument = argument;
+        return error;
+    }
+
+    // Lists the aliases (Joined by " | ") of each required key-value option not in visited, in registration order.
+    [[nodiscard]] std::vector<std::string> _list_missing_options(const _dynamic_bitset& visited) const
+    {
+        std::vector<std::string> alias_lists;
+        _required_key_values.for_each_not_in(visited, [&](const std::size_t index) {
+            std::string& alias_list = alias_lists.emplace_back();
+            for (const std::string& alias : _named_options.aliases_of(_named_options.key_value_at(index)))
+                alias_list += (alias_list.empty() ? "" : " | ") + alias;
+        });
+        return alias_lists;
+    }
+
+    // Writes parsed values through the registered options themselves, as CLIParser::parse(...) does.
+    struct _option_target
+    {
+        const CLIParser& parser;
+
+        void invoke_flag(const _named_id id) const noexcept
+        {
+            parser._named_options.invoke_flag_option(id);
+        }
+
+        [[nodiscard]] bool invoke_key_value(
+            const _named_id id,
+            const std::string_view key,
+            const std::string_view value) const
+        {
+            return parser._named_options.invoke_key_value_option(id, key, value);
+        }
+
+        void prepare_key_value(const _named_id id, const std::size_t n_values) const
+        {
+            parser._named_options.prepare_key_value_option(id, n_values);
+        }
+
+        [[nodiscard]] bool invoke_positional(const std::size_t position, const std::string_view value) const
+        {
+            return parser._positional_options.invoke_at(position, value);
+        }
+    };
+
+    // Writes parsed values into the buffer of a ParseResult, as CLIParser::parse_into(...) does. The registered options
+    // are left untouched.
+    struct _result_target
+    {
+        const CLIParser& parser;
+        std::byte* buffer;
+
+        void invoke_flag(const _named_id id) const noexcept
+        {
+            ++_result_layout::counts(buffer)[id.index()];
+        }
+
+        [[nodiscard]] bool invoke_key_value(
+            const _named_id id,
+            const std::string_view key,
+            const std::string_view value) const
+        {
+            return parser._named_options.invoke_key_value_option(
+                id,
+                key,
+                value,
+                buffer + parser._layout->key_value_offset(id.index()));
+        }
+
+        void prepare_key_value(const _named_id id, const std::size_t n_values) const
+        {
+            parser._named_options.prepare_key_value_option(
+                id,
+                n_values,
+                buffer + parser._layout->key_value_offset(id.index()));
+        }
+
+        [[nodiscard]] bool invoke_positional(const std::size_t position, const std::string_view value) const
+        {
+            return parser._positional_options.invoke_at(
+                position,
+                value,
+                buffer + parser._layout->positional_offset(position));
+        }
+    };
+
+    // State carried from one argument to the next, throughout a single parse writing its values to Target.
+    template<class Target>
+    struct _parse_state
+    {
+        Target target;
+        _parse_scratch& scratch;
+
+        std::size_t position = 0;
+        bool help_requested = false;
+
+        // The key-value option awaiting a value (If any), along with the key (and its index) which named it.
+        _named_id pending_id = _invalid_id;
+        std::string_view pending_key{};
+        int pending_index = 0;
+
+        // The first positional argument resembling an option, likely a misspelling of one.
+        std::string_view unknown_option{};
+    };
+
+    // Returns false if value could not be converted to the type expected by the option at position.
+    template<class Target>
+    [[nodiscard]] bool _parse_positional(
+        _parse_state<Target>& state,
+        const std::size_t position,
+        const std::string_view value) const
+    {
+        {
+            [[maybe_unused]] const auto timer = state.scratch.recorder.time_positional_conversion(position);
+            if (!state.target.invoke_positional(position, value)) [[unlikely]]
+                return false;
+        }
+
+        // Note: the sink (i.e. beyond the last positional option) is not tracked.
+        if (position < _positional_options.size())
+            state.scratch.visited_positionals.set(position);
+        return true;
+    }
+
+    template<class Target>
+    [[nodiscard]] _named_id _lookup(_parse_state<Target>& state, const std::string_view arg) const noexcept
+    {
+        [[maybe_unused]] const auto timer = state.scratch.recorder.time_lookup();
+        return _named_options.id_of(arg);
+    }
+
+    // Resolves an argument matching no alias exactly, as an unambiguous prefix of a long alias (If enabled).
+    [[nodiscard]] _prefix_match<_named_id> _match_prefix(const std::string_view arg) const noexcept
+    {
+        return _match_prefixes ? _named_options.match_prefix(arg) : _prefix_match<_named_id>{};
+    }
+
+    // Converts value for the key-value option id, returning false if it could not be converted. The values of append
+    // options are instead deferred and counted, to be converted by _append_values(...) once all have been.
+    template<class Target>
+    [[nodiscard]] bool _invoke_key_value(
+        _parse_state<Target>& state,
+        const _named_id id,
+        const std::string_view key,
+        const std::string_view value,
+        const int index) const
+    {
+        if (_named_options.is_append_option(id)) [[unlikely]] {
+            state.scratch.appended_values.push_back({id.index(), index, key, value});
+            ++state.scratch.append_counts[id.index()];
+            return true;
+        }
+
+        [[maybe_unused]] const auto timer = state.scratch.recorder.time_key_value_conversion(id.index());
+        return state.target.invoke_key_value(id, key, value);
+    }
+
+    // Converts the deferred values of append options in the order given, each container being emptied and reserved for
+    // all of its values upon reaching the first of them.
+    template<class Target>
+    [[nodiscard]] parse_error _append_values(_parse_state<Target>& state) const
+    {
+        for (const auto& appended : state.scratch.appended_values) {
+            const _named_id id = _named_options.key_value_at(appended.key_value_index);
+            if (const std::size_t n_values = std::exchange(state.scratch.append_counts[id.index()], 0); n_values != 0)
+                state.target.prepare_key_value(id, n_values);
+
+            [[maybe_unused]] const auto timer = state.scratch.recorder.time_key_value_conversion(id.index());
+            if (!state.target.invoke_key_value(id, appended.key, appended.value)) [[unlikely]] {
+                auto error = _make_error(parse_errc::value_conversion, appended.index, appended.key);
+                error.value = appended.value;
+                error.type_name = _named_options.type_name_of(id);
+                return error;
+            }
+        }
+        return {};
+    }
+
+    // Parses the named option id, given as key (Its value, if any, following as the next argument).
+    template<class Target>
+    void _parse_named(_parse_state<Target>& state, const _named_id id, const std::string_view key, const int index)
+        const noexcept
+    {
+        switch (id.type()) {
+        case _named_id::Type::FLAG:
+            state.scratch.recorder.hit_flag(id.index());
+            state.scratch.visited_flags.set(id.index());
+            state.target.invoke_flag(id);
+            break;
+
+        case _named_id::Type::KEY_VALUE:
+            state.scratch.recorder.hit_key_value(id.index());
+            state.scratch.visited_key_values.set(id.index());
+            state.pending_id = id;
+            state.pending_key = key;
+            state.pending_index = index;
+            break;
+
+        case _named_id::Type::HELP:
+            state.help_requested = true;
+            break;
+        }
+    }
+
+    // Given a cluster of short options (e.g. '-vvv', or '-vj8' for '-v -j 8'), returns the index of the key-value
+    // option ending it, or its size if it consists of flags alone. Returns 0 if arg is not a cluster, i.e. any of its
+    // characters (Up to the key-value option) is not a short option.
+    [[nodiscard]] std::size_t _short_cluster_end(const std::string_view arg) const noexcept
+    {
+        for (std::size_t i = 1; i < arg.size(); ++i) {
+            const _named_id id = _named_options.short_id_of(arg[i]);
+            if (id == _invalid_id)
+                return 0;
+            if (id.type() == _named_id::Type::KEY_VALUE)
+                return i;
+        }
+        return arg.size();
+    }
+
+    // The alias of the short option chr (e.g. '-j'), naming it as if it were given outside of a cluster.
+    [[nodiscard]] static std::string_view _short_alias_of(const char chr) noexcept
+    {
+        static constexpr auto ALIASES = [] {
+            std::array<char, 512> aliases{};
+            for (std::size_t i = 0; i < 256; ++i) {
+                aliases[2 * i] = '-';
+                aliases[2 * i + 1] = static_cast<char>(i);
+            }
+            return aliases;
+        }();
+        return {ALIASES.data() + 2 * static_cast<unsigned char>(chr), 2};
+    }
+
+    // Parses the cluster of short options arg, ending at last (See _short_cluster_end(...)). The value of a key-value
+    // option ending the cluster is the remainder of arg (e.g. '-j8'), or if there is none, the next argument.
+    template<class Target>
+    [[nodiscard]] parse_error _parse_short_cluster(
+        _parse_state<Target>& state,
+        const std::string_view arg,
+        const std::size_t last,
+        const int index) const
+    {
+        for (std::size_t i = 1; i < last; ++i)
+            _parse_named(state, _named_options.short_id_of(arg[i]), _short_alias_of(arg[i]), index);
+
+        if (last == arg.size())
+            return {};
+
+        const _named_id id = _named_options.short_id_of(arg[last]);
+        if (last + 1 == arg.size()) {
+            _parse_named(state, id, _short_alias_of(arg[last]), index);
+            return {};
+        }
+        return _parse_named_value(state, id, _short_alias_of(arg[last]), arg.substr(last + 1), index);
+    }
+
+    // Parses a single argument, originating from argv[index] (Or from the response file it names).
+    template<class Target>
+    [[nodiscard]] parse_error _parse_argument(
+        _parse_state<Target>& state,
+        const std::string_view arg,
+        const int index) const
+    {
+        // Value of a key-value option
+        if (state.pending_id != _invalid_id) {
+            const auto id = std::exchange(state.pending_id, _invalid_id);
+            if (!_invoke_key_value(state, id, state.pending_key, arg, state.pending_index)) [[unlikely]] {
+                auto error = _make_error(parse_errc::value_conversion, state.pending_index, state.pending_key);
+                error.value = arg;
+                error.type_name = _named_options.type_name_of(id);
+                return error;
+            }
+            return {};
+        }
+
+        // Named option
+        _named_id id = _lookup(state, arg);
+        if (id == _invalid_id && _match_prefixes) [[unlikely]] {
+            const auto match = _match_prefix(arg);
+            if (match.status == _prefix_status::AMBIGUOUS)
+                return _make_error(parse_errc::ambiguous_prefix, index, arg);
+            id = match.value;
+        }
+
+        if (id != _invalid_id) {
+            _parse_named(state, id, arg, index);
+            return {};
+        }
+
+        // Long option with an inline value (e.g. '--threads=8'), or a cluster of short options (e.g. '-vj8')
+        if (arg.size() > 2 && arg.front() == '-') [[unlikely]] {
+            if (arg[1] == '-') {
+                if (const std::size_t separator = arg.find('=', 2); separator != std::string_view::npos) {
+                    const std::string_view key = arg.substr(0, separator);
+                    id = _lookup(state, key);
+                    if (id == _invalid_id && _match_prefixes) {
+                        const auto match = _match_prefix(key);
+                        if (match.status == _prefix_status::AMBIGUOUS)
+                            return _make_error(parse_errc::ambiguous_prefix, index, key);
+                        id = match.value;
+                    }
+
+                    if (id != _invalid_id) {
+                        if (id.type() == _named_id::Type::HELP) {
+                            state.help_requested = true;
+                            return {};
+                        }
+                        return _parse_named_value(state, id, key, arg.substr(separator + 1), index);
+                    }
+                }
+            }
+            else if (const std::size_t last = _short_cluster_end(arg); last != 0)
+                return _parse_short_cluster(state, arg, last, index);
+        }
+
+        // Positional option
+        if (state.unknown_option.empty() && _resembles_option(arg)) [[unlikely]]
+            state.unknown_option = arg;
+
+        if (!_positional_options.accepts(state.position)) [[unlikely]] {
+            auto error = _make_error(parse_errc::positional_count, index, arg);
+            error.n_max_positional = _positional_options.size();
+            error.value = state.unknown_option;
+            return error;
+        }
+
+        if (!_parse_positional(state, state.position, arg)) [[unlikely]] {
+            auto error = _make_error(parse_errc::positional_conversion, index, arg);
+            error.value = arg;
+            error.type_name = _positional_options.type_name_at(state.position);
+            return error;
+        }
+        ++state.position;
+        return {};
+    }
+
+    // Whether arg is prefixed by '-', but is not a (negative) number.
+    [[nodiscard]] static bool _resembles_option(const std::string_view arg) noexcept
+    {
+        return arg.size() > 1 && arg.front() == '-' && (arg[1] < '0' || arg[1] > '9') && arg[1] != '.';
+    }
+
+    // The aliases nearest to arg (Which is likely a misspelling of one), if it resembles an option.
+    [[nodiscard]] std::vector<std::string> _suggest_aliases(const std::string_view arg) const
+    {
+        return _resembles_option(arg) ? _named_options.nearest_aliases(arg) : std::vector<std::string>{};
+    }
+
+    [[nodiscard]] static bool _is_response_file_argument(const std::string_view arg) noexcept
+    {
+        return arg.size() > 1 && arg.front() == '@';
+    }
+
+    // Maps the response file at path, and parses each of its arguments in turn. Tokens are unescaped in place within
+    // the (copy-on-write) mapping, which is kept alive until the next parse.
+    template<class Target>
+    [[nodiscard]] parse_error _parse_response_file(
+        _parse_state<Target>& state,
+        const char* const path,
+        const std::string_view arg,
+        const int index,
+        const int depth) const
+    {
+        static constexpr int MAX_RESPONSE_FILE_DEPTH = 64;
+
+        const auto make_error = [&](const char* const reason) {
+            auto error = _make_error(parse_errc::response_file, index, arg);
+            error.reason = reason;
+            return error;
+        };
+
+        if (depth == MAX_RESPONSE_FILE_DEPTH) [[unlikely]]
+            return make_error("nests response files too deeply");
+
+        _mapped_file file(path);
+        if (!file.is_open()) [[unlikely]]
+            return make_error("could not be opened");
+
+        char* cursor = file.data();
+        char* const end = cursor + file.size();
+        state.scratch.mapped_files.push_back(std::move(file));
+
+        std::string_view token;
+        while (true) {
+            switch (_next_shell_token(cursor, end, token)) {
+            case _token_status::END:
+                return {};
+            case _token_status::UNTERMINATED_QUOTE:
+                return make_error("contains an unterminated quote");
+            case _token_status::TOKEN:
+                break;
+            }
+
+            parse_error error;
+            if (_is_response_file_argument(token)) {
+                // Note: tokens are not null terminated, hence the nested path must be copied.
+                const std::pmr::string nested_path(token.substr(1), state.scratch.resource());
+                error = _parse_response_file(state, nested_path.c_str(), token, index, depth + 1);
+            }
+            else
+                error = _parse_argument(state, token, index);
+
+            if (error.code != parse_errc{} || state.help_requested) [[unlikely]]
+                return error;
+        }
+    }
+
+    [[nodiscard]] static bool _test_id(
+        const _named_id id,
+        const _dynamic_bitset& flags,
+        const _dynamic_bitset& key_values) noexcept
+    {
+        switch (id.type()) {
+        case _named_id::Type::FLAG:
+            return flags.test(id.index());
+        case _named_id::Type::KEY_VALUE:
+            return key_values.test(id.index());
+        case _named_id::Type::HELP:
+            break;
+        }
+        _unreachable();
+    }
+
+    // Applies value to the option with the given id, named by key. The value is given inline in argv (e.g.
+    // '--key=value', or '-j8' ending a cluster), or by a source other than argv; either way flags take a boolean value,
+    // rather than none.
+    template<class Target>
+    [[nodiscard]] parse_error _parse_named_value(
+        _parse_state<Target>& state,
+        const _named_id id,
+        const std::string_view key,
+        const std::string_view value,
+        const int index) const
+    {
+        const auto make_error = [&](const char* const type_name) {
+            auto error = _make_error(parse_errc::value_conversion, index, key);
+            error.value = value;
+            error.type_name = type_name;
+            return error;
+        };
+
+        switch (id.type()) {
+        case _named_id::Type::FLAG: {
+            bool enabled = false;
+            {
+                [[maybe_unused]] const auto timer = state.scratch.recorder.time_flag_conversion();
+                if (cast<bool>::try_from_string(value, enabled) != std::errc{}) [[unlikely]]
+                    return make_error(typeid(bool).name());
+            }
+
+            state.scratch.recorder.hit_flag(id.index());
+            state.scratch.visited_flags.set(id.index());
+            if (enabled)
+                state.target.invoke_flag(id);
+            return {};
+        }
+        case _named_id::Type::KEY_VALUE: {
+            state.scratch.recorder.hit_key_value(id.index());
+            state.scratch.visited_key_values.set(id.index());
+
+            if (!_invoke_key_value(state, id, key, value, index)) [[unlikely]]
+                return make_error(_named_options.type_name_of(id));
+            return {};
+        }
+
+        case _named_id::Type::HELP:
+            break;
+        }
+        _unreachable();
+    }
+
+    [[nodiscard]] _named_id _config_id_of(
+        const std::string_view section,
+        const std::string_view key,
+        std::pmr::string& scratch) const
+    {
+        std::string_view name = key;
+        if (!section.empty()) {
+            // Note: the scratch buffer only allocates when outgrown, not once per key.
+            scratch.assign(section).append(".").append(key);
+            name = scratch;
+        }
+
+        const auto loc = _config_keys.find(name);
+        return loc != _config_keys.end() ? loc->second : _invalid_id;
+    }
+
+    template<class Target>
+    [[nodiscard]] parse_error _parse_config_line(
+        _parse_state<Target>& state,
+        const std::string_view line,
+        std::string_view& section,
+        const int argc) const
+    {
+        const auto make_error = [&](const std::string_view argument, const char* const reason) {
+            auto error = _make_error(parse_errc::config_file, argc, argument);
+            error.reason = reason;
+            return error;
+        };
+
+        std::string_view key;
+        std::string_view value;
+        const _config_line kind = _classify_config_line(line, key, value);
+        switch (kind) {
+        case _config_line::BLANK:
+            return {};
+        case _config_line::SECTION:
+            section = key;
+            return {};
+        case _config_line::BAD_SECTION:
+            return make_error(line, "contains a malformed section header");
+        case _config_line::KEY:
+        case _config_line::KEY_VALUE:
+            break;
+        }
+
+        const _named_id id = _config_id_of(section, key, state.scratch.config_key);
+        if (id == _invalid_id) [[unlikely]]
+            return make_error(key, "names an unknown option");
+
+        // Note: values provided by higher precedence sources (i.e. argv) are not overridden, whereas those provided
+        // earlier in the file are (As they would be on the command-line).
+        if (_test_id(id, state.scratch.shadowed_flags, state.scratch.shadowed_key_values))
+            return {};
+
+        if (kind == _config_line::KEY) {
+            if (id.type() == _named_id::Type::KEY_VALUE) [[unlikely]]
+                return _make_error(parse_errc::key_value_format, argc, key);
+            value = "true";
+        }
+        return _parse_named_value(state, id, key, value, argc);
+    }
+
+    // Maps the configuration file, and parses each of its lines in a single pass. Each line is viewed (rather than
+    // copied) from the mapping, which is kept alive until the next parse.
+    template<class Target>
+    [[nodiscard]] parse_error _parse_config_file(_parse_state<Target>& state, const int argc) const
+    {
+        _mapped_file file(_config_path.c_str());
+        if (!file.is_open()) [[unlikely]] {
+            auto error = _make_error(parse_errc::config_file, argc, _config_path);
+            error.reason = "could not be opened";
+            return error;
+        }
+
+        const std::string_view content(file.data(), file.size());
+        state.scratch.mapped_files.push_back(std::move(file));
+
+        // Note: copying between equally sized bitsets does not allocate.
+        state.scratch.shadowed_flags = state.scratch.visited_flags;
+        state.scratch.shadowed_key_values = state.scratch.visited_key_values;
+
+        std::string_view section;
+        parse_error error;
+        std::size_t line_begin = 0;
+        const auto parse_line = [&](const std::size_t line_end) {
+            error = _parse_config_line(state, content.substr(line_begin, line_end - line_begin), section, argc);
+            line_begin = line_end + 1;
+            return error.code == parse_errc{};
+        };
+
+        if (_for_each_occurrence(content, '\n', parse_line) && line_begin < content.size())
+            parse_line(content.size());
+        return error;
+    }
+
+    // Applies the values of all bound environment variables, in a single pass over the environment, to the options not
+    // given on the command-line.
+    template<class Target>
+    [[nodiscard]] parse_error _parse_environment(_parse_state<Target>& state, const int argc) const
+    {
+        for (char* const* entry = _environment(); *entry != nullptr; ++entry) {
+            const std::string_view variable = *entry;
+            const std::size_t separator = variable.find('=');
+            if (separator == std::string_view::npos)
+                continue;
+
+            const std::string_view name = variable.substr(0, separator);
+            const auto loc = _env_bindings.find(name);
+            if (loc == _env_bindings.end())
+                continue;
+
+            const std::string_view value = variable.substr(separator + 1);
+            const _env_binding binding = loc->second;
+
+            if (binding.id != _invalid_id) {
+                if (_test_id(binding.id, state.scratch.visited_flags, state.scratch.visited_key_values))
+                    continue;
+                if (auto error = _parse_named_value(state, binding.id, name, value, argc); error.code != parse_errc{})
+                    [[unlikely]]
+                    return error;
+            }
+            else if (binding.position >= state.position) {
+                if (!_parse_positional(state, binding.position, value)) [[unlikely]] {
+                    auto error = _make_error(parse_errc::value_conversion, argc, name);
+                    error.value = value;
+                    error.type_name = _positional_options.type_name_at(binding.position);
+                    return error;
+                }
+            }
+        }
+        return {};
+    }
+
+    // Whether any of argv[first, argc) requests help.
+    template<class Arg>
+    [[nodiscard]] bool _requests_help(const int first, const int argc, const Arg* argv) const noexcept
+    {
+        for (int i = first; i < argc; ++i) {
+            const std::string_view arg = argv[i];
+            _named_id id = _named_options.id_of(arg);
+            if (id == _invalid_id)
+                id = _match_prefix(arg).value;
+            if (id.type() == _named_id::Type::HELP)
+                return true;
+
+            // Note: so may clusters of short options, bar within the value of a key-value option ending them.
+            if (id == _invalid_id && arg.size() > 2 && arg.front() == '-' && arg[1] != '-') {
+                const std::size_t last = _short_cluster_end(arg);
+                for (std::size_t j = 1; j < last; ++j) {
+                    if (_named_options.short_id_of(arg[j]).type() == _named_id::Type::HELP)
+                        return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    // Parses argv in a single pass without throwing, returning a default constructed parse_error (code == parse_errc{})
+    // upon success. Requests for help are detected as each argument is classified, and take precedence over any error,
+    // in which case parsing stops (With state.help_requested set) before any source other than argv is read.
+    //
+    // Arguments are either null terminated (const char*), or the views of a split command-line (std::string_view).
+    //
+    // Note: only ever writes to state (Its target and scratch), never to this instance, so may be called concurrently.
+    template<class Arg, class Target>
+    [[nodiscard]] parse_error _parse_arguments(const int argc, const Arg* argv, _parse_state<Target>& state) const
+    {
+        static_assert(std::is_same_v<Arg, const char*> || std::is_same_v<Arg, std::string_view>);
+
+        state.scratch.reset();
+        // Note: an upper bound on the values of append options given by argv itself, those of response files, the
+        // environment and the configuration file may still grow the list. Its capacity is kept across parses though.
+        if (_named_options.has_append_options())
+            state.scratch.appended_values.reserve(static_cast<std::size_t>(argc));
+
+        for (int i = 1; i < argc; ++i) {
+            const std::string_view arg = argv[i];
+
+            parse_error error;
+            if (_expand_response_files && _is_response_file_argument(arg)) {
+                if constexpr (std::is_same_v<Arg, const char*>)
+                    error = _parse_response_file(state, argv[i] + 1, arg, i, 0);
+                else {
+                    // Note: views are not null terminated, hence the path must be copied.
+                    const std::pmr::string path(arg.substr(1), state.scratch.resource());
+                    error = _parse_response_file(state, path.c_str(), arg, i, 0);
+                }
+            }
+            else
+                error = _parse_argument(state, arg, i);
+
+            if (error.code != parse_errc{}) [[unlikely]] {
+                // Note: only the remaining arguments need be searched, any preceding request would have been found.
+                state.help_requested = state.help_requested || _requests_help(i + 1, argc, argv);
+                if (!state.help_requested)
+                    return error;
+            }
+
+            if (state.help_requested) [[unlikely]]
+                break;
+        }
+
+        if (argc == 1 || state.help_requested) {
+            state.help_requested = true;
+            return {};
+        }
+
+        if (state.pending_id != _invalid_id) [[unlikely]]
+            return _make_error(parse_errc::key_value_format, state.pending_index, state.pending_key);
+
+        if (!_env_bindings.empty()) {
+            if (const auto error = _parse_environment(state, argc); error.code != parse_errc{}) [[unlikely]]
+                return error;
+        }
+
+        if (!_config_path.empty()) {
+            if (const auto error = _parse_config_file(state, argc); error.code != parse_errc{}) [[unlikely]]
+                return error;
+        }
+
+        if (!state.scratch.appended_values.empty()) {
+            if (const auto error = _append_values(state); error.code != parse_errc{}) [[unlikely]]
+                return error;
+        }
+
+        // Note: names the first (In registration order) missing option, all of which are listed by the error.
+        if (const std::size_t missing = _required_key_values.find_first_not_in(state.scratch.visited_key_values);
+            missing != _required_key_values.size()) [[unlikely]] {
+            const auto& aliases = _named_options.aliases_of(_named_options.key_value_at(missing));
+            auto error = _make_error(parse_errc::required_options, argc, aliases.front());
+            error.missing_options = _list_missing_options(state.scratch.visited_key_values);
+            return error;
+        }
+        return {};
+    }
+
+    // Equivalent to _parse_arguments(...), writing to the registered options, but first dispatching to the subcommand
+    // named by argv[1] (If any), and printing the help message if requested.
+    template<class Arg>
+    [[nodiscard]] parse_error _parse(const int argc, const Arg* argv)
+    {
+        if (_match_prefixes && !_named_options.prefixes_indexed())
+            _named_options.index_prefixes();
+
+        _selected_subcommand = _NO_SUBCOMMAND;
+        _completion_requested = argc > 1 && std::string_view(argv[1]) == _COMPLETE_ARGUMENT;
+        if (_completion_requested) [[unlikely]] {
+            _write_completions(argc - 2, argv + 2);
+            return {};
+        }
+
+        if (argc > 1 && !_subcommands.empty()) {
+            if (const auto loc = _subcommand_ids.find(std::string_view(argv[1])); loc != _subcommand_ids.end()) {
+                _selected_subcommand = loc->second;
+
+                auto error = _subcommand_parser(loc->second)._parse(argc - 1, argv + 1);
+                // Note: indices are made relative to this instance's argv.
+                if (error.code != parse_errc{}) [[unlikely]]
+                    ++error.index;
+                return error;
+            }
+        }
+
+        // Note: arguments recorded by lazy options may view those of the last parse, or files it mapped.
+        _named_options.discard_lazy_values();
+        _positional_options.discard_lazy_values();
+
+        _parse_state<_option_target> state{{*this}, _scratch};
+        const auto error = _parse_arguments(argc, argv, state);
+        if (state.help_requested)
+            _print_help_message();
+        return error;
+    }
+
+    // Equivalent to _parse_arguments(...), writing to result.
+    template<class Arg>
+    [[nodiscard]] parse_error _parse_into(const int argc, const Arg* argv, ParseResult& result) const
+    {
+        assert(is_frozen() && "Only frozen parsers may parse into a ParseResult.");
+        assert(!_positional_options.has_sink() && "Positional sinks cannot be parsed into a ParseResult.");
+
+        result._prepare(_layout);
+
+        _parse_state<_result_target> state{{*this, result._buffer}, result._scratch};
+        const auto error = _parse_arguments(argc, argv, state);
+        result._help_requested = state.help_requested;
+        return error;
+    }
+
+    template<class Arg>
+    void _parse_or_throw(const int argc, const Arg* argv)
+    {
+        const auto error = _parse(argc, argv);
+        [[maybe_unused]] const auto report = _report_parse();
+        if (error.code != parse_errc{}) [[unlikely]] {
+            // Note: the error must be described by the parser that raised it.
+            CLIParser& parser = _selected_parser();
+            [[maybe_unused]] const auto timer = parser._scratch.recorder.time_error();
+            parser._throw_parse_error(error);
+        }
+    }
+
+    [[noreturn]] void _throw_parse_error(const parse_error& error) const
+    {
+        const auto argument = std::string(error.argument);
+        switch (error.code) {
+        case parse_errc::positional_count:
+            throw bad_positional_count(argument, error.n_max_positional, _suggest_aliases(error.value));
+        case parse_errc::positional_conversion:
+            throw bad_positional_conversion(argument, error.type_name, _suggest_aliases(error.value));
+        case parse_errc::value_conversion:
+            throw bad_value_conversion(argument, std::string(error.value), error.type_name);
+        case parse_errc::key_value_format:
+            throw bad_key_value_format(argument);
+        case parse_errc::required_options:
+            throw bad_required_options(error.missing_options);
+        case parse_errc::response_file:
+            throw bad_response_file(argument, error.reason);
+        case parse_errc::config_file:
+            throw bad_config_file(argument, error.reason);
+        case parse_errc::command_line:
+            throw bad_command_line(argument, error.reason);
+        case parse_errc::ambiguous_prefix: {
+            std::vector<std::string> candidates;
+            for (const std::string_view alias : _named_options.aliases_starting_with(error.argument))
+                candidates.emplace_back(alias);
+            throw bad_ambiguous_prefix(argument, std::move(candidates));
+        }
+        }
+        _unreachable();
+    }
+
+public:
+    /// @brief Parses the command-line arguments based on the options registered.
+    ///
+    /// The '-h' and '--help' arguments are reserved for displaying the help menu, self-defined flags carrying these
+    /// aliases will be ignored during parsing. The help menu will also be displayed in the event that \p argv is empty
+    /// (Excluding the first argument which should be the name of the binary). A request for help takes precedence over
+    /// any parse error, though options preceding it in \p argv will have already been parsed. Note that '-h' and
+    /// '--help' are parsed as values when following a key-value option. Likewise, a first argument of '--__complete'
+    /// is reserved for requests for completions, see CLIParser::completion_requested().
+    ///
+    /// Arguments matching no alias exactly are then split as follows:
+    ///  - '--key=value' gives the value of the long option '--key' inline. Flags accept 'true|false|1|0' as values.
+    ///  - '-abc' is a (POSIX) cluster of the short options '-a', '-b' and '-c' (Options with an alias of a single
+    ///    character prefixed by '-'), e.g. '-vvv' for '-v -v -v'. A key-value option ends the cluster, its value being
+    ///    the remainder of the argument (e.g. '-j8' or '-vj8'), or the next argument if there is none. Arguments
+    ///    naming any other character are not clusters, and are parsed as positional arguments (e.g. '-12').
+    ///
+    /// Values split from an argument are views of argv, and are never copied before being converted.
+    ///
+    /// Options not given on the command-line are then read from the environment variables they are bound to (See the
+    /// env member of each option), and lastly from the configuration file (See CLIParser::config_file(...)). Values
+    /// from any of these sources satisfy required options.
+    ///
+    /// The values of append options (See AppendKeyValueOption) are converted last, once every source has been read,
+    /// hence a value that fails to convert is only reported if no other error is.
+    ///
+    /// @throws bad_parse (Or rather, one of its subclasses) if the command-line arguments could not be parsed.
+    ///
+    /// @param[in] argc The number of arguments
+    /// @param[in] argv The argument list
+    void parse(const int argc, const char* const* argv)
+    {
+        _parse_or_throw(argc, argv);
+    }
+
+    /// @brief Splits command_line into arguments as would a POSIX shell (See ShellTokenizer), then parses them as by
+    /// CLIParser::parse(argc, argv).
+    ///
+    /// Arguments free of quotes and escapes are parsed as views of command_line itself, hence no argument list is built
+    /// beyond the views themselves, whose storage is reused by every call.
+    ///
+    /// @throws bad_command_line if command_line contains an unterminated quote.
+    /// @throws bad_parse (Or rather, one of its subclasses) if the command-line arguments could not be parsed.
+    ///
+    /// @param[in] command_line The command-line, whose first argument should be the name of the binary.
+    void parse(const std::string_view command_line)
+    {
+        const auto args = _tokenizer.split(command_line);
+        _parse_or_throw(static_cast<int>(args.size()), args.data());
+    }
+
+    /// @brief Parses the command-line arguments into result, rather than into the registered options.
+    ///
+    /// Neither this instance nor its options are written to, hence any number of threads may parse concurrently with a
+    /// single (frozen) parser, each into its own result. Arguments are parsed as by CLIParser::parse(...), except that:
+    ///  - The help message is not printed, requests for help are instead reported by ParseResult::help_requested().
+    ///  - Subcommands are not dispatched to.
+    ///
+    /// @warning This function will raise an assertion if this instance is not frozen, or has a positional sink
+    /// registered.
+    ///
+    /// @throws bad_parse (Or rather, one of its subclasses) if the command-line arguments could not be parsed.
+    ///
+    /// @param[in] argc The number of arguments
+    /// @param[in] argv The argument list
+    /// @param[out] result The result to parse into, which is allocated upon first use then reused.
+    void parse_into(const int argc, const char* const* argv, ParseResult& result) const
+    {
+        const auto error = _parse_into(argc, argv, result);
+        [[maybe_unused]] const _parse_recorder::reporter report(result._scratch.recorder, _stats_sink);
+        if (error.code != parse_errc{}) [[unlikely]] {
+            [[maybe_unused]] const auto timer = result._scratch.recorder.time_error();
+            _throw_parse_error(error);
+        }
+    }
+
+#ifdef __cpp_lib_expected
+    /// @brief Equivalent to CLIParser::parse(...), but reports failures through its return value instead of throwing.
+    ///
+    /// Failed conversions are detected without throwing (Nor catching) exceptions, unless a user-defined cast<>
+    /// specialisation only provides a (throwing) from_string(...) member. No message text is built unless
+    /// parse_error::format() is called.
+    ///
+    /// @param[in] argc The number of arguments
+    /// @param[in] argv The argument list
+    /// @return Nothing upon success, otherwise a parse_error describing the first failure encountered.
+    [[nodiscard]] std::expected<void, parse_error> try_parse(const int argc, const char* const* argv)
+    {
+        auto error = _parse(argc, argv);
+        [[maybe_unused]] const auto report = _report_parse();
+        if (error.code != parse_errc{}) [[unlikely]]
+            return std::unexpected(std::move(error));
+        return {};
+    }
+
+    /// @brief Equivalent to CLIParser::parse(command_line), but reports failures through its return value instead of
+    /// throwing.
+    ///
+    /// @param[in] command_line The command-line, whose first argument should be the name of the binary.
+    /// @return Nothing upon success, otherwise a parse_error describing the first failure encountered. Its string views
+    /// refer either to command_line, or to storage reused by the next call.
+    [[nodiscard]] std::expected<void, parse_error> try_parse(const std::string_view command_line)
+    {
+        if (!_tokenizer._split(command_line)) [[unlikely]]
+            return std::unexpected(ShellTokenizer::_make_error(command_line));
+
+        const auto& args = _tokenizer._tokens;
+        auto error = _parse(static_cast<int>(args.size()), args.data());
+        [[maybe_unused]] const auto report = _report_parse();
+        if (error.code != parse_errc{}) [[unlikely]]
+            return std::unexpected(std::move(error));
+        return {};
+    }
+
+    /// @brief Equivalent to CLIParser::parse_into(...), but reports failures through its return value instead of
+    /// throwing.
+    ///
+    /// @param[in] argc The number of arguments
+    /// @param[in] argv The argument list
+    /// @param[out] result The result to parse into, which is allocated upon first use then reused.
+    /// @return Nothing upon success, otherwise a parse_error describing the first failure encountered.
+    [[nodiscard]] std::expected<void, parse_error> try_parse_into(
+        const int argc,
+        const char* const* argv,
+        ParseResult& result) const
+    {
+        auto error = _parse_into(argc, argv, result);
+        [[maybe_unused]] const _parse_recorder::reporter report(result._scratch.recorder, _stats_sink);
+        if (error.code != parse_errc{}) [[unlikely]]
+            return std::unexpected(std::move(error));
+        return {};
+    }
+#endif // __cpp_lib_expected
 
 private:
-    _named_option_store _named_options;
-    _positional_options_store _positional_options;
+    // Note: declared first, as every other member is allocated from it.
+    std::pmr::memory_resource* _resource;
+
+    _named_option_store _named_options{_resource};
+    _positional_options_store _positional_options{_resource};
+
+    // Indexed by _named_id::index() of each key-value option.
+    _dynamic_bitset _required_key_values{_resource};
+
+    // Written by CLIParser::parse(...), whereas CLIParser::parse_into(...) uses that of its result.
+    _parse_scratch _scratch{_resource};
+    // Note: shared with every ParseResult parsed into, which may outlive this instance.
+    std::shared_ptr<_result_layout> _layout =
+        std::allocate_shared<_result_layout>(std::pmr::polymorphic_allocator<>(_resource), _resource);
+
+    bool _expand_response_files = false;
+    bool _match_prefixes = false;
+
+    _string_map<_env_binding> _env_bindings{_resource};
+
+    // Splits the command-line given to CLIParser::parse(std::string_view).
+    ShellTokenizer _tokenizer{_resource};
+
+    std::pmr::string _config_path{_resource};
+    // Each alias, stripped of its leading dashes, mapped to the id of its option.
+    std::pmr::unordered_map<std::string_view, _named_id> _config_keys{_resource};
+
+    std::pmr::vector<_subcommand> _subcommands{_resource};
+    _string_map<std::size_t> _subcommand_ids{_resource};
+    std::size_t _selected_subcommand = _NO_SUBCOMMAND;
+    bool _completion_requested = false;
 
-    std::vector<_named_id> _required_options;
+    std::pmr::string _help_message{_resource};
+    bool _help_rendered = false;
+    help_sink _help_sink{_write_stdout, nullptr};
+    // Note: only ever invoked if LWCLI_INSTRUMENTATION is defined.
+    parse_stats_sink _stats_sink{nullptr, nullptr};
 };
 
 } // namespace lwcli
@@ -0,0 +1,130 @@
+#ifndef LWCLI_INCLUDE_LWCLI_SHELL_TOKENIZER_HPP
+#define LWCLI_INCLUDE_LWCLI_SHELL_TOKENIZER_HPP
+
+#include <cstddef>         // For access to size_t
+#include <memory_resource> // For access to std::pmr::memory_resource, std::pmr::get_default_resource
+#include <span>            // For access to std::span
+#include <string>          // For access to std::string, std::pmr::string
+#include <string_view>     // For access to std::string_view
+#include <vector>          // For access to std::pmr::vector
+#include <version>         // For access to __cpp_lib_expected
+
+#ifdef __cpp_lib_expected
+    #include <expected> // For access to std::expected, std::unexpected
+#endif
+
+#include "LWCLI/_scan.hpp"
+#include "LWCLI/_tokenizer.hpp"
+#include "LWCLI/exceptions.hpp"
+
+namespace lwcli
+{
+
+/// @brief Splits command-lines into arguments, following POSIX shell quoting rules:
+///  - '...' preserves its contents literally.
+///  - "..." preserves its contents, except for backslashes preceding one of: \\ " $ ` or a newline.
+///  - Outside of quotes, a backslash preserves the next character literally.
+///  - A backslash followed by a newline (Outside single quotes) is removed entirely, as a line continuation.
+///
+/// No other shell syntax (e.g. variables, globs or redirections) is interpreted.
+///
+/// Arguments free of quotes and escapes view the command-line itself, and are found a block of characters at a time
+/// (Using SIMD instructions where available). Only the remaining arguments are unescaped, into storage owned by the
+/// tokenizer and reused by each split. Hence, once large enough, splitting does not allocate.
+class ShellTokenizer
+{
+public:
+    /// @param[in] resource The memory resource from which the arguments (And any unescaped argument) are allocated,
+    /// which must outlive this instance.
+    explicit ShellTokenizer(std::pmr::memory_resource* const resource = std::pmr::get_default_resource()) noexcept:
+        _tokens(resource),
+        _unescaped(resource)
+    {}
+
+    /// @brief Splits command_line into its arguments.
+    ///
+    /// @throws bad_command_line if command_line contains an unterminated quote.
+    ///
+    /// @param[in] command_line The command-line to split, which must outlive the arguments.
+    /// @return The arguments, valid until the next split (Or the destruction of this instance).
+    [[nodiscard]] std::span<const std::string_view> split(const std::string_view command_line)
+    {
+        if (!_split(command_line)) [[unlikely]]
+            throw bad_command_line(std::string(command_line), _UNTERMINATED_QUOTE);
+        return _tokens;
+    }
+
+#ifdef __cpp_lib_expected
+    /// @brief Equivalent to ShellTokenizer::split(...), but reports failures through its return value instead of
+    /// throwing.
+    ///
+    /// @param[in] command_line The command-line to split, which must outlive the arguments.
+    /// @return The arguments upon success, otherwise a parse_error (Of code parse_errc::command_line) describing the
+    /// failure.
+    [[nodiscard]] std::expected<std::span<const std::string_view>, parse_error> try_split(
+        const std::string_view command_line)
+    {
+        if (!_split(command_line)) [[unlikely]]
+            return std::unexpected(_make_error(command_line));
+        return _tokens;
+    }
+#endif // __cpp_lib_expected
+
+private:
+    friend class CLIParser;
+    friend class BatchParser;
+
+    static constexpr const char* _UNTERMINATED_QUOTE = "contains an unterminated quote";
+
+    [[nodiscard]] static parse_error _make_error(const std::string_view command_line) noexcept
+    {
+        parse_error error;
+        error.code = parse_errc::command_line;
+        error.argument = command_line;
+        error.reason = _UNTERMINATED_QUOTE;
+        return error;
+    }
+
+    // Splits command_line into _tokens, returning false if it contains an unterminated quote.
+    [[nodiscard]] bool _split(const std::string_view command_line)
+    {
+        _tokens.clear();
+        _unescaped.clear();
+        // Note: unescaping never lengthens a token, so no unescaped token is ever moved by the growth of _unescaped.
+        _unescaped.reserve(command_line.size());
+
+        const char* read = command_line.data();
+        const char* const end = read + command_line.size();
+        while (true) {
+            while (read != end && _is_shell_space(*read))
+                ++read;
+
+            if (read == end)
+                return true;
+
+            const char* const begin = read;
+            read += _find_shell_special(std::string_view(read, static_cast<std::size_t>(end - read)));
+            if (read == end || _is_shell_space(*read)) {
+                _tokens.emplace_back(begin, static_cast<std::size_t>(read - begin));
+                continue;
+            }
+
+            const std::size_t offset = _unescaped.size();
+            _unescaped.append(begin, read);
+            const auto status = _scan_shell_token(read, end, [this](const char* const first, const char* const last) {
+                _unescaped.append(first, last);
+            });
+            if (status != _token_status::TOKEN) [[unlikely]]
+                return false;
+
+            _tokens.emplace_back(_unescaped.data() + offset, _unescaped.size() - offset);
+        }
+    }
+
+    std::pmr::vector<std::string_view> _tokens;
+    std::pmr::string _unescaped;
+};
+
+} // namespace lwcli
+
+#endif // LWCLI_INCLUDE_LWCLI_SHELL_TOKENIZER_HPP
@@ -0,0 +1,746 @@
+#ifndef LWCLI_INCLUDE_LWCLI_STATIC_PARSER_HPP
+#define LWCLI_INCLUDE_LWCLI_STATIC_PARSER_HPP
+
+#include <algorithm>    // For access to std::ranges::copy, std::ranges::find, std::ranges::find_if_not
+#include <array>        // For access to std::array
+#include <bitset>       // For access to std::bitset
+#include <cstdint>      // For access to size_t, uint32_t
+#include <string>       // For access to std::string
+#include <string_view>  // For access to std::string_view
+#include <system_error> // For access to std::errc
+#include <tuple>        // For access to std::tuple, std::get, std::tuple_size_v
+#include <type_traits>  // For access to std::is_same_v, std::is_integral_v, std::integral_constant
+#include <typeinfo>     // For access to typeid
+#include <utility>      // For access to std::exchange, std::index_sequence, std::make_index_sequence, std::move
+#include <vector>       // For access to std::vector
+#include <version>      // For access to __cpp_lib_expected
+
+#ifdef __cpp_lib_expected
+    #include <expected> // For access to std::expected
+#endif
+
+#include "LWCLI/_options_stores.hpp"
+#include "LWCLI/_output.hpp"
+#include "LWCLI/_perfect_hash.hpp"
+#include "LWCLI/cast.hpp"
+#include "LWCLI/exceptions.hpp"
+#include "LWCLI/parser.hpp"
+#include "LWCLI/type_utility.hpp"
+#include "LWCLI/unreachable.hpp"
+
+namespace lwcli
+{
+
+/// @brief A flag option of a StaticSchema, counting its occurrences in a field of \p Result (Or, if the field is a
+/// bool, setting it). See make_static_flag(...).
+template<class Result, class Field, std::size_t N_ALIASES>
+struct StaticFlag
+{
+    using result_t = Result;
+    using field_t = Field;
+
+    Field Result::*field;
+    std::array<std::string_view, N_ALIASES> aliases;
+    std::string_view description;
+};
+
+/// @brief A key-value option of a StaticSchema, converting its value into a field of \p Result. As with
+/// KeyValueOption, the option is required unless the field is a std::optional. See make_static_key_value(...).
+template<class Result, class Field, std::size_t N_ALIASES>
+struct StaticKeyValue
+{
+    using result_t = Result;
+    using field_t = Field;
+
+    Field Result::*field;
+    std::array<std::string_view, N_ALIASES> aliases;
+    std::string_view description;
+};
+
+/// @brief A positional option of a StaticSchema, converting its value into a field of \p Result. Positional options
+/// are filled in the order declared. See make_static_positional(...).
+template<class Result, class Field>
+struct StaticPositional
+{
+    using result_t = Result;
+    using field_t = Field;
+
+    Field Result::*field;
+    std::string_view name;
+    std::string_view description;
+};
+
+/// @brief Declares a flag option of a StaticSchema.
+///
+/// @param field The (Integral or bool) field of the result counting the occurrences of the flag.
+/// @param aliases The aliases of the flag, e.g. {"-v", "--verbose"}.
+/// @param description The description of the flag, listed by the help message.
+template<class Result, class Field, std::size_t N_ALIASES>
+[[nodiscard]] constexpr StaticFlag<Result, Field, N_ALIASES> make_static_flag(
+    Field Result::*const field,
+    const std::string_view (&aliases)[N_ALIASES], // NOLINT(cppcoreguidelines-avoid-c-arrays)
+    const std::string_view description = {})
+{
+    static_assert(std::is_integral_v<Field>, "Flags must count their occurrences in an integral (Or bool) field.");
+
+    return {field, std::to_array(aliases), description};
+}
+
+/// @brief Declares a key-value option of a StaticSchema.
+///
+/// @param field The field of the result the value is converted into, by cast<Field> (Or cast<Type> for a
+/// std::optional<Type>).
+/// @param aliases The aliases of the option, e.g. {"-j", "--threads"}.
+/// @param description The description of the option, listed by the help message.
+template<class Result, class Field, std::size_t N_ALIASES>
+[[nodiscard]] constexpr StaticKeyValue<Result, Field, N_ALIASES> make_static_key_value(
+    Field Result::*const field,
+    const std::string_view (&aliases)[N_ALIASES], // NOLINT(cppcoreguidelines-avoid-c-arrays)
+    const std::string_view description)
+{
+    return {field, std::to_array(aliases), description};
+}
+
+/// @brief Declares a positional option of a StaticSchema.
+///
+/// @param field The field of the result the value is converted into.
+/// @param name The name of the option, listed by the help message.
+/// @param description The description of the option, listed by the help message.
+template<class Result, class Field>
+[[nodiscard]] constexpr StaticPositional<Result, Field> make_static_positional(
+    Field Result::*const field,
+    const std::string_view name,
+    const std::string_view description = {})
+{
+    return {field, name, description};
+}
+
+template<class Option>
+inline constexpr bool _is_static_flag_v = false;
+
+template<class Result, class Field, std::size_t N_ALIASES>
+inline constexpr bool _is_static_flag_v<StaticFlag<Result, Field, N_ALIASES>> = true;
+
+template<class Option>
+inline constexpr bool _is_static_key_value_v = false;
+
+template<class Result, class Field, std::size_t N_ALIASES>
+inline constexpr bool _is_static_key_value_v<StaticKeyValue<Result, Field, N_ALIASES>> = true;
+
+template<class Option>
+inline constexpr bool _is_static_positional_v = false;
+
+template<class Result, class Field>
+inline constexpr bool _is_static_positional_v<StaticPositional<Result, Field>> = true;
+
+[[nodiscard]] constexpr bool _is_reserved_alias(const std::string_view alias) noexcept
+{
+    return alias == "-h" || alias == "--help";
+}
+
+// The ways in which options may fail to form a valid schema. Each mirrors an assertion raised whilst registering the
+// same options with a CLIParser.
+enum class _schema_defect : std::uint8_t {
+    none,
+    unnamed_positional,
+    // To keep with CLI best practices, key-value options must always have a description.
+    undescribed_key_value,
+    no_aliases,
+    unprefixed_alias,
+    empty_alias,
+    alias_with_spaces,
+    duplicate_alias,
+};
+
+// Returns a defect of options (Any will do), or _schema_defect::none if they form a valid schema. Note: as with a
+// CLIParser, reserved aliases (i.e. '-h' and '--help') are allowed, yet never matched.
+template<class... Options>
+[[nodiscard]] constexpr _schema_defect _validate_static_schema(const Options&... options)
+{
+    std::vector<std::string_view> aliases;
+    _schema_defect defect = _schema_defect::none;
+
+    const auto validate = [&]<class Option>(const Option& option) {
+        if constexpr (_is_static_positional_v<Option>) {
+            if (option.name.empty())
+                defect = _schema_defect::unnamed_positional;
+        }
+        else {
+            if (_is_static_key_value_v<Option> && option.description.empty())
+                defect = _schema_defect::undescribed_key_value;
+            if (option.aliases.empty())
+                defect = _schema_defect::no_aliases;
+
+            for (const std::string_view alias : option.aliases) {
+#ifndef LWCLI_DO_NOT_ENFORCE_PREFIXES
+                if (!alias.starts_with("-"))
+                    defect = _schema_defect::unprefixed_alias;
+#endif // LWCLI_DO_NOT_ENFORCE_PREFIXES
+                if (alias.empty())
+                    defect = _schema_defect::empty_alias;
+                if (alias.find(' ') != std::string_view::npos)
+                    defect = _schema_defect::alias_with_spaces;
+                if (std::ranges::find(aliases, alias) != aliases.end())
+                    defect = _schema_defect::duplicate_alias;
+                aliases.push_back(alias);
+            }
+        }
+    };
+
+    (validate(options), ...);
+    return defect;
+}
+
+// Deliberately not constexpr: calling it fails the constant evaluation of make_static_schema(...), such that an invalid
+// schema does not compile, the diagnostic naming the defect (As the template argument of this function).
+template<_schema_defect Defect>
+void _invalid_static_schema() noexcept
+{}
+
+/// @brief The options of a StaticParser, each writing to a field of \p Result. See make_static_schema(...).
+template<class Result, class... Options>
+struct StaticSchema
+{
+    using result_t = Result;
+
+    std::tuple<Options...> options;
+};
+
+/// @brief Declares the options of a StaticParser, validating them at compile-time: an invalid schema (e.g. with a
+/// duplicate alias) does not compile, whereas a CLIParser would assert at runtime.
+///
+/// @tparam Result The type to which every option is written, typically an aggregate with a field per option.
+/// @param options The options of the schema, see make_static_flag(...), make_static_key_value(...) and
+/// make_static_positional(...).
+template<class Result, class... Options>
+[[nodiscard]] consteval StaticSchema<Result, Options...> make_static_schema(const Options&... options)
+{
+    static_assert(
+        (std::is_same_v<typename Options::result_t, Result> && ...),
+        "Every option must write to a field of the result type.");
+
+    switch (_validate_static_schema(options...)) {
+    case _schema_defect::none:
+        break;
+    case _schema_defect::unnamed_positional:
+        _invalid_static_schema<_schema_defect::unnamed_positional>();
+        break;
+    case _schema_defect::undescribed_key_value:
+        _invalid_static_schema<_schema_defect::undescribed_key_value>();
+        break;
+    case _schema_defect::no_aliases:
+        _invalid_static_schema<_schema_defect::no_aliases>();
+        break;
+    case _schema_defect::unprefixed_alias:
+        _invalid_static_schema<_schema_defect::unprefixed_alias>();
+        break;
+    case _schema_defect::empty_alias:
+        _invalid_static_schema<_schema_defect::empty_alias>();
+        break;
+    case _schema_defect::alias_with_spaces:
+        _invalid_static_schema<_schema_defect::alias_with_spaces>();
+        break;
+    case _schema_defect::duplicate_alias:
+        _invalid_static_schema<_schema_defect::duplicate_alias>();
+        break;
+    }
+    return {std::tuple<Options...>(options...)};
+}
+
+/// @brief A parser generated at compile-time from a StaticSchema, writing the values of its options straight into the
+/// fields of a result.
+///
+/// Where a CLIParser registers (And type-erases) its options at runtime, everything here is known to the compiler: the
+/// aliases are looked up through a perfect hash built at compile-time, from which each option is dispatched to code
+/// specialised to it, where cast<> may be inlined alongside the write to its field. The help message is likewise built
+/// at compile-time, and nothing is allocated (Nor registered) upon construction.
+///
+/// Arguments are parsed as by CLIParser::parse(...), with the exception of response files, configuration files,
+/// environment variables, subcommands, and clusters of short options, none of which are supported. Long options may
+/// give their values inline (e.g. '--threads=8').
+///
+/// @tparam Schema A reference to the schema (A constexpr variable of static storage duration), e.g.
+/// @code
+/// struct Settings { unsigned verbose = 0; int threads = 1; std::string input; };
+///
+/// constexpr auto schema = lwcli::make_static_schema<Settings>(
+///     lwcli::make_static_flag(&Settings::verbose, {"-v", "--verbose"}, "Increases verbosity."),
+///     lwcli::make_static_key_value(&Settings::threads, {"-j", "--threads"}, "Number of threads."),
+///     lwcli::make_static_positional(&Settings::input, "input", "Input file."));
+///
+/// lwcli::StaticParser<schema> parser;
+/// @endcode
+template<const auto& Schema>
+class StaticParser
+{
+public:
+    using schema_t = std::remove_cvref_t<decltype(Schema)>;
+    using result_t = schema_t::result_t;
+
+private:
+    using _options_t = decltype(schema_t::options);
+
+    static constexpr std::size_t N_OPTIONS = std::tuple_size_v<_options_t>;
+    // Pseudo option indices, for '-h' and '--help', and for the lack of any option.
+    static constexpr std::uint32_t _HELP = N_OPTIONS;
+    static constexpr std::uint32_t _NO_OPTION = N_OPTIONS + 1;
+
+    template<std::size_t Index>
+    using _option_t = std::tuple_element_t<Index, _options_t>;
+
+    // Invokes visitor with the index (As a std::integral_constant) of each option in turn.
+    template<class Visitor>
+    static constexpr void _for_each_option(Visitor&& visitor)
+    {
+        [&]<std::size_t... Indices>(std::index_sequence<Indices...>) {
+            (visitor(std::integral_constant<std::size_t, Indices>{}), ...);
+        }(std::make_index_sequence<N_OPTIONS>{});
+    }
+
+    // Invokes visitor with the index (As a std::integral_constant) of the option at index. Note: the comparisons are
+    // folded into a switch over index, each case of which is specialised to its option.
+    template<class Visitor>
+    static constexpr void _visit(const std::size_t index, Visitor&& visitor)
+    {
+        [&]<std::size_t... Indices>(std::index_sequence<Indices...>) {
+            static_cast<void>(
+                ((index == Indices && (visitor(std::integral_constant<std::size_t, Indices>{}), true)) || ...));
+        }(std::make_index_sequence<N_OPTIONS>{});
+    }
+
+    static constexpr std::size_t N_ALIASES = [] {
+        std::size_t n_aliases = 2;
+        _for_each_option([&](const auto index) {
+            if constexpr (!_is_static_positional_v<_option_t<index>>) {
+                for (const std::string_view alias : std::get<index>(Schema.options).aliases)
+                    n_aliases += _is_reserved_alias(alias) ? 0 : 1;
+            }
+        });
+        return n_aliases;
+    }();
+
+    static constexpr std::size_t N_POSITIONALS = [] {
+        std::size_t n_positionals = 0;
+        _for_each_option([&](const auto index) {
+            if constexpr (_is_static_positional_v<_option_t<index>>)
+                ++n_positionals;
+        });
+        return n_positionals;
+    }();
+
+    // Every alias, along with the index of the option it names.
+    struct _alias_table
+    {
+        std::array<std::string_view, N_ALIASES> aliases;
+        std::array<std::uint32_t, N_ALIASES> options;
+    };
+
+    static constexpr _alias_table _ALIASES = [] {
+        _alias_table table{{"-h", "--help"}, {_HELP, _HELP}};
+        std::size_t n_aliases = 2;
+        _for_each_option([&](const auto index) {
+            if constexpr (!_is_static_positional_v<_option_t<index>>) {
+                for (const std::string_view alias : std::get<index>(Schema.options).aliases) {
+                    if (_is_reserved_alias(alias))
+                        continue;
+                    table.aliases[n_aliases] = alias;
+                    table.options[n_aliases++] = static_cast<std::uint32_t>(index);
+                }
+            }
+        });
+        return table;
+    }();
+
+    static constexpr _static_perfect_hash<N_ALIASES> _ALIAS_HASH{_ALIASES.aliases};
+
+    // The index of each positional option, in the order filled.
+    static constexpr std::array<std::uint32_t, N_POSITIONALS> _POSITIONALS = [] {
+        std::array<std::uint32_t, N_POSITIONALS> positionals{};
+        std::size_t n_positionals = 0;
+        _for_each_option([&](const auto index) {
+            if constexpr (_is_static_positional_v<_option_t<index>>)
+                positionals[n_positionals++] = static_cast<std::uint32_t>(index);
+        });
+        return positionals;
+    }();
+
+    // As would be rendered by CLIParser::help_message() for the same options.
+    [[nodiscard]] static constexpr std::string _render_help_message()
+    {
+        std::string message;
+        _for_each_option([&](const auto index) {
+            const auto& option = std::get<index>(Schema.options);
+            if constexpr (_is_static_positional_v<_option_t<index>>)
+                _append_option_description(message, option.name, option.description);
+        });
+
+        _for_each_option([&](const auto index) {
+            const auto& option = std::get<index>(Schema.options);
+            if constexpr (!_is_static_positional_v<_option_t<index>>) {
+                std::string alias_list;
+                for (const std::string_view alias : option.aliases) {
+                    // Note: reserved aliases are never matched by the option, so are not listed.
+                    if (_is_reserved_alias(alias))
+                        continue;
+                    if (!alias_list.empty())
+                        alias_list += " | ";
+                    alias_list += alias;
+                }
+                // Note: an option defining only reserved aliases can never be given, so is not described.
+                if (!alias_list.empty())
+                    _append_option_description(message, alias_list, option.description);
+            }
+        });
+        return message;
+    }
+
+    static constexpr std::size_t HELP_MESSAGE_LENGTH = _render_help_message().size();
+
+    static constexpr std::array<char, HELP_MESSAGE_LENGTH> _HELP_MESSAGE = [] {
+        std::array<char, HELP_MESSAGE_LENGTH> message{};
+        std::ranges::copy(_render_help_message(), message.begin());
+        return message;
+    }();
+
+    // State carried from one argument to the next, throughout a single parse.
+    struct _parse_state
+    {
+        result_t& result;
+
+        // Indexed by option, set for each key-value option given.
+        std::bitset<N_OPTIONS> visited{};
+        std::size_t position = 0;
+        bool help_requested = false;
+
+        // The key-value option awaiting a value (If any), along with the key (and its index) which named it.
+        std::uint32_t pending = _NO_OPTION;
+        std::string_view pending_key{};
+        int pending_index = 0;
+    };
+
+public:
+    /// @brief Redirects the help message to sink, rather than the standard output.
+    ///
+    /// @param[in] sink The destination of the help message.
+    /// @return This instance of StaticParser.
+    constexpr StaticParser& redirect_help(const help_sink sink) noexcept
+    {
+        _help_sink = sink;
+        return *this;
+    }
+
+    /// @return The help message, which is built at compile-time.
+    [[nodiscard]] static constexpr std::string_view help_message() noexcept
+    {
+        return {_HELP_MESSAGE.data(), _HELP_MESSAGE.size()};
+    }
+
+    /// @brief Parses the command-line arguments into result, as by CLIParser::parse(...).
+    ///
+    /// Fields of options not given are left untouched, hence result may carry their defaults. Should help be requested
+    /// (Or argv be empty), the help message is written to the help sink, and only the options preceding the request
+    /// will have been parsed.
+    ///
+    /// @throws bad_parse (Or rather, one of its subclasses) if the command-line arguments could not be parsed.
+    ///
+    /// @param[in] argc The number of arguments
+    /// @param[in] argv The argument list
+    /// @param[out] result The result to which the options are written.
+    /// @return Whether help was requested.
+    [[nodiscard]] bool parse(const int argc, const char* const* argv, result_t& result) const
+    {
+        _parse_state state{result};
+        if (const auto error = _parse(argc, argv, state); error.code != parse_errc{}) [[unlikely]]
+            _throw_parse_error(error);
+        return state.help_requested;
+    }
+
+#ifdef __cpp_lib_expected
+    /// @brief Equivalent to StaticParser::parse(...), but reports failures through its return value instead of
+    /// throwing.
+    ///
+    /// @param[in] argc The number of arguments
+    /// @param[in] argv The argument list
+    /// @param[out] result The result to which the options are written.
+    /// @return Whether help was requested upon success, otherwise a parse_error describing the first failure
+    /// encountered.
+    [[nodiscard]] std::expected<bool, parse_error> try_parse(
+        const int argc,
+        const char* const* argv,
+        result_t& result) const
+    {
+        _parse_state state{result};
+        if (auto error = _parse(argc, argv, state); error.code != parse_errc{}) [[unlikely]]
+            return std::unexpected(std::move(error));
+        return state.help_requested;
+    }
+#endif // __cpp_lib_expected
+
+private:
+    [[nodiscard]] static parse_error _make_error(
+        const parse_errc code,
+        const int index,
+        const std::string_view argument) noexcept
+    {
+        parse_error error;
+        error.code = code;
+        error.index = index;
+        error.argument = argument;
+        return error;
+    }
+
+    template<std::size_t Index>
+    [[nodiscard]] static const char* _type_name_of() noexcept
+    {
+        return typeid(unwrapped_t<typename _option_t<Index>::field_t>).name();
+    }
+
+    [[nodiscard]] static const char* _type_name_of(const std::size_t option) noexcept
+    {
+        const char* type_name = nullptr;
+        _visit(option, [&](const auto index) { type_name = _type_name_of<index>(); });
+        return type_name;
+    }
+
+    // Returns false if value could not be converted to the type of the (Key-value or positional) option at Index.
+    template<std::size_t Index>
+    [[nodiscard]] static bool _convert(const std::string_view value, result_t& result)
+    {
+        using option_t = _option_t<Index>;
+        static_assert(!_is_static_flag_v<option_t>);
+        auto& field = result.*std::get<Index>(Schema.options).field;
+        return _on_invoke_valued_option<typename option_t::field_t>(value, &field);
+    }
+
+    // As _convert<Index>(...), for the option at a runtime index.
+    [[nodiscard]] static bool _convert(const std::size_t option, const std::string_view value, result_t& result)
+    {
+        bool converted = false;
+        _visit(option, [&](const auto index) {
+            if constexpr (!_is_static_flag_v<_option_t<index>>)
+                converted = _convert<index>(value, result);
+        });
+        return converted;
+    }
+
+    template<std::size_t Index>
+    static void _invoke_flag(result_t& result) noexcept
+    {
+        using option_t = _option_t<Index>;
+        static_assert(_is_static_flag_v<option_t>);
+        auto& field = result.*std::get<Index>(Schema.options).field;
+        if constexpr (std::is_same_v<typename option_t::field_t, bool>)
+            field = true;
+        else
+            ++field;
+    }
+
+    [[nodiscard]] static std::uint32_t _option_of(const std::string_view alias) noexcept
+    {
+        const std::uint32_t entry = _ALIAS_HASH.find(alias, _ALIASES.aliases);
+        return entry != decltype(_ALIAS_HASH)::NO_KEY ? _ALIASES.options[entry] : _NO_OPTION;
+    }
+
+    // Parses the named option, given as key (Its value, if any, following as the next argument).
+    static void _parse_named(
+        _parse_state& state,
+        const std::uint32_t option,
+        const std::string_view key,
+        const int index) noexcept
+    {
+        if (option == _HELP) {
+            state.help_requested = true;
+            return;
+        }
+
+        _visit(option, [&](const auto option_index) {
+            if constexpr (_is_static_flag_v<_option_t<option_index>>)
+                _invoke_flag<option_index>(state.result);
+            else {
+                state.visited.set(option_index);
+                state.pending = static_cast<std::uint32_t>(option_index);
+                state.pending_key = key;
+                state.pending_index = index;
+            }
+        });
+    }
+
+    // Applies the value given inline (e.g. '--threads=8') to the named option, flags taking a boolean value.
+    [[nodiscard]] static parse_error _parse_named_value(
+        _parse_state& state,
+        const std::uint32_t option,
+        const std::string_view key,
+        const std::string_view value,
+        const int index)
+    {
+        const auto make_error = [&](const char* const type_name) {
+            auto error = _make_error(parse_errc::value_conversion, index, key);
+            error.value = value;
+            error.type_name = type_name;
+            return error;
+        };
+
+        parse_error error;
+        _visit(option, [&](const auto option_index) {
+            if constexpr (_is_static_flag_v<_option_t<option_index>>) {
+                bool enabled = false;
+                if (cast<bool>::try_from_string(value, enabled) != std::errc{}) [[unlikely]]
+                    error = make_error(typeid(bool).name());
+                else if (enabled)
+                    _invoke_flag<option_index>(state.result);
+            }
+            else {
+                state.visited.set(option_index);
+                if (!_convert<option_index>(value, state.result)) [[unlikely]]
+                    error = make_error(_type_name_of<option_index>());
+            }
+        });
+        return error;
+    }
+
+    // Parses a single argument, originating from argv[index].
+    [[nodiscard]] static parse_error _parse_argument(_parse_state& state, const std::string_view arg, const int index)
+    {
+        // Value of a key-value option
+        if (state.pending != _NO_OPTION) {
+            const auto option = std::exchange(state.pending, _NO_OPTION);
+            if (!_convert(option, arg, state.result)) [[unlikely]] {
+                auto error = _make_error(parse_errc::value_conversion, state.pending_index, state.pending_key);
+                error.value = arg;
+                error.type_name = _type_name_of(option);
+                return error;
+            }
+            return {};
+        }
+
+        // Named option
+        if (const std::uint32_t option = _option_of(arg); option != _NO_OPTION) {
+            _parse_named(state, option, arg, index);
+            return {};
+        }
+
+        // Long option with an inline value (e.g. '--threads=8')
+        if (arg.size() > 2 && arg.starts_with("--")) [[unlikely]] {
+            if (const std::size_t separator = arg.find('=', 2); separator != std::string_view::npos) {
+                const std::string_view key = arg.substr(0, separator);
+                if (const std::uint32_t option = _option_of(key); option != _NO_OPTION) {
+                    if (option == _HELP) {
+                        state.help_requested = true;
+                        return {};
+                    }
+                    return _parse_named_value(state, option, key, arg.substr(separator + 1), index);
+                }
+            }
+        }
+
+        // Positional option
+        if (state.position == N_POSITIONALS) [[unlikely]] {
+            auto error = _make_error(parse_errc::positional_count, index, arg);
+            error.n_max_positional = N_POSITIONALS;
+            return error;
+        }
+
+        const std::uint32_t option = _POSITIONALS[state.position];
+        if (!_convert(option, arg, state.result)) [[unlikely]] {
+            auto error = _make_error(parse_errc::positional_conversion, index, arg);
+            error.value = arg;
+            error.type_name = _type_name_of(option);
+            return error;
+        }
+        ++state.position;
+        return {};
+    }
+
+    // Whether any of argv[first, argc) requests help.
+    [[nodiscard]] static bool _requests_help(const int first, const int argc, const char* const* argv) noexcept
+    {
+        for (int i = first; i < argc; ++i) {
+            if (_option_of(argv[i]) == _HELP)
+                return true;
+        }
+        return false;
+    }
+
+    // Parses argv in a single pass without throwing, as does CLIParser::_parse_arguments(...), then prints the help
+    // message if requested.
+    [[nodiscard]] parse_error _parse(const int argc, const char* const* argv, _parse_state& state) const
+    {
+        for (int i = 1; i < argc; ++i) {
+            if (const auto error = _parse_argument(state, argv[i], i); error.code != parse_errc{}) [[unlikely]] {
+                // Note: only the remaining arguments need be searched, any preceding request would have been found.
+                state.help_requested = state.help_requested || _requests_help(i + 1, argc, argv);
+                if (!state.help_requested)
+                    return error;
+            }
+
+            if (state.help_requested) [[unlikely]]
+                break;
+        }
+
+        if (argc == 1 || state.help_requested) {
+            state.help_requested = true;
+            _help_sink.write(_help_sink.context, help_message());
+            return {};
+        }
+
+        if (state.pending != _NO_OPTION) [[unlikely]]
+            return _make_error(parse_errc::key_value_format, state.pending_index, state.pending_key);
+
+        // Note: names the first (In declaration order) missing option, all of which are listed by the error.
+        parse_error error;
+        _for_each_option([&](const auto index) {
+            using option_t = _option_t<index>;
+            if constexpr (_is_static_key_value_v<option_t> && !is_optional_v<typename option_t::field_t>) {
+                if (state.visited.test(index)) [[likely]]
+                    return;
+
+                // Note: reserved aliases are never matched by the option, so are neither named nor listed (Unless the
+                // option defines no other).
+                const auto& aliases = std::get<index>(Schema.options).aliases;
+                const auto named = std::ranges::find_if_not(aliases, _is_reserved_alias);
+                if (error.code == parse_errc{}) {
+                    const std::string_view argument = named != aliases.end() ? *named : aliases[0];
+                    error = _make_error(parse_errc::required_options, argc, argument);
+                }
+
+                std::string& alias_list = error.missing_options.emplace_back();
+                for (const std::string_view alias : aliases) {
+                    if (_is_reserved_alias(alias) && named != aliases.end())
+                        continue;
+                    alias_list.append(alias_list.empty() ? "" : " | ").append(alias);
+                }
+            }
+        });
+        return error;
+    }
+
+    [[noreturn]] static void _throw_parse_error(const parse_error& error)
+    {
+        const auto argument = std::string(error.argument);
+        switch (error.code) {
+        case parse_errc::positional_count:
+            throw bad_positional_count(argument, error.n_max_positional);
+        case parse_errc::positional_conversion:
+            throw bad_positional_conversion(argument, error.type_name);
+        case parse_errc::value_conversion:
+            throw bad_value_conversion(argument, std::string(error.value), error.type_name);
+        case parse_errc::key_value_format:
+            throw bad_key_value_format(argument);
+        case parse_errc::required_options:
+            throw bad_required_options(error.missing_options);
+        // Note: raised by features a StaticParser lacks.
+        case parse_errc::response_file:
+        case parse_errc::config_file:
+        case parse_errc::command_line:
+        case parse_errc::ambiguous_prefix:
+            break;
+        }
+        _unreachable();
+    }
+
+    help_sink _help_sink{_write_stdout, nullptr};
+};
+
+} // namespace lwcli
+
+#endif // LWCLI_INCLUDE_LWCLI_STATIC_PARSER_HPP
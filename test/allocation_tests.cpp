@@ -0,0 +1,260 @@
+// Note: must precede every LWCLI header, and be defined in only this translation unit. Replaces the global allocation
+// functions, which is the only portable way of observing every heap allocation made by the parser.
+#define LWCLI_INSTRUMENTATION_COUNT_ALLOCATIONS
+
+#include "gtest/gtest.h" // cppcheck-suppress [missingInclude]
+
+#include <array>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include "LWCLI/instrumentation.hpp"
+#include "LWCLI/options.hpp"
+#include "LWCLI/parser.hpp"
+
+// Note: only allocations made within a `count_allocations(...)` call are counted, so those made by GTest itself are not
+// recorded.
+namespace
+{
+template<class Callable>
+[[nodiscard]] std::size_t count_allocations(Callable&& callable)
+{
+    const std::size_t n_allocations = lwcli::_thread_allocations.n_allocations;
+    std::forward<Callable>(callable)();
+    return lwcli::_thread_allocations.n_allocations - n_allocations;
+}
+} // namespace
+
+TEST(AllocationTests, FlagsOnlyParseDoesNotAllocate)
+{
+    lwcli::FlagOption verbose;
+    verbose.aliases = {"-v", "--verbose"};
+    verbose.description = "Description for verbose";
+
+    lwcli::FlagOption quiet;
+    quiet.aliases = {"-q", "--quiet-mode-with-a-name-long-enough-to-defeat-small-string-optimisation"};
+    quiet.description = "Description for quiet";
+
+    lwcli::CLIParser parser;
+    parser.register_option(verbose);
+    parser.register_option(quiet);
+
+    constexpr auto argv = std::array{
+        "allocation_tests",
+        "-v",
+        "--verbose",
+        "--quiet-mode-with-a-name-long-enough-to-defeat-small-string-optimisation",
+        "-q",
+    };
+
+    const auto n_allocations =
+        count_allocations([&] { parser.parse(static_cast<int>(std::size(argv)), std::data(argv)); });
+
+    EXPECT_EQ(0, n_allocations);
+    EXPECT_EQ(2, verbose.count);
+    EXPECT_EQ(2, quiet.count);
+}
+
+TEST(AllocationTests, ClustersAndInlineValuesDoNotAllocate)
+{
+    lwcli::FlagOption verbose;
+    verbose.aliases = {"-v", "--verbose"};
+    verbose.description = "Description for verbose";
+
+    lwcli::KeyValueOption<int> threads;
+    threads.aliases = {"-j", "--threads-with-a-name-long-enough-to-defeat-small-string-optimisation"};
+    threads.description = "Description for threads";
+
+    lwcli::CLIParser parser;
+    parser.register_option(verbose);
+    parser.register_option(threads);
+
+    constexpr auto argv = std::array{
+        "allocation_tests",
+        "-vvv",
+        "-vj8",
+        "--threads-with-a-name-long-enough-to-defeat-small-string-optimisation=16",
+    };
+
+    const auto n_allocations =
+        count_allocations([&] { parser.parse(static_cast<int>(std::size(argv)), std::data(argv)); });
+
+    EXPECT_EQ(0, n_allocations);
+    EXPECT_EQ(4, verbose.count);
+    EXPECT_EQ(16, threads.value);
+}
+
+TEST(AllocationTests, AppendedValuesAllocateOnce)
+{
+    lwcli::AppendKeyValueOption<int> numbers;
+    numbers.aliases = {"-n", "--number"};
+    numbers.description = "Description for numbers";
+
+    lwcli::CLIParser parser;
+    parser.register_option(numbers);
+
+    constexpr auto argv = std::array{"allocation_tests", "-n", "1", "--number=2", "-n3", "-n", "4"};
+
+    // Note: the first parse allocates the deferred values of the parser, then the container, each once.
+    const auto n_first_allocations =
+        count_allocations([&] { parser.parse(static_cast<int>(std::size(argv)), std::data(argv)); });
+    const auto n_allocations =
+        count_allocations([&] { parser.parse(static_cast<int>(std::size(argv)), std::data(argv)); });
+
+    EXPECT_EQ(2, n_first_allocations);
+    EXPECT_EQ(0, n_allocations);
+    EXPECT_EQ((std::vector<int>{1, 2, 3, 4}), numbers.values);
+}
+
+TEST(AllocationTests, AliasLookupDoesNotAllocate)
+{
+    lwcli::FlagOption verbose;
+    verbose.aliases = {"--a-verbose-flag-with-a-name-long-enough-to-defeat-small-string-optimisation"};
+    verbose.description = "Description for verbose";
+
+    lwcli::_named_option_store store;
+    const lwcli::_named_id expected_id = store.register_flag(verbose);
+
+    lwcli::_named_id id;
+    const auto n_allocations = count_allocations([&] {
+        id = store.id_of("--a-verbose-flag-with-a-name-long-enough-to-defeat-small-string-optimisation");
+    });
+
+    EXPECT_EQ(0, n_allocations);
+    EXPECT_EQ(expected_id, id);
+}
+
+TEST(AllocationTests, PositionalSinkDoesNotAllocate)
+{
+    std::size_t sum = 0;
+    auto sink = lwcli::make_positional_sink<std::size_t>([&sum](const std::size_t value) { sum += value; });
+    sink.name = "values";
+    sink.description = "Description for values";
+
+    lwcli::CLIParser parser;
+    parser.register_option(sink);
+
+    constexpr std::size_t n_values = 10'000;
+    std::vector<std::string> values(n_values, "1");
+    std::vector<const char*> argv = {"allocation_tests"};
+    for (const auto& value : values)
+        argv.push_back(value.c_str());
+
+    const auto n_allocations =
+        count_allocations([&] { parser.parse(static_cast<int>(std::size(argv)), std::data(argv)); });
+
+    EXPECT_EQ(0, n_allocations);
+    EXPECT_EQ(n_values, sum);
+    EXPECT_EQ(n_values, sink.count);
+}
+
+TEST(AllocationTests, ConfigFileEntriesDoNotAllocate)
+{
+    lwcli::FlagOption verbose;
+    verbose.aliases = {"--verbose"};
+    verbose.description = "Description for verbose";
+
+    lwcli::KeyValueOption<int> threads;
+    threads.aliases = {"--threads"};
+    threads.description = "Description for threads";
+
+    const auto path = std::filesystem::temp_directory_path() / "lwcli_allocation_tests.ini";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "[section]\n";
+        for (int i = 0; i < 10'000; ++i)
+            file << "\n[]\nverbose = false\nthreads = " << i;
+    }
+
+    lwcli::CLIParser parser;
+    parser.register_options(verbose, threads).config_file(path.string());
+
+    // Note: the first parse grows the storage of mapped files.
+    constexpr auto argv = std::array{"allocation_tests", "--verbose"};
+    parser.parse(static_cast<int>(std::size(argv)), std::data(argv));
+
+    const auto n_allocations =
+        count_allocations([&] { parser.parse(static_cast<int>(std::size(argv)), std::data(argv)); });
+    std::filesystem::remove(path);
+
+    EXPECT_EQ(0, n_allocations);
+    EXPECT_EQ(2, verbose.count);
+    EXPECT_EQ(9'999, threads.value);
+}
+
+TEST(AllocationTests, ParseIntoReusedResultDoesNotAllocate)
+{
+    lwcli::FlagOption verbose;
+    verbose.aliases = {"-v"};
+    verbose.description = "Description for verbose";
+
+    lwcli::KeyValueOption<std::string> name;
+    name.aliases = {"--name"};
+    name.description = "Description for name";
+
+    lwcli::PositionalOption<int> value;
+    value.name = "value";
+    value.description = "Description for value";
+
+    lwcli::CLIParser parser;
+    parser.register_options(verbose, name, value).freeze();
+
+    // Note: the first parse allocates the result.
+    constexpr auto argv = std::array{"allocation_tests", "-v", "--name", "short", "4"};
+    lwcli::ParseResult result;
+    parser.parse_into(static_cast<int>(std::size(argv)), std::data(argv), result);
+
+    const auto n_allocations = count_allocations(
+        [&] { parser.parse_into(static_cast<int>(std::size(argv)), std::data(argv), result); });
+
+    EXPECT_EQ(0, n_allocations);
+    EXPECT_EQ(1, result[parser.handle_of(verbose)]);
+    EXPECT_EQ("short", result[parser.handle_of(name)]);
+    EXPECT_EQ(4, result[parser.handle_of(value)]);
+}
+
+TEST(AllocationTests, ArenaBackedParserDoesNotAllocate)
+{
+    lwcli::FlagOption verbose;
+    verbose.aliases = {"-v", "--verbose-flag-with-a-name-long-enough-to-defeat-small-string-optimisation"};
+    verbose.description = "Description for verbose";
+
+    lwcli::KeyValueOption<int> threads;
+    threads.aliases = {"-j", "--threads"};
+    threads.description = "Description for threads";
+
+    lwcli::PositionalOption<int> value;
+    value.name = "value";
+    value.description = "Description for value";
+
+    lwcli::FlagOption force;
+    force.aliases = {"-f"};
+    force.description = "Description for force";
+
+    // Note: anything not allocated from the arena is either counted, or throws std::bad_alloc once the buffer runs out.
+    alignas(std::max_align_t) static std::array<std::byte, 64 * 1024> buffer;
+    const auto n_allocations = count_allocations([&] {
+        std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+
+        lwcli::CLIParser parser(&arena);
+        parser.register_options(verbose, threads, value)
+            .register_subcommand("build", "Description for build", [&force](lwcli::CLIParser& build) {
+                build.register_option(force);
+            })
+            .freeze();
+
+        constexpr auto argv = std::array{"allocation_tests", "-v", "-j", "8", "4"};
+        parser.parse(static_cast<int>(std::size(argv)), std::data(argv));
+        parser.parse("allocation_tests build '-f'");
+    });
+
+    EXPECT_EQ(0, n_allocations);
+    EXPECT_EQ(1, verbose.count);
+    EXPECT_EQ(8, threads.value);
+    EXPECT_EQ(4, value.value);
+    EXPECT_EQ(1, force.count);
+}
@@ -0,0 +1,231 @@
+#include "gtest/gtest.h" // cppcheck-suppress [missingInclude]
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "LWCLI/exceptions.hpp"
+#include "LWCLI/options.hpp"
+#include "LWCLI/parse_result.hpp"
+#include "LWCLI/parser.hpp"
+
+namespace
+{
+// A container recording each call to reserve(...), and the number of values held at the time.
+struct reserve_recorder
+{
+    void clear() noexcept
+    {
+        values.clear();
+    }
+
+    void reserve(const std::size_t n_values)
+    {
+        reserves.push_back({n_values, values.size()});
+        values.reserve(n_values);
+    }
+
+    void push_back(const int value)
+    {
+        values.push_back(value);
+    }
+
+    std::vector<int> values;
+    std::vector<std::pair<std::size_t, std::size_t>> reserves;
+};
+} // namespace
+
+class AppendTests : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        _directory = std::filesystem::temp_directory_path()
+                     / ("lwcli_append_tests_" + std::to_string(reinterpret_cast<std::uintptr_t>(this)));
+        std::filesystem::create_directories(_directory);
+
+        verbose.aliases = {"-v", "--verbose"};
+        verbose.description = "Description for verbose";
+
+        inputs.aliases = {"-i", "--input"};
+        inputs.description = "Description for inputs";
+
+        numbers.aliases = {"-n", "--number"};
+        numbers.description = "Description for numbers";
+
+        parser.register_options(verbose, inputs, numbers);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(_directory);
+    }
+
+    void parse(const std::vector<const char*>& argv)
+    {
+        parser.parse(static_cast<int>(argv.size()), argv.data());
+    }
+
+    [[nodiscard]] std::string write_file(const std::string& name, const std::string& contents) const
+    {
+        const auto path = _directory / name;
+        std::ofstream(path, std::ios::binary) << contents;
+        return path.string();
+    }
+
+    lwcli::FlagOption verbose;
+    lwcli::AppendKeyValueOption<std::string> inputs;
+    lwcli::AppendKeyValueOption<int> numbers;
+    lwcli::CLIParser parser;
+
+private:
+    std::filesystem::path _directory;
+};
+
+TEST_F(AppendTests, AppendsEveryOccurrence)
+{
+    ASSERT_NO_THROW(parse({"append_tests", "--input", "a", "-n", "1", "--input=b", "-vic", "-i", "d", "-n2"}));
+
+    EXPECT_EQ((std::vector<std::string>{"a", "b", "c", "d"}), inputs.values);
+    EXPECT_EQ((std::vector<int>{1, 2}), numbers.values);
+    EXPECT_EQ(1, verbose.count);
+}
+
+TEST_F(AppendTests, ValuesReplaceThoseHeldBeforehand)
+{
+    inputs.values = {"default"};
+
+    ASSERT_NO_THROW(parse({"append_tests", "-v"}));
+    EXPECT_EQ((std::vector<std::string>{"default"}), inputs.values);
+
+    ASSERT_NO_THROW(parse({"append_tests", "-i", "a", "-i", "b"}));
+    EXPECT_EQ((std::vector<std::string>{"a", "b"}), inputs.values);
+
+    // Note: values accumulate within a parse, not across parses.
+    ASSERT_NO_THROW(parse({"append_tests", "-i", "c"}));
+    EXPECT_EQ((std::vector<std::string>{"c"}), inputs.values);
+}
+
+TEST_F(AppendTests, ReservesOnceForAllValues)
+{
+    lwcli::AppendKeyValueOption<int, reserve_recorder> ports;
+    ports.aliases = {"--port"};
+    ports.description = "Description for ports";
+    ports.values.push_back(80);
+    parser.register_option(ports);
+
+    ASSERT_NO_THROW(parse({"append_tests", "--port", "1", "-n", "5", "--port=2", "--port", "3"}));
+
+    EXPECT_EQ((std::vector<int>{1, 2, 3}), ports.values.values);
+    // Note: reserved once, for all three values, after the default was cleared.
+    EXPECT_EQ((std::vector<std::pair<std::size_t, std::size_t>>{{3, 0}}), ports.values.reserves);
+}
+
+TEST_F(AppendTests, ReservesOnceForValuesOfEverySource)
+{
+    lwcli::AppendKeyValueOption<int, reserve_recorder> ports;
+    ports.aliases = {"--port"};
+    ports.description = "Description for ports";
+    parser.register_option(ports).expand_response_files();
+
+    const std::string response_file = write_file("args.txt", "--port 2\n--port=3\n");
+    const std::string argument = "@" + response_file;
+    ASSERT_NO_THROW(parse({"append_tests", "--port", "1", argument.c_str(), "--port", "4"}));
+
+    EXPECT_EQ((std::vector<int>{1, 2, 3, 4}), ports.values.values);
+    // Note: the values of the response file exceed the bound given by argv, but are counted all the same.
+    EXPECT_EQ((std::vector<std::pair<std::size_t, std::size_t>>{{4, 0}}), ports.values.reserves);
+}
+
+TEST_F(AppendTests, ReportsConversionErrorsAtTheirArgument)
+{
+    try {
+        parse({"append_tests", "-n", "1", "--number", "two", "-n", "3"});
+        FAIL() << "Expected bad_value_conversion";
+    }
+    catch (const lwcli::bad_value_conversion& error) {
+        EXPECT_EQ("two", error.value);
+    }
+
+    const auto argv = std::array{"append_tests", "-i", "a", "--number=x"};
+    const auto result = parser.try_parse(static_cast<int>(argv.size()), argv.data());
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(lwcli::parse_errc::value_conversion, result.error().code);
+    EXPECT_EQ(3, result.error().index);
+    EXPECT_EQ("--number", result.error().argument);
+    EXPECT_EQ("x", result.error().value);
+}
+
+TEST_F(AppendTests, ConversionErrorsAreReportedLast)
+{
+    // Note: values are only converted once every source has been read, so other errors are reported first.
+    const auto argv = std::array{"append_tests", "-n", "x", "--verbose=maybe"};
+    const auto result = parser.try_parse(static_cast<int>(argv.size()), argv.data());
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(3, result.error().index);
+    EXPECT_EQ("--verbose", result.error().argument);
+
+    lwcli::KeyValueOption<int> level;
+    level.aliases = {"--level"};
+    level.description = "Description for level";
+    parser.register_option(level);
+
+    // Note: bar missing required options, which are only checked once all values have been converted.
+    const auto argv2 = std::array{"append_tests", "-n", "x"};
+    const auto result2 = parser.try_parse(static_cast<int>(argv2.size()), argv2.data());
+    ASSERT_FALSE(result2.has_value());
+    EXPECT_EQ(lwcli::parse_errc::value_conversion, result2.error().code);
+    EXPECT_EQ("x", result2.error().value);
+}
+
+TEST_F(AppendTests, MissingValueIsReported)
+{
+    EXPECT_THROW(parse({"append_tests", "-i", "a", "-i"}), lwcli::bad_key_value_format);
+}
+
+TEST_F(AppendTests, HelpTakesPrecedence)
+{
+    std::string help;
+    parser.redirect_help({[](void* const context, const std::string_view text) {
+                              *static_cast<std::string*>(context) = text;
+                          },
+                          &help});
+
+    inputs.values = {"default"};
+    ASSERT_NO_THROW(parse({"append_tests", "-i", "a", "-n", "x", "--help"}));
+    EXPECT_FALSE(help.empty());
+    EXPECT_NE(help.find("--input"), std::string::npos);
+    EXPECT_EQ((std::vector<std::string>{"default"}), inputs.values);
+}
+
+TEST_F(AppendTests, AppendsEachLineOfTheConfigFile)
+{
+    parser.config_file(write_file("app.ini", "input = a\ninput = b\nnumber = 1\n"));
+
+    ASSERT_NO_THROW(parse({"append_tests", "-n", "2"}));
+    EXPECT_EQ((std::vector<std::string>{"a", "b"}), inputs.values);
+    // Note: the file does not append to values given on the command-line.
+    EXPECT_EQ((std::vector<int>{2}), numbers.values);
+}
+
+TEST_F(AppendTests, ParsesIntoResult)
+{
+    parser.freeze();
+
+    const auto argv = std::array{"append_tests", "-i", "a", "-n", "1", "-i", "b"};
+    lwcli::ParseResult result;
+    ASSERT_NO_THROW(parser.parse_into(static_cast<int>(argv.size()), argv.data(), result));
+    EXPECT_EQ((std::vector<std::string>{"a", "b"}), result[parser.handle_of(inputs)]);
+    EXPECT_EQ((std::vector<int>{1}), result[parser.handle_of(numbers)]);
+    EXPECT_TRUE(inputs.values.empty());
+
+    // Note: a reused result is replaced, as are the options themselves.
+    const auto argv2 = std::array{"append_tests", "-i", "c"};
+    ASSERT_NO_THROW(parser.parse_into(static_cast<int>(argv2.size()), argv2.data(), result));
+    EXPECT_EQ((std::vector<std::string>{"c"}), result[parser.handle_of(inputs)]);
+}
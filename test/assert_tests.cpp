@@ -80,3 +80,18 @@ TEST(AssertTests, FailOnKeyValueNoDescription)
     lwcli::CLIParser parser;
     EXPECT_DEATH(parser.register_option(err_option), ".*");
 }
+
+TEST(AssertTests, FailOnRegisterAfterFreeze)
+{
+    lwcli::FlagOption option1;
+    option1.aliases = {"--value1"};
+    option1.description = "Description for option 1";
+
+    lwcli::FlagOption option2;
+    option2.aliases = {"--value2"};
+    option2.description = "Description for option 2";
+
+    lwcli::CLIParser parser;
+    parser.register_option(option1).freeze();
+    EXPECT_DEATH(parser.register_option(option2), "Options cannot be registered after freezing.");
+}
@@ -0,0 +1,169 @@
+#include "gtest/gtest.h" // cppcheck-suppress [missingInclude]
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "LWCLI/batch.hpp"
+#include "LWCLI/exceptions.hpp"
+#include "LWCLI/options.hpp"
+#include "LWCLI/parser.hpp"
+
+/* Batch tests ------------------------------------------------------------------------------------------------------ */
+
+class BatchTests : public testing::TestWithParam<unsigned int>
+{
+protected:
+    void SetUp() override
+    {
+        verbose.aliases = {"-v"};
+        verbose.description = "Description for verbose";
+
+        threads.aliases = {"-j", "--threads"};
+        threads.description = "Description for threads";
+
+        input.name = "input";
+        input.description = "Description for input";
+
+        parser.register_options(verbose, threads, input).freeze();
+    }
+
+    lwcli::FlagOption verbose;
+    lwcli::KeyValueOption<int> threads;
+    lwcli::PositionalOption<std::string> input;
+    lwcli::CLIParser parser;
+};
+
+INSTANTIATE_TEST_SUITE_P(thread_counts, BatchTests, testing::Values(1U, 2U, 8U));
+
+TEST_P(BatchTests, ResultsInInputOrder)
+{
+    constexpr std::size_t N_ROWS = 10'000;
+
+    std::vector<std::string> lines;
+    for (std::size_t row = 0; row < N_ROWS; ++row)
+        lines.push_back("app -j " + std::to_string(row) + " 'input " + std::to_string(row) + "'");
+
+    std::vector<int> parsed_threads(N_ROWS, -1);
+    std::vector<std::string> parsed_inputs(N_ROWS);
+
+    lwcli::BatchParser batch(parser, GetParam());
+    const auto threads_handle = parser.handle_of(threads);
+    const auto input_handle = parser.handle_of(input);
+
+    // Note: each row is visited exactly once, so writes to distinct slots need no synchronisation.
+    const auto result = batch.parse_lines(lines, [&](const std::size_t row, const lwcli::ParseResult& parsed) {
+        parsed_threads[row] = parsed[threads_handle];
+        parsed_inputs[row] = parsed[input_handle];
+    });
+
+    EXPECT_TRUE(result.ok());
+    EXPECT_EQ(N_ROWS, result.size());
+    for (std::size_t row = 0; row < N_ROWS; ++row) {
+        ASSERT_EQ(static_cast<int>(row), parsed_threads[row]);
+        ASSERT_EQ("input " + std::to_string(row), parsed_inputs[row]);
+    }
+}
+
+TEST_P(BatchTests, ErrorsInInputOrder)
+{
+    std::vector<std::string> lines;
+    for (std::size_t row = 0; row < 1'000; ++row) {
+        if (row % 7 == 0)
+            lines.push_back("app -j not-" + std::to_string(row));
+        else if (row % 11 == 0)
+            lines.push_back("app -j 1 'unterminated");
+        else
+            lines.push_back("app -j 1");
+    }
+
+    std::atomic<std::size_t> n_visited = 0;
+    lwcli::BatchParser batch(parser, GetParam());
+    const auto result = batch.parse_lines(lines, [&](std::size_t /*row*/, const lwcli::ParseResult& /*parsed*/) {
+        n_visited.fetch_add(1, std::memory_order_relaxed);
+    });
+
+    std::size_t n_errors = 0;
+    std::size_t last_row = 0;
+    for (const lwcli::batch_error& error : result.errors()) {
+        EXPECT_TRUE(n_errors == 0 || error.row > last_row);
+        last_row = error.row;
+        ++n_errors;
+
+        if (error.row % 7 == 0) {
+            EXPECT_EQ(lwcli::parse_errc::value_conversion, error.error.code);
+            EXPECT_EQ("-j", error.error.argument);
+            EXPECT_EQ("not-" + std::to_string(error.row), error.error.value);
+        }
+        else {
+            EXPECT_EQ(0, error.row % 11);
+            EXPECT_EQ(lwcli::parse_errc::command_line, error.error.code);
+            EXPECT_EQ("app -j 1 'unterminated", error.error.argument);
+            EXPECT_FALSE(error.error.format().empty());
+        }
+    }
+
+    EXPECT_EQ(lines.size(), n_errors + n_visited);
+    EXPECT_EQ(lines.size(), result.size());
+}
+
+TEST_P(BatchTests, ArgumentLists)
+{
+    const std::vector<std::vector<const char*>> rows = {
+        {"app", "-j", "2", "first"},
+        {"app", "second"},
+        {"app", "-v", "-j", "3", "third"},
+    };
+
+    lwcli::BatchParser batch(parser, GetParam());
+    const auto result = batch.parse(rows);
+
+    ASSERT_EQ(1, result.errors().size());
+    EXPECT_EQ(1, result.errors().front().row);
+    EXPECT_EQ(lwcli::parse_errc::required_options, result.errors().front().error.code);
+
+    // Note: the registered options are never written to.
+    EXPECT_EQ(0, threads.value);
+    EXPECT_EQ("", input.value);
+}
+
+TEST_P(BatchTests, VisitorExceptionsArePropagated)
+{
+    const std::vector<std::string_view> lines(100, "app -j 1");
+
+    lwcli::BatchParser batch(parser, GetParam());
+    EXPECT_THROW(
+        static_cast<void>(batch.parse_lines(
+            lines,
+            [](const std::size_t row, const lwcli::ParseResult& /*parsed*/) {
+                if (row == 42)
+                    throw std::runtime_error("visitor failure");
+            })),
+        std::runtime_error);
+
+    // Note: the pool remains usable afterwards.
+    EXPECT_TRUE(batch.parse_lines(lines).ok());
+}
+
+TEST_P(BatchTests, MissingOptionsOutliveBatch)
+{
+    // Note: the first row's error must not list the options missing from (Nor visited by) those parsed after it.
+    const std::vector<std::string> lines = {"app first", "app -j 2 second", "app third"};
+
+    lwcli::BatchResult result;
+    {
+        lwcli::BatchParser batch(parser, GetParam());
+        result = batch.parse_lines(lines);
+    }
+
+    ASSERT_EQ(2, result.errors().size());
+    for (const lwcli::batch_error& error : result.errors()) {
+        EXPECT_EQ(lwcli::parse_errc::required_options, error.error.code);
+        EXPECT_EQ(std::vector<std::string>{"-j | --threads"}, error.error.missing_options);
+
+        const std::string message = error.error.format();
+        EXPECT_NE(message.find("-j | --threads"), std::string::npos) << message;
+    }
+}
@@ -1,11 +1,19 @@
 #include "gtest/gtest.h" // cppcheck-suppress [missingInclude]
 
+#include <array>
+#include <cstdint>
+#include <memory>
 #include <ranges>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <system_error>
+#include <tuple>
 #include <vector>
 
 #include "LWCLI/cast.hpp"
+#include "LWCLI/options.hpp"
+#include "LWCLI/parser.hpp"
 
 TEST(LWCLITests, hello)
 {
@@ -74,3 +82,189 @@ TEST(IntListCastTest, FilledVectorTest)
     ASSERT_NO_THROW({ result = lwcli::cast<vec_t>::from_string(ss.str()); });
     EXPECT_EQ(test_case, result);
 }
+
+TEST(IntListCastTest, UnpaddedVectorTest)
+{
+    using vec_t = std::vector<long long>;
+
+    vec_t result;
+    ASSERT_NO_THROW({ result = lwcli::cast<vec_t>::from_string("1,-2,3"); });
+    EXPECT_EQ((vec_t{1, -2, 3}), result);
+}
+
+TEST(IntListCastTest, BadElementTest)
+{
+    using vec_t = std::vector<int>;
+
+    vec_t result;
+    EXPECT_EQ(std::errc::invalid_argument, lwcli::cast<vec_t>::try_from_string("1, 2, three", result));
+    EXPECT_THROW({ result = lwcli::cast<vec_t>::from_string("1,,3"); }, std::invalid_argument);
+}
+
+TEST(StringListCastTest, ElementsAreNotTrimmed)
+{
+    using vec_t = std::vector<std::string>;
+
+    vec_t result;
+    ASSERT_EQ(std::errc{}, lwcli::cast<vec_t>::try_from_string("a, b", result));
+    EXPECT_EQ((vec_t{"a", " b"}), result);
+}
+
+TEST(BoolListCastTest, FilledVectorTest)
+{
+    using vec_t = std::vector<bool>;
+
+    vec_t result;
+    ASSERT_NO_THROW({ result = lwcli::cast<vec_t>::from_string("1,0, true"); });
+    EXPECT_EQ((vec_t{true, false, true}), result);
+}
+
+/* Non-throwing casts ----------------------------------------------------------------------------------------------- */
+
+class InvalidIntCastTests : public testing::TestWithParam<const char*>
+{};
+
+INSTANTIATE_TEST_SUITE_P(
+    invalid_str_ints,
+    InvalidIntCastTests,
+    testing::Values("", "10abc", "1.5", "abc", " 10", "--1"));
+
+TEST_P(InvalidIntCastTests, UnhappyIntCasts)
+{
+    int value = 0;
+    EXPECT_EQ(std::errc::invalid_argument, lwcli::cast<int>::try_from_string(GetParam(), value));
+    EXPECT_THROW({ value = lwcli::cast<int>::from_string(GetParam()); }, std::invalid_argument);
+}
+
+TEST(NumericCastTests, OutOfRange)
+{
+    std::uint8_t small_value = 0;
+    EXPECT_EQ(std::errc::result_out_of_range, lwcli::cast<std::uint8_t>::try_from_string("256", small_value));
+    EXPECT_EQ(std::errc::invalid_argument, lwcli::cast<std::uint8_t>::try_from_string("-1", small_value));
+
+    long long large_value = 0;
+    EXPECT_EQ(
+        std::errc::result_out_of_range,
+        lwcli::cast<long long>::try_from_string("99999999999999999999", large_value));
+    EXPECT_THROW({ large_value = lwcli::cast<long long>::from_string("99999999999999999999"); }, std::out_of_range);
+}
+
+TEST(NumericCastTests, LeadingPlusSign)
+{
+    EXPECT_EQ(10, lwcli::cast<int>::from_string("+10"));
+    EXPECT_EQ(2.5F, lwcli::cast<float>::from_string("+2.5"));
+    EXPECT_THROW({ std::ignore = lwcli::cast<int>::from_string("+-10"); }, std::invalid_argument);
+}
+
+TEST(NumericCastTests, FloatsParsedDirectly)
+{
+    // Note: rounding through long double first could produce a different (double rounded) result.
+    constexpr auto str = "0.1";
+    EXPECT_EQ(0.1F, lwcli::cast<float>::from_string(str));
+    EXPECT_EQ(0.1, lwcli::cast<double>::from_string(str));
+
+    float value = 0;
+    EXPECT_EQ(std::errc::invalid_argument, lwcli::cast<float>::try_from_string("0.1f", value));
+}
+
+TEST(BoolCastTests, ValidAndInvalid)
+{
+    EXPECT_TRUE(lwcli::cast<bool>::from_string("true"));
+    EXPECT_TRUE(lwcli::cast<bool>::from_string("1"));
+    EXPECT_FALSE(lwcli::cast<bool>::from_string("false"));
+    EXPECT_FALSE(lwcli::cast<bool>::from_string("0"));
+    EXPECT_THROW({ std::ignore = lwcli::cast<bool>::from_string("2"); }, std::invalid_argument);
+}
+
+/* List casts ------------------------------------------------------------------------------------------------------- */
+
+TEST(IntListCastTest, BlockBoundaries)
+{
+    // Note: exercises lists whose delimiters straddle (And whose tails are shorter than) any SIMD block size.
+    for (int n_elements = 1; n_elements < 100; ++n_elements) {
+        std::vector<int> expected;
+        std::string str;
+        for (int i = 0; i < n_elements; ++i) {
+            expected.push_back(i * 37 - 500);
+            str += (i == 0 ? "" : ",") + std::to_string(expected.back());
+        }
+
+        std::vector<int> result;
+        ASSERT_EQ(std::errc{}, lwcli::cast<std::vector<int>>::try_from_string(str, result)) << str;
+        EXPECT_EQ(expected, result);
+        EXPECT_EQ(result.size(), result.capacity()) << "Expected exactly one (exact) allocation";
+    }
+}
+
+TEST(IntListCastTest, CustomDelimiter)
+{
+    using vec_t = std::vector<int>;
+    EXPECT_EQ((vec_t{1, 2, 3}), lwcli::cast<vec_t>::from_string("1;2;3", ';'));
+    EXPECT_THROW({ std::ignore = lwcli::cast<vec_t>::from_string("1;2;3"); }, std::invalid_argument);
+}
+
+template<class Type>
+struct TaggedAllocator : std::allocator<Type>
+{
+    using value_type = Type;
+
+    template<class Other>
+    struct rebind
+    {
+        using other = TaggedAllocator<Other>;
+    };
+
+    TaggedAllocator() = default;
+
+    template<class Other>
+    // NOLINTNEXTLINE(google-explicit-constructor, hicpp-explicit-conversions)
+    TaggedAllocator(const TaggedAllocator<Other>& /*other*/) noexcept
+    {}
+};
+
+TEST(StringListCastTest, CustomAllocator)
+{
+    using vec_t = std::vector<std::string, TaggedAllocator<std::string>>;
+
+    const vec_t result = lwcli::cast<vec_t>::from_string(" first , second,third ");
+    EXPECT_EQ((vec_t{" first ", " second", "third "}), result);
+}
+
+/* User-defined casts ----------------------------------------------------------------------------------------------- */
+
+namespace
+{
+struct legacy_value
+{
+    int value = 0;
+
+    [[nodiscard]] bool operator==(const legacy_value&) const noexcept = default;
+};
+} // namespace
+
+// Note: declares from_string(...) with its former signature, which a std::string_view does not implicitly convert to.
+template<>
+struct lwcli::cast<legacy_value>
+{
+    [[nodiscard]] static legacy_value from_string(const std::string& str)
+    {
+        return {std::stoi(str)};
+    }
+};
+
+TEST(UserCastTests, ConstStringOverload)
+{
+    using vec_t = std::vector<legacy_value>;
+    EXPECT_EQ((vec_t{{1}, {2}}), lwcli::cast<vec_t>::from_string("1,2"));
+
+    lwcli::KeyValueOption<legacy_value> option;
+    option.aliases = {"--value"};
+    option.description = "Description for value";
+
+    lwcli::CLIParser parser;
+    parser.register_option(option);
+
+    const std::array argv = {"cast_tests", "--value", "7"};
+    ASSERT_NO_THROW(parser.parse(static_cast<int>(argv.size()), argv.data()));
+    EXPECT_EQ(7, option.value.value);
+}
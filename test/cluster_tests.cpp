@@ -0,0 +1,163 @@
+#include "gtest/gtest.h" // cppcheck-suppress [missingInclude]
+
+#include <array>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "LWCLI/exceptions.hpp"
+#include "LWCLI/options.hpp"
+#include "LWCLI/parse_result.hpp"
+#include "LWCLI/parser.hpp"
+
+class ClusterTests : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        verbose.aliases = {"-v", "--verbose"};
+        verbose.description = "Description for verbose";
+
+        all.aliases = {"-a"};
+        all.description = "Description for all";
+
+        threads.aliases = {"-j", "--threads"};
+        threads.description = "Description for threads";
+
+        name.aliases = {"--name"};
+        name.description = "Description for name";
+
+        input.name = "input";
+        input.description = "Description for input";
+
+        parser.register_options(verbose, all, threads, name, input);
+    }
+
+    void parse(const std::vector<const char*>& argv)
+    {
+        parser.parse(static_cast<int>(argv.size()), argv.data());
+    }
+
+    lwcli::FlagOption verbose;
+    lwcli::FlagOption all;
+    lwcli::KeyValueOption<std::optional<int>> threads;
+    lwcli::KeyValueOption<std::optional<std::string>> name;
+    lwcli::PositionalOption<std::optional<std::string>> input;
+    lwcli::CLIParser parser;
+};
+
+TEST_F(ClusterTests, ParsesClusteredFlags)
+{
+    ASSERT_NO_THROW(parse({"cluster_tests", "-vvv", "-av"}));
+    EXPECT_EQ(4, verbose.count);
+    EXPECT_EQ(1, all.count);
+}
+
+TEST_F(ClusterTests, ParsesAttachedValues)
+{
+    ASSERT_NO_THROW(parse({"cluster_tests", "-j8"}));
+    EXPECT_EQ(8, threads.value);
+
+    // Note: the key-value option ends the cluster, whatever follows it being its value.
+    ASSERT_NO_THROW(parse({"cluster_tests", "-vaj-16"}));
+    EXPECT_EQ(1, verbose.count);
+    EXPECT_EQ(1, all.count);
+    EXPECT_EQ(-16, threads.value);
+
+    ASSERT_NO_THROW(parse({"cluster_tests", "-vj", "4"}));
+    EXPECT_EQ(4, threads.value);
+}
+
+TEST_F(ClusterTests, ParsesInlineValues)
+{
+    ASSERT_NO_THROW(parse({"cluster_tests", "--threads=12", "--name=a=b", "--verbose=true", "--verbose=0"}));
+    EXPECT_EQ(12, threads.value);
+    EXPECT_EQ("a=b", name.value);
+    EXPECT_EQ(1, verbose.count);
+
+    ASSERT_NO_THROW(parse({"cluster_tests", "--name="}));
+    EXPECT_EQ("", name.value);
+}
+
+TEST_F(ClusterTests, InlineValuesOfAbbreviations)
+{
+    parser.match_prefixes();
+
+    ASSERT_NO_THROW(parse({"cluster_tests", "--thr=3"}));
+    EXPECT_EQ(3, threads.value);
+}
+
+TEST_F(ClusterTests, NonClustersArePositional)
+{
+    // Note: '-x' is not a short option, nor is '--unknown' a long one.
+    for (const char* const arg : {"-vx", "-12", "--unknown=1", "--=1"}) {
+        ASSERT_NO_THROW(parse({"cluster_tests", arg})) << "For argument: " << arg;
+        EXPECT_EQ(arg, input.value);
+        EXPECT_EQ(0, verbose.count);
+    }
+}
+
+TEST_F(ClusterTests, ReportsBadValues)
+{
+    try {
+        parse({"cluster_tests", "-vjx"});
+        FAIL() << "Expected bad_value_conversion";
+    }
+    catch (const lwcli::bad_value_conversion& error) {
+        EXPECT_EQ("x", error.value);
+    }
+
+    EXPECT_THROW(parse({"cluster_tests", "--threads=x"}), lwcli::bad_value_conversion);
+    EXPECT_THROW(parse({"cluster_tests", "--verbose=maybe"}), lwcli::bad_value_conversion);
+    EXPECT_THROW(parse({"cluster_tests", "-vj"}), lwcli::bad_key_value_format);
+}
+
+TEST_F(ClusterTests, ErrorsNameTheClusteredOption)
+{
+    // Note: errors name the option within the cluster, rather than the cluster itself.
+    const std::array bad_value{"cluster_tests", "-vjx"};
+    const auto conversion = parser.try_parse(static_cast<int>(std::size(bad_value)), std::data(bad_value));
+    ASSERT_FALSE(conversion.has_value());
+    EXPECT_EQ(lwcli::parse_errc::value_conversion, conversion.error().code);
+    EXPECT_EQ("-j", conversion.error().argument);
+
+    const std::array no_value{"cluster_tests", "-vj"};
+    const auto format = parser.try_parse(static_cast<int>(std::size(no_value)), std::data(no_value));
+    ASSERT_FALSE(format.has_value());
+    EXPECT_EQ(lwcli::parse_errc::key_value_format, format.error().code);
+    EXPECT_EQ("-j", format.error().argument);
+}
+
+TEST_F(ClusterTests, ClustersMayRequestHelp)
+{
+    std::string help;
+    parser.redirect_help({[](void* const context, const std::string_view text) {
+                              *static_cast<std::string*>(context) = text;
+                          },
+                          &help});
+
+    ASSERT_NO_THROW(parse({"cluster_tests", "--threads=x", "-vh"}));
+    EXPECT_FALSE(help.empty());
+
+    help.clear();
+    ASSERT_NO_THROW(parse({"cluster_tests", "--help=1"}));
+    EXPECT_FALSE(help.empty());
+
+    // Note: within the value of a key-value option, 'h' is just a character.
+    help.clear();
+    EXPECT_THROW(parse({"cluster_tests", "--threads=x", "-jh"}), lwcli::bad_value_conversion);
+    EXPECT_TRUE(help.empty());
+}
+
+TEST_F(ClusterTests, ParsesIntoResult)
+{
+    parser.freeze();
+
+    const auto argv = std::array{"cluster_tests", "-vvj2", "--name=lwcli"};
+    lwcli::ParseResult result;
+    ASSERT_NO_THROW(parser.parse_into(static_cast<int>(argv.size()), argv.data(), result));
+    EXPECT_EQ(2, result[parser.handle_of(verbose)]);
+    EXPECT_EQ(2, result[parser.handle_of(threads)]);
+    EXPECT_EQ("lwcli", result[parser.handle_of(name)]);
+}
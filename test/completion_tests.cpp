@@ -0,0 +1,171 @@
+#include "gtest/gtest.h" // cppcheck-suppress [missingInclude]
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "LWCLI/completion.hpp"
+#include "LWCLI/options.hpp"
+#include "LWCLI/parser.hpp"
+
+class CompletionTests : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        verbose.aliases = {"-v", "--verbose"};
+        verbose.description = "Description for verbose";
+
+        version.aliases = {"--version"};
+        version.description = "Description for version";
+
+        threads.aliases = {"-j", "--threads"};
+        threads.description = "Description for threads";
+
+        input.name = "input";
+        input.description = "Description for input";
+
+        parser.register_options(verbose, version, threads, input)
+            .register_subcommand("build", "Description for build", [this](lwcli::CLIParser& build) {
+                release.aliases = {"--release"};
+                release.description = "Description for release";
+                build.register_option(release);
+            })
+            .register_subcommand("bench", "Description for bench", [](lwcli::CLIParser&) {});
+
+        parser.redirect_help({[](void* const context, const std::string_view text) {
+                                  *static_cast<std::string*>(context) += text;
+                              },
+                              &output});
+    }
+
+    // The completions written when completing the index'th of words.
+    std::string complete(const std::string& index, const std::vector<const char*>& words)
+    {
+        std::vector<const char*> argv = {"completion_tests", "--__complete", index.c_str()};
+        argv.insert(argv.end(), words.begin(), words.end());
+
+        output.clear();
+        parser.parse(static_cast<int>(argv.size()), argv.data());
+        EXPECT_TRUE(parser.completion_requested());
+        return output;
+    }
+
+    lwcli::FlagOption verbose;
+    lwcli::FlagOption version;
+    lwcli::KeyValueOption<std::optional<int>> threads;
+    lwcli::PositionalOption<std::optional<std::string>> input;
+    lwcli::FlagOption release;
+    lwcli::CLIParser parser;
+    std::string output;
+};
+
+TEST_F(CompletionTests, CompletesAliases)
+{
+    for (const bool freeze : {false, true}) {
+        if (freeze)
+            parser.freeze();
+
+        EXPECT_EQ("--verbose\n--version\n", complete("1", {"completion_tests", "--ver"}));
+        EXPECT_EQ("--help\n", complete("2", {"completion_tests", "-v", "--he"}));
+        EXPECT_EQ("--help\n--threads\n--verbose\n--version\n", complete("1", {"completion_tests", "--"}));
+        EXPECT_EQ("", complete("1", {"completion_tests", "--output"}));
+
+        // Note: words other than the one being completed are irrelevant.
+        EXPECT_EQ("-j\n", complete("1", {"completion_tests", "-j", "--verbose"}));
+    }
+
+    EXPECT_EQ(0, verbose.count);
+    EXPECT_EQ(std::nullopt, input.value);
+}
+
+TEST_F(CompletionTests, CompletesSubcommands)
+{
+    EXPECT_EQ("bench\nbuild\n", complete("1", {"completion_tests"}));
+    EXPECT_EQ("build\n", complete("1", {"completion_tests", "bu"}));
+
+    // Note: only the first argument may name a subcommand.
+    EXPECT_EQ("", complete("2", {"completion_tests", "input", "bu"}));
+}
+
+TEST_F(CompletionTests, CompletesWithinSubcommands)
+{
+    EXPECT_EQ("--release\n", complete("2", {"completion_tests", "build", "--r"}));
+    EXPECT_EQ("", complete("2", {"completion_tests", "build", "--verb"}));
+    EXPECT_TRUE(parser.selected_subcommand().empty());
+}
+
+TEST_F(CompletionTests, LeavesValuesToTheShell)
+{
+    EXPECT_EQ("", complete("2", {"completion_tests", "--threads", "-"}));
+    EXPECT_EQ("", complete("2", {"completion_tests", "input"}));
+    EXPECT_EQ("--verbose\n", complete("3", {"completion_tests", "--threads", "4", "--verb"}));
+}
+
+TEST_F(CompletionTests, IgnoresMalformedRequests)
+{
+    EXPECT_EQ("", complete("x", {"completion_tests", "--ver"}));
+    EXPECT_EQ("", complete("-1", {"completion_tests", "--ver"}));
+
+    const auto argv = std::vector<const char*>{"completion_tests", "--__complete"};
+    output.clear();
+    parser.parse(static_cast<int>(argv.size()), argv.data());
+    EXPECT_TRUE(parser.completion_requested());
+    EXPECT_TRUE(output.empty());
+}
+
+TEST_F(CompletionTests, OrdinaryParsesAreNotCompletionRequests)
+{
+    const auto argv = std::vector<const char*>{"completion_tests", "--verbose", "--__complete"};
+    parser.parse(static_cast<int>(argv.size()), argv.data());
+
+    EXPECT_FALSE(parser.completion_requested());
+    EXPECT_EQ(1, verbose.count);
+    EXPECT_EQ("--__complete", input.value);
+}
+
+TEST_F(CompletionTests, GeneratesBashScripts)
+{
+    const std::string script = parser.completion_script(lwcli::completion_shell::bash, "my-tool");
+
+    EXPECT_NE(script.find("complete -o default -F _lwcli_my_tool 'my-tool'\n"), std::string::npos);
+    EXPECT_NE(script.find("aliases='--help -h -v --verbose --version -j --threads'\n"), std::string::npos);
+    EXPECT_NE(script.find("values=' -j --threads '\n"), std::string::npos);
+    EXPECT_NE(script.find("subcommands=' build bench '\n"), std::string::npos);
+    EXPECT_NE(script.find("'/build')\n        aliases='--help -h --release'\n"), std::string::npos);
+}
+
+TEST_F(CompletionTests, GeneratesZshScripts)
+{
+    const std::string script = parser.completion_script(lwcli::completion_shell::zsh, "tool");
+
+    EXPECT_TRUE(script.starts_with("#compdef tool\n"));
+    EXPECT_NE(script.find("'-j:Description for threads' '--threads:Description for threads'"), std::string::npos);
+    EXPECT_NE(script.find("values=('-j' '--threads')\n"), std::string::npos);
+    EXPECT_NE(script.find("subcommands=('build:Description for build' 'bench:Description for bench')\n"),
+              std::string::npos);
+}
+
+TEST_F(CompletionTests, GeneratesFishScripts)
+{
+    const std::string script = parser.completion_script(lwcli::completion_shell::fish, "tool");
+
+    EXPECT_NE(script.find("case ' build' ' bench'\n"), std::string::npos);
+    EXPECT_NE(script.find("complete -c 'tool' -n '_lwcli_tool_at \\'\\'' -s 'j' -l 'threads' -r -d "
+                          "'Description for threads'\n"),
+              std::string::npos);
+    EXPECT_NE(script.find("complete -c 'tool' -n '_lwcli_tool_at \\'/build\\'' -l 'release' -d "
+                          "'Description for release'\n"),
+              std::string::npos);
+    EXPECT_NE(script.find("complete -c 'tool' -n '_lwcli_tool_at \\'\\' --first' -a 'build' -d "
+                          "'Description for build'\n"),
+              std::string::npos);
+}
+
+TEST(CompletionQuotingTests, QuotesForEachShell)
+{
+    EXPECT_EQ("'it'\\''s'", lwcli::_posix_quote("it's"));
+    EXPECT_EQ("'it\\'s \\\\'", lwcli::_fish_quote("it's \\"));
+    EXPECT_EQ("_lwcli_my_tool_2", lwcli::_completion_function_name("my-tool.2"));
+}
@@ -0,0 +1,212 @@
+#include "gtest/gtest.h" // cppcheck-suppress [missingInclude]
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include "LWCLI/_tokenizer.hpp"
+#include "LWCLI/exceptions.hpp"
+#include "LWCLI/options.hpp"
+#include "LWCLI/parser.hpp"
+
+/* Line classification tests ---------------------------------------------------------------------------------------- */
+
+struct ConfigLineCase
+{
+    std::string_view line;
+    lwcli::_config_line kind;
+    std::string_view key;
+    std::string_view value;
+};
+
+// Note: names each case after its line, rather than the bytes of the struct.
+void PrintTo(const ConfigLineCase& test_case, std::ostream* os)
+{
+    *os << testing::PrintToString(test_case.line);
+}
+
+class ConfigLineTests : public testing::TestWithParam<ConfigLineCase>
+{};
+
+INSTANTIATE_TEST_SUITE_P(
+    config_lines,
+    ConfigLineTests,
+    testing::Values(
+        ConfigLineCase{"", lwcli::_config_line::BLANK, "", ""},
+        ConfigLineCase{"   \r", lwcli::_config_line::BLANK, "", ""},
+        ConfigLineCase{"# threads = 4", lwcli::_config_line::BLANK, "", ""},
+        ConfigLineCase{"; threads = 4", lwcli::_config_line::BLANK, "", ""},
+        ConfigLineCase{"[ net ]", lwcli::_config_line::SECTION, "net", ""},
+        ConfigLineCase{"[net", lwcli::_config_line::BAD_SECTION, "", ""},
+        ConfigLineCase{"verbose", lwcli::_config_line::KEY, "verbose", ""},
+        ConfigLineCase{"threads=4", lwcli::_config_line::KEY_VALUE, "threads", "4"},
+        ConfigLineCase{"  threads =  4 \r", lwcli::_config_line::KEY_VALUE, "threads", "4"},
+        ConfigLineCase{"name = \"a = b\"", lwcli::_config_line::KEY_VALUE, "name", "a = b"},
+        ConfigLineCase{"name = 'quoted'", lwcli::_config_line::KEY_VALUE, "name", "quoted"},
+        ConfigLineCase{"name = \"unmatched'", lwcli::_config_line::KEY_VALUE, "name", "\"unmatched'"},
+        ConfigLineCase{"name =", lwcli::_config_line::KEY_VALUE, "name", ""}));
+
+TEST_P(ConfigLineTests, Classifies)
+{
+    std::string_view key;
+    std::string_view value;
+    EXPECT_EQ(GetParam().kind, lwcli::_classify_config_line(GetParam().line, key, value));
+    EXPECT_EQ(GetParam().key, key);
+    EXPECT_EQ(GetParam().value, value);
+}
+
+/* Parser tests ----------------------------------------------------------------------------------------------------- */
+
+class ConfigFileTests : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        _directory = std::filesystem::temp_directory_path()
+                     / ("lwcli_config_file_tests_" + std::to_string(reinterpret_cast<std::uintptr_t>(this)));
+        std::filesystem::create_directories(_directory);
+
+        verbose.aliases = {"-v", "--verbose"};
+        verbose.description = "Description for verbose";
+        threads.aliases = {"-j", "--threads"};
+        threads.description = "Description for threads";
+        name.aliases = {"--name"};
+        name.description = "Description for name";
+        port.aliases = {"--net.port"};
+        port.description = "Description for port";
+
+        parser.register_options(verbose, threads, name, port);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(_directory);
+    }
+
+    [[nodiscard]] std::string write_file(const std::string& name, const std::string& contents) const
+    {
+        const auto path = _directory / name;
+        std::ofstream(path, std::ios::binary) << contents;
+        return path.string();
+    }
+
+    lwcli::FlagOption verbose;
+    lwcli::KeyValueOption<int> threads;
+    lwcli::KeyValueOption<std::string> name;
+    lwcli::KeyValueOption<std::optional<int>> port;
+    lwcli::CLIParser parser;
+
+private:
+    std::filesystem::path _directory;
+};
+
+TEST_F(ConfigFileTests, AppliesValues)
+{
+    parser.config_file(write_file(
+        "app.ini",
+        "# Comment\n"
+        "verbose\n"
+        "threads = 8\n"
+        "name = \"some name\"\n"
+        "\n"
+        "[net]\n"
+        "port = 8080"));
+
+    const auto argv = std::array{"config_file_tests", "-v"};
+    ASSERT_NO_THROW(parser.parse(static_cast<int>(std::size(argv)), std::data(argv)));
+
+    // Note: the flag provided on the command-line is not enabled a second time by the file.
+    EXPECT_EQ(1, verbose.count);
+    EXPECT_EQ(8, threads.value);
+    EXPECT_EQ("some name", name.value);
+    EXPECT_EQ(8080, port.value);
+}
+
+TEST_F(ConfigFileTests, CommandLineTakesPrecedence)
+{
+    parser.config_file(write_file("app.ini", "threads = 8\nname = file\nverbose = false\nthreads = 4\n"));
+
+    const auto argv = std::array{"config_file_tests", "--threads", "2"};
+    ASSERT_NO_THROW(parser.parse(static_cast<int>(std::size(argv)), std::data(argv)));
+
+    EXPECT_EQ(0, verbose.count);
+    EXPECT_EQ(2, threads.value);
+    EXPECT_EQ("file", name.value);
+}
+
+TEST_F(ConfigFileTests, SatisfiesRequiredOptions)
+{
+    const auto argv = std::array{"config_file_tests", "--threads", "2"};
+    EXPECT_THROW(parser.parse(static_cast<int>(std::size(argv)), std::data(argv)), lwcli::bad_required_options);
+
+    parser.config_file(write_file("app.ini", "name = file\r\n"));
+    EXPECT_NO_THROW(parser.parse(static_cast<int>(std::size(argv)), std::data(argv)));
+}
+
+TEST_F(ConfigFileTests, ManyEntries)
+{
+    std::string contents;
+    for (int i = 0; i < 10'000; ++i)
+        contents += "threads = " + std::to_string(i) + "\n";
+    parser.config_file(write_file("app.ini", contents + "name = file"));
+
+    const auto argv = std::array{"config_file_tests", "-v"};
+    ASSERT_NO_THROW(parser.parse(static_cast<int>(std::size(argv)), std::data(argv)));
+    EXPECT_EQ(9'999, threads.value);
+}
+
+struct BadConfigCase
+{
+    std::string contents;
+    lwcli::parse_errc code;
+    std::string_view argument;
+};
+
+// Note: names each case after its contents, rather than the bytes of the struct.
+void PrintTo(const BadConfigCase& test_case, std::ostream* os)
+{
+    *os << testing::PrintToString(test_case.contents);
+}
+
+class BadConfigFileTests :
+    public ConfigFileTests,
+    public testing::WithParamInterface<BadConfigCase>
+{};
+
+INSTANTIATE_TEST_SUITE_P(
+    bad_config_files,
+    BadConfigFileTests,
+    testing::Values(
+        BadConfigCase{"name = file\nunknown = 1", lwcli::parse_errc::config_file, "unknown"},
+        BadConfigCase{"name = file\n[net\nport = 1", lwcli::parse_errc::config_file, "[net"},
+        BadConfigCase{"name = file\nport = 1", lwcli::parse_errc::config_file, "port"},
+        BadConfigCase{"name = file\n[net]\nport = many", lwcli::parse_errc::value_conversion, "port"},
+        BadConfigCase{"name = file\nverbose = maybe", lwcli::parse_errc::value_conversion, "verbose"},
+        BadConfigCase{"name\nthreads = 1", lwcli::parse_errc::key_value_format, "name"}));
+
+TEST_P(BadConfigFileTests, ReportsError)
+{
+    parser.config_file(write_file("bad.ini", GetParam().contents));
+
+    const auto argv = std::array{"config_file_tests", "-j", "1"};
+    const auto result = parser.try_parse(static_cast<int>(std::size(argv)), std::data(argv));
+
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(GetParam().code, result.error().code);
+    EXPECT_EQ(static_cast<int>(std::size(argv)), result.error().index);
+    EXPECT_EQ(GetParam().argument, result.error().argument);
+    EXPECT_FALSE(result.error().format().empty());
+}
+
+TEST_F(ConfigFileTests, UnreadableConfigFile)
+{
+    parser.config_file((std::filesystem::temp_directory_path() / "lwcli_missing_config_file.ini").string());
+
+    const auto argv = std::array{"config_file_tests", "-j", "1", "--name", "x"};
+    EXPECT_THROW(parser.parse(static_cast<int>(std::size(argv)), std::data(argv)), lwcli::bad_config_file);
+}
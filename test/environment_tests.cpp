@@ -0,0 +1,121 @@
+#include "gtest/gtest.h" // cppcheck-suppress [missingInclude]
+
+#include <array>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "LWCLI/exceptions.hpp"
+#include "LWCLI/options.hpp"
+#include "LWCLI/parser.hpp"
+
+class EnvironmentTests : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        verbose.aliases = {"-v"};
+        verbose.description = "Description for verbose";
+        verbose.env = "LWCLI_TEST_VERBOSE";
+
+        threads.aliases = {"--threads"};
+        threads.description = "Description for threads";
+        threads.env = "LWCLI_TEST_THREADS";
+
+        input.name = "input";
+        input.description = "Description for input";
+        input.env = "LWCLI_TEST_INPUT";
+
+        parser.register_options(verbose, threads, input);
+    }
+
+    void TearDown() override
+    {
+        for (const char* const name : {"LWCLI_TEST_VERBOSE", "LWCLI_TEST_THREADS", "LWCLI_TEST_INPUT"})
+            set_env(name, nullptr);
+    }
+
+    // Sets (Or unsets, if value is null) the environment variable name.
+    static void set_env(const char* const name, const char* const value)
+    {
+#ifdef _WIN32
+        _putenv_s(name, value != nullptr ? value : "");
+#else
+        if (value != nullptr)
+            setenv(name, value, 1);
+        else
+            unsetenv(name);
+#endif
+    }
+
+    lwcli::FlagOption verbose;
+    lwcli::KeyValueOption<int> threads;
+    lwcli::PositionalOption<std::string> input;
+    lwcli::CLIParser parser;
+};
+
+TEST_F(EnvironmentTests, AppliesBoundVariables)
+{
+    set_env("LWCLI_TEST_VERBOSE", "true");
+    set_env("LWCLI_TEST_THREADS", "4");
+    set_env("LWCLI_TEST_INPUT", "file.txt");
+
+    // Note: the environment satisfies the required --threads option.
+    const auto argv = std::array{"environment_tests", "-v", "-v"};
+    ASSERT_NO_THROW(parser.parse(static_cast<int>(std::size(argv)), std::data(argv)));
+
+    EXPECT_EQ(2, verbose.count);
+    EXPECT_EQ(4, threads.value);
+    EXPECT_EQ("file.txt", input.value);
+}
+
+TEST_F(EnvironmentTests, CommandLineTakesPrecedence)
+{
+    set_env("LWCLI_TEST_VERBOSE", "1");
+    set_env("LWCLI_TEST_THREADS", "4");
+    set_env("LWCLI_TEST_INPUT", "file.txt");
+
+    const auto argv = std::array{"environment_tests", "--threads", "8", "other.txt"};
+    ASSERT_NO_THROW(parser.parse(static_cast<int>(std::size(argv)), std::data(argv)));
+
+    EXPECT_EQ(1, verbose.count);
+    EXPECT_EQ(8, threads.value);
+    EXPECT_EQ("other.txt", input.value);
+}
+
+TEST_F(EnvironmentTests, TakesPrecedenceOverConfigFile)
+{
+    const auto path = std::filesystem::temp_directory_path() / "lwcli_environment_tests.ini";
+    std::ofstream(path, std::ios::binary) << "threads = 2\nv = true";
+
+    set_env("LWCLI_TEST_THREADS", "4");
+    parser.config_file(path.string());
+
+    const auto argv = std::array{"environment_tests", "file.txt"};
+    ASSERT_NO_THROW(parser.parse(static_cast<int>(std::size(argv)), std::data(argv)));
+    std::filesystem::remove(path);
+
+    EXPECT_EQ(1, verbose.count);
+    EXPECT_EQ(4, threads.value);
+}
+
+TEST_F(EnvironmentTests, UnsetVariablesAreIgnored)
+{
+    const auto argv = std::array{"environment_tests", "-v"};
+    EXPECT_THROW(parser.parse(static_cast<int>(std::size(argv)), std::data(argv)), lwcli::bad_required_options);
+}
+
+TEST_F(EnvironmentTests, BadValueNamesVariable)
+{
+    set_env("LWCLI_TEST_THREADS", "many");
+
+    const auto argv = std::array{"environment_tests", "-v"};
+    const auto result = parser.try_parse(static_cast<int>(std::size(argv)), std::data(argv));
+
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(lwcli::parse_errc::value_conversion, result.error().code);
+    EXPECT_EQ(static_cast<int>(std::size(argv)), result.error().index);
+    EXPECT_EQ("LWCLI_TEST_THREADS", result.error().argument);
+    EXPECT_EQ("many", result.error().value);
+}
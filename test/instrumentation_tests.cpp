@@ -0,0 +1,131 @@
+// Note: must precede every LWCLI header, and (Counting allocations) be defined in only this translation unit.
+#define LWCLI_INSTRUMENTATION
+#define LWCLI_INSTRUMENTATION_COUNT_ALLOCATIONS
+
+#include "gtest/gtest.h" // cppcheck-suppress [missingInclude]
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "LWCLI/exceptions.hpp"
+#include "LWCLI/instrumentation.hpp"
+#include "LWCLI/options.hpp"
+#include "LWCLI/parse_result.hpp"
+#include "LWCLI/parser.hpp"
+
+class InstrumentationTests : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        verbose.aliases = {"-v"};
+        verbose.description = "Description for verbose";
+
+        quiet.aliases = {"-q"};
+        quiet.description = "Description for quiet";
+
+        threads.aliases = {"-j", "--threads"};
+        threads.description = "Description for threads";
+
+        input.name = "input";
+        input.description = "Description for input";
+
+        parser.register_options(verbose, quiet, threads, input).instrument({record, &reports});
+    }
+
+    static void record(void* const context, const lwcli::parse_stats& stats)
+    {
+        static_cast<std::vector<lwcli::parse_stats>*>(context)->push_back(stats);
+    }
+
+    lwcli::FlagOption verbose;
+    lwcli::FlagOption quiet;
+    lwcli::KeyValueOption<int> threads;
+    lwcli::PositionalOption<std::string> input;
+    lwcli::CLIParser parser;
+
+    std::vector<lwcli::parse_stats> reports;
+};
+
+TEST_F(InstrumentationTests, RecordsLookupsHitsAndConversions)
+{
+    const auto argv = std::array{"instrumentation_tests", "-v", "-j", "4", "-v", "input.txt"};
+    parser.parse(static_cast<int>(std::size(argv)), std::data(argv));
+
+    ASSERT_EQ(1, reports.size());
+    const lwcli::parse_stats& stats = reports.front();
+
+    // Note: every argument bar the value of -j is looked up, including the positional.
+    EXPECT_EQ(4, stats.n_lookups);
+    EXPECT_EQ((std::vector<std::size_t>{2, 0}), stats.flag_hits);
+    EXPECT_EQ(std::vector<std::size_t>{1}, stats.key_value_hits);
+
+    EXPECT_EQ(2, stats.n_conversions);
+    ASSERT_EQ(1, stats.key_value_conversion_times.size());
+    ASSERT_EQ(1, stats.positional_conversion_times.size());
+    EXPECT_GE(stats.conversion_time, stats.key_value_conversion_times[0] + stats.positional_conversion_times[0]);
+
+    EXPECT_EQ(lwcli::parse_stats::duration::zero(), stats.error_time);
+    EXPECT_GE(stats.total_time, stats.lookup_time + stats.conversion_time);
+}
+
+TEST_F(InstrumentationTests, StatisticsAreResetEachParse)
+{
+    const auto first_argv = std::array{"instrumentation_tests", "-v", "-v", "-j", "1"};
+    parser.parse(static_cast<int>(std::size(first_argv)), std::data(first_argv));
+
+    const auto second_argv = std::array{"instrumentation_tests", "-q", "-j", "1"};
+    parser.parse(static_cast<int>(std::size(second_argv)), std::data(second_argv));
+
+    ASSERT_EQ(2, reports.size());
+    EXPECT_EQ((std::vector<std::size_t>{0, 1}), reports.back().flag_hits);
+    EXPECT_EQ(2, reports.back().n_lookups);
+}
+
+TEST_F(InstrumentationTests, RecordsErrors)
+{
+    const auto argv = std::array{"instrumentation_tests", "-j", "many"};
+    EXPECT_THROW(parser.parse(static_cast<int>(std::size(argv)), std::data(argv)), lwcli::bad_value_conversion);
+
+    ASSERT_EQ(1, reports.size());
+    EXPECT_GT(reports.front().error_time, lwcli::parse_stats::duration::zero());
+    EXPECT_GE(reports.front().n_allocations, 1) << "The exception's message must be allocated.";
+}
+
+TEST_F(InstrumentationTests, CountsAllocations)
+{
+    const std::string value(1000, 'x');
+    const auto argv = std::array{"instrumentation_tests", "-j", "1", value.c_str()};
+    parser.parse(static_cast<int>(std::size(argv)), std::data(argv));
+
+    ASSERT_EQ(1, reports.size());
+    EXPECT_GE(reports.front().n_allocations, 1);
+    EXPECT_GE(reports.front().allocated_bytes, value.size());
+}
+
+TEST(InstrumentationAllocationTests, CountsArrayAllocations)
+{
+    const lwcli::_allocation_count before = lwcli::_thread_allocations;
+    const auto values = std::make_unique<int[]>(100); // NOLINT(cppcoreguidelines-avoid-c-arrays, hicpp-avoid-c-arrays)
+    const lwcli::_allocation_count after = lwcli::_thread_allocations;
+
+    EXPECT_NE(nullptr, values.get());
+    EXPECT_EQ(before.n_allocations + 1, after.n_allocations);
+    EXPECT_GE(after.n_bytes - before.n_bytes, 100 * sizeof(int));
+}
+
+TEST_F(InstrumentationTests, ParseIntoRecordsIntoResult)
+{
+    parser.freeze();
+
+    const auto argv = std::array{"instrumentation_tests", "-q", "-j", "2"};
+    lwcli::ParseResult result;
+    parser.parse_into(static_cast<int>(std::size(argv)), std::data(argv), result);
+    parser.parse_into(static_cast<int>(std::size(argv)), std::data(argv), result);
+
+    ASSERT_EQ(2, reports.size());
+    EXPECT_EQ((std::vector<std::size_t>{0, 1}), reports.back().flag_hits);
+    EXPECT_EQ(0, reports.back().n_allocations) << "A reused result must not allocate.";
+}
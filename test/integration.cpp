@@ -2,8 +2,13 @@
 
 #include <array>
 #include <concepts>
+#include <iterator>
+#include <optional>
+#include <ostream>
 #include <ranges>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 #include "LWCLI/exceptions.hpp"
@@ -48,6 +53,21 @@ requires std::is_same_v<const char*, std::ranges::range_value_t<RangeType>>
     return parse_succeeds(parser, std::vector(std::begin(cstr_view), std::end(cstr_view)));
 }
 
+// As parse_succeeds(...), but parses command_line as a whole, see CLIParser::parse(std::string_view).
+[[nodiscard]] testing::AssertionResult parse_line_succeeds(
+    lwcli::CLIParser& parser,
+    const std::string_view command_line)
+{
+    try {
+        parser.parse(command_line);
+    }
+    catch (const lwcli::bad_parse& e) {
+        return testing::AssertionFailure()
+               << "'" << typeid(lwcli::bad_parse).name() << "' exception thrown with message: " << e.what();
+    }
+    return testing::AssertionSuccess();
+}
+
 TEST(integration, AllOptionTypesHappy)
 {
     lwcli::FlagOption flag_option;
@@ -109,17 +129,211 @@ TEST(interation, DuplicateFlagOptionsHappy)
     EXPECT_EQ(1, other_flag_option.count);
 }
 
-/* Unhappy tests ---------------------------------------------------------------------------------------------------- */
+TEST(integration, FrozenParserHappy)
+{
+    lwcli::FlagOption flag_option;
+    flag_option.aliases = {"-v", "--verbose"};
+    flag_option.description = "Description for option";
 
-template<std::derived_from<lwcli::bad_parse> ExpectedException>
-[[nodiscard]] testing::AssertionResult parse_fails(lwcli::CLIParser& parser, const std::string& args)
+    lwcli::KeyValueOption<int> key_value_option;
+    key_value_option.aliases = {"--value"};
+    key_value_option.description = "Description for key-value option";
+
+    lwcli::PositionalOption<double> positional_option;
+    positional_option.name = "Some random name";
+    positional_option.description = "Description for positional option";
+
+    lwcli::CLIParser parser;
+    parser.register_options(flag_option, key_value_option, positional_option).freeze();
+    ASSERT_TRUE(parser.is_frozen());
+
+    constexpr auto value = "10";
+    constexpr auto positional = "0.31415926";
+    EXPECT_TRUE(parse_succeeds(parser, std::array{"integration", "-v", "--value", value, "--verbose", positional}));
+
+    EXPECT_EQ(2, flag_option.count);
+    EXPECT_EQ(std::stoi(value), key_value_option.value);
+    EXPECT_EQ(std::stod(positional), positional_option.value);
+}
+
+TEST(integration, PositionalSinkCallbackHappy)
 {
-    const std::vector<std::string> arg_list = split_args(args);
-    const auto cstr_view = arg_list | std::views::transform(&std::string::c_str);
-    const auto cstr_args = std::vector(std::begin(cstr_view), std::end(cstr_view));
+    lwcli::PositionalOption<std::string> first;
+    first.name = "first";
+    first.description = "Description for first";
+
+    long long sum = 0;
+    auto sink = lwcli::make_positional_sink<int>([&sum](const int value) { sum += value; });
+    sink.name = "values";
+    sink.description = "Description for values";
+
+    lwcli::FlagOption flag;
+    flag.aliases = {"-v"};
+    flag.description = "Description for flag";
+
+    // Note: the sink only receives positionals once all positional options have been filled, even if it is registered
+    // before them.
+    lwcli::CLIParser parser;
+    parser.register_options(sink, flag, first);
+
+    EXPECT_TRUE(parse_succeeds(parser, "integration first 1 2 -v 3 4"));
+    EXPECT_EQ("first", first.value);
+    EXPECT_EQ(10, sum);
+    EXPECT_EQ(4, sink.count);
+    EXPECT_EQ(1, flag.count);
+}
+
+TEST(integration, PositionalSinkOutputIteratorHappy)
+{
+    std::vector<double> values;
+    auto sink = lwcli::make_positional_sink<double>(std::back_inserter(values));
+    sink.name = "values";
+    sink.description = "Description for values";
+
+    lwcli::CLIParser parser;
+    parser.register_option(sink);
+
+    EXPECT_TRUE(parse_succeeds(parser, "integration 1.5 2.5 -3"));
+    EXPECT_EQ((std::vector{1.5, 2.5, -3.0}), values);
+
+    values.clear();
+    EXPECT_TRUE(parse_line_succeeds(parser, "integration 1.5 '2.5' -3"));
+    EXPECT_EQ((std::vector{1.5, 2.5, -3.0}), values);
+}
 
+TEST(integration, PositionalSinkDescribedLast)
+{
+    auto sink = lwcli::make_positional_sink<int>([](const int /*value*/) {});
+    sink.name = "values";
+    sink.description = "Description for values";
+
+    lwcli::PositionalOption<std::string> first;
+    first.name = "first";
+    first.description = "Description for first";
+
+    lwcli::PositionalOption<std::string> second;
+    second.name = "second";
+    second.description = "Description for second";
+
+    // Note: registered before the positional options, yet only receives the positionals beyond them.
+    lwcli::CLIParser parser;
+    parser.register_options(sink, first, second);
+
+    EXPECT_EQ(
+        "first:\n  Description for first\n\n"
+        "second:\n  Description for second\n\n"
+        "values:\n  Description for values\n\n",
+        parser.help_message());
+}
+
+TEST(integration, HelpTakesPrecedenceOverErrors)
+{
+    lwcli::FlagOption help;
+    help.aliases = {"-h", "--show-help"};
+    help.description = "Clashes with the reserved '-h' alias";
+
+    lwcli::KeyValueOption<int> required;
+    required.aliases = {"--required"};
+    required.description = "Description for required value";
+
+    lwcli::CLIParser parser;
+    parser.register_options(help, required);
+
+    testing::internal::CaptureStdout();
+    EXPECT_TRUE(parse_succeeds(parser, "integration unexpected --required not-an-int -h"));
+    EXPECT_FALSE(testing::internal::GetCapturedStdout().empty());
+
+    // Note: reserved aliases are never matched by user-defined options, though any others they define still are.
+    EXPECT_EQ(0, help.count);
+    EXPECT_TRUE(parse_succeeds(parser, "integration --show-help --required 1"));
+    EXPECT_EQ(1, help.count);
+}
+
+TEST(integration, HelpMessageInRegistrationOrder)
+{
+    lwcli::KeyValueOption<int> value;
+    value.aliases = {"--value", "-h"};
+    value.description = "Description for value";
+
+    lwcli::FlagOption flag;
+    flag.aliases = {"-v", "--verbose"};
+    flag.description = "Description for flag";
+
+    lwcli::PositionalOption<int> positional;
+    positional.name = "positional";
+    positional.description = "Description for positional";
+
+    lwcli::CLIParser parser;
+    parser.register_options(value, flag, positional);
+
+    EXPECT_EQ(
+        "positional:\n  Description for positional\n\n"
+        "--value:\n  Description for value\n\n"
+        "-v | --verbose:\n  Description for flag\n\n",
+        parser.help_message());
+
+    // Note: the cached message must be invalidated upon registration.
+    lwcli::FlagOption other;
+    other.aliases = {"-o"};
+    other.description = std::string(100, 'a');
+    parser.register_option(other);
+
+    const std::string expected_tail = "-o:\n  " + std::string(80, 'a') + "\n  " + std::string(20, 'a') + "\n\n";
+    EXPECT_TRUE(parser.help_message().ends_with(expected_tail));
+}
+
+TEST(integration, HelpOmitsOptionsWithOnlyReservedAliases)
+{
+    lwcli::FlagOption hidden;
+    hidden.aliases = {"-h", "--help"};
+    hidden.description = "Description for hidden";
+
+    lwcli::FlagOption flag;
+    flag.aliases = {"-v"};
+    flag.description = "Description for flag";
+
+    lwcli::CLIParser parser;
+    parser.register_options(hidden, flag);
+
+    EXPECT_EQ("-v:\n  Description for flag\n\n", parser.help_message());
+}
+
+TEST(integration, HelpWrittenToSinkOnce)
+{
+    lwcli::FlagOption flag;
+    flag.aliases = {"-v"};
+    flag.description = "Description for flag";
+
+    struct capture
+    {
+        std::string text;
+        int n_writes = 0;
+    } captured;
+
+    lwcli::CLIParser parser;
+    parser.register_option(flag).redirect_help({
+        [](void* const context, const std::string_view text) {
+            auto& result = *static_cast<capture*>(context);
+            result.text += text;
+            ++result.n_writes;
+        },
+        &captured,
+    });
+
+    EXPECT_TRUE(parse_succeeds(parser, "integration -v --help"));
+    EXPECT_TRUE(parse_succeeds(parser, "integration"));
+    EXPECT_EQ(2, captured.n_writes);
+    EXPECT_EQ(std::string(parser.help_message()) + std::string(parser.help_message()), captured.text);
+}
+
+/* Unhappy tests ---------------------------------------------------------------------------------------------------- */
+
+// Whether invoking parse throws ExpectedException.
+template<std::derived_from<lwcli::bad_parse> ExpectedException, class Parse>
+[[nodiscard]] testing::AssertionResult parse_throws(Parse&& parse)
+{
     try {
-        parser.parse(static_cast<int>(std::size(cstr_args)), std::data(cstr_args));
+        std::forward<Parse>(parse)();
     }
     catch (const ExpectedException&) {
         return testing::AssertionSuccess();
@@ -136,6 +350,24 @@ template<std::derived_from<lwcli::bad_parse> ExpectedException>
     return testing::AssertionFailure() << "No exception was thrown";
 }
 
+template<std::derived_from<lwcli::bad_parse> ExpectedException>
+[[nodiscard]] testing::AssertionResult parse_fails(lwcli::CLIParser& parser, const std::string& args)
+{
+    const std::vector<std::string> arg_list = split_args(args);
+    const auto cstr_view = arg_list | std::views::transform(&std::string::c_str);
+    const auto cstr_args = std::vector(std::begin(cstr_view), std::end(cstr_view));
+
+    return parse_throws<ExpectedException>(
+        [&] { parser.parse(static_cast<int>(std::size(cstr_args)), std::data(cstr_args)); });
+}
+
+// As parse_fails(...), but parses command_line as a whole, see CLIParser::parse(std::string_view).
+template<std::derived_from<lwcli::bad_parse> ExpectedException>
+[[nodiscard]] testing::AssertionResult parse_line_fails(lwcli::CLIParser& parser, const std::string_view command_line)
+{
+    return parse_throws<ExpectedException>([&] { parser.parse(command_line); });
+}
+
 class KeyValueConversionUnhappyTests : public testing::TestWithParam<std::string>
 {};
 
@@ -165,6 +397,7 @@ TEST_P(KeyValueConversionUnhappyTests, BadConversion)
     EXPECT_TRUE(parse_succeeds(parser, std::array{"control", "--value", "10", "--other-value", "21.3"}));
     // Failing case:
     EXPECT_TRUE(parse_fails<lwcli::bad_value_conversion>(parser, GetParam()));
+    EXPECT_TRUE(parse_line_fails<lwcli::bad_value_conversion>(parser, GetParam()));
 }
 
 class BadPositionalUnhappyTests : public testing::TestWithParam<std::string>
@@ -193,6 +426,21 @@ TEST_P(BadPositionalUnhappyTests, BadConversion)
     EXPECT_TRUE(parse_succeeds(parser, std::array{"control", "10", "20.123"}));
     // Failing case:
     EXPECT_TRUE(parse_fails<lwcli::bad_positional_count>(parser, GetParam()));
+    EXPECT_TRUE(parse_line_fails<lwcli::bad_positional_count>(parser, GetParam()));
+}
+
+TEST(integration, PositionalSinkBadConversion)
+{
+    auto sink = lwcli::make_positional_sink<int>([](int) {});
+    sink.name = "values";
+    sink.description = "Description for values";
+
+    lwcli::CLIParser parser;
+    parser.register_option(sink);
+
+    EXPECT_TRUE(parse_succeeds(parser, "control 1 2 3"));
+    EXPECT_TRUE(parse_fails<lwcli::bad_positional_conversion>(parser, "integration 1 2 three"));
+    EXPECT_TRUE(parse_line_fails<lwcli::bad_positional_conversion>(parser, "integration 1 2 three"));
 }
 
 class BadKeyValueFormatUnhappyTests : public testing::TestWithParam<std::string>
@@ -224,6 +472,7 @@ TEST_P(BadKeyValueFormatUnhappyTests, BadFormat)
     EXPECT_TRUE(parse_succeeds(parser, std::array{"control", "--value1", "10", "--value2-1", "12.1"}));
     // Failing case:
     EXPECT_TRUE(parse_fails<lwcli::bad_key_value_format>(parser, GetParam()));
+    EXPECT_TRUE(parse_line_fails<lwcli::bad_key_value_format>(parser, GetParam()));
 }
 
 class RequiredKeyValueTests : public testing::TestWithParam<std::string>
@@ -252,4 +501,215 @@ TEST_P(RequiredKeyValueTests, RequiredKeyValueOptionsUnhappy)
     EXPECT_TRUE(parse_succeeds(parser, std::array{"control", "--required1", "10", "--required2", "20"}));
     // Failing case:
     EXPECT_TRUE(parse_fails<lwcli::bad_required_options>(parser, GetParam()));
+    EXPECT_TRUE(parse_line_fails<lwcli::bad_required_options>(parser, GetParam()));
+}
+
+TEST(integration, FailedConversionKeepsValue)
+{
+    lwcli::KeyValueOption<int> number;
+    number.aliases = {"--n"};
+    number.description = "Description for number";
+    number.value = 5;
+
+    lwcli::KeyValueOption<std::vector<int>> numbers;
+    numbers.aliases = {"--v"};
+    numbers.description = "Description for numbers";
+    numbers.value = {7, 8};
+
+    lwcli::CLIParser parser;
+    parser.register_options(number, numbers);
+
+    // Note: both values begin with a valid prefix, which must not be written.
+    EXPECT_TRUE(parse_fails<lwcli::bad_value_conversion>(parser, "integration --n 12x --v 1,2"));
+    EXPECT_EQ(5, number.value);
+    EXPECT_TRUE(parse_fails<lwcli::bad_value_conversion>(parser, "integration --n 1 --v 1,2,x"));
+    EXPECT_EQ((std::vector<int>{7, 8}), numbers.value);
+
+    number.value = 5;
+    EXPECT_TRUE(parse_line_fails<lwcli::bad_value_conversion>(parser, "integration --n 12x --v 1,2"));
+    EXPECT_EQ(5, number.value);
+}
+
+TEST(integration, RequiredKeyValueOptionsSpanningWords)
+{
+    constexpr std::size_t n_options = 130;
+    constexpr std::size_t missing = 97;
+
+    std::vector<lwcli::KeyValueOption<int>> options(n_options);
+    lwcli::CLIParser parser;
+    for (std::size_t i = 0; i < n_options; ++i) {
+        options[i].aliases = {"--value" + std::to_string(i), "-v" + std::to_string(i)};
+        options[i].description = "Description for value";
+        parser.register_option(options[i]);
+    }
+
+    std::vector<std::string> arg_list = {"integration"};
+    for (std::size_t i = 0; i < n_options; ++i) {
+        if (i != missing)
+            arg_list.insert(arg_list.end(), {"--value" + std::to_string(i), "1"});
+    }
+    const auto cstr_view = arg_list | std::views::transform(&std::string::c_str);
+    const auto cstr_args = std::vector(std::begin(cstr_view), std::end(cstr_view));
+
+    try {
+        parser.parse(static_cast<int>(std::size(cstr_args)), std::data(cstr_args));
+        FAIL() << "No exception was thrown";
+    }
+    catch (const lwcli::bad_required_options& e) {
+        EXPECT_NE(std::string(e.what()).find("--value97 | -v97"), std::string::npos) << e.what();
+    }
+}
+
+/* Non-throwing tests ----------------------------------------------------------------------------------------------- */
+
+struct TryParseCase
+{
+    std::string args;
+    lwcli::parse_errc code;
+    int index;
+    std::string_view argument;
+};
+
+// Note: names each case after its arguments, rather than the bytes of the struct.
+void PrintTo(const TryParseCase& test_case, std::ostream* os)
+{
+    *os << testing::PrintToString(test_case.args);
+}
+
+class TryParseUnhappyTests : public testing::TestWithParam<TryParseCase>
+{};
+
+INSTANTIATE_TEST_SUITE_P(
+    invalid_try_parse_inputs,
+    TryParseUnhappyTests,
+    testing::Values(
+        TryParseCase{"integration --value x --required 1", lwcli::parse_errc::value_conversion, 1, "--value"},
+        TryParseCase{"integration --required 1 --value", lwcli::parse_errc::key_value_format, 3, "--value"},
+        TryParseCase{"integration --required 1 1.5 2", lwcli::parse_errc::positional_count, 4, "2"},
+        TryParseCase{"integration --required 1 abc", lwcli::parse_errc::positional_conversion, 3, "abc"},
+        TryParseCase{"integration -v", lwcli::parse_errc::required_options, 2, "--required"}));
+
+TEST_P(TryParseUnhappyTests, ReportsError)
+{
+    lwcli::FlagOption flag;
+    flag.aliases = {"-v"};
+    flag.description = "Description for flag";
+
+    lwcli::KeyValueOption<std::optional<int>> value;
+    value.aliases = {"--value"};
+    value.description = "Description for value";
+
+    lwcli::KeyValueOption<int> required;
+    required.aliases = {"--required"};
+    required.description = "Description for required value";
+
+    lwcli::PositionalOption<double> positional;
+    positional.name = "positional";
+    positional.description = "Description for positional";
+
+    lwcli::CLIParser parser;
+    parser.register_options(flag, value, required, positional);
+
+    // Control case (non-failing)
+    {
+        constexpr auto argv = std::array{"control", "--value", "10", "--required", "20", "1.5"};
+        EXPECT_TRUE(parser.try_parse(static_cast<int>(std::size(argv)), std::data(argv)).has_value());
+    }
+
+    const auto arg_list = split_args(GetParam().args);
+    const auto cstr_view = arg_list | std::views::transform(&std::string::c_str);
+    const auto cstr_args = std::vector(std::begin(cstr_view), std::end(cstr_view));
+
+    // Note: parsed both as argv, and as a single command-line.
+    for (const auto& result : {
+             parser.try_parse(static_cast<int>(std::size(cstr_args)), std::data(cstr_args)),
+             parser.try_parse(std::string_view(GetParam().args)),
+         }) {
+        ASSERT_FALSE(result.has_value());
+        EXPECT_EQ(GetParam().code, result.error().code);
+        EXPECT_EQ(GetParam().index, result.error().index);
+        EXPECT_EQ(GetParam().argument, result.error().argument);
+        EXPECT_FALSE(result.error().format().empty());
+    }
+}
+
+TEST(integration, TryParseMatchesParseMessage)
+{
+    lwcli::KeyValueOption<int> value;
+    value.aliases = {"--value"};
+    value.description = "Description for value";
+
+    lwcli::CLIParser parser;
+    parser.register_option(value);
+
+    constexpr auto argv = std::array{"integration", "--value", "not-an-int"};
+    const auto result = parser.try_parse(static_cast<int>(std::size(argv)), std::data(argv));
+    ASSERT_FALSE(result.has_value());
+
+    try {
+        parser.parse(static_cast<int>(std::size(argv)), std::data(argv));
+        FAIL() << "No exception was thrown";
+    }
+    catch (const lwcli::bad_value_conversion& e) {
+        EXPECT_EQ(std::string(e.what()), result.error().format());
+    }
+}
+
+TEST(integration, TryParseListsMissingOptions)
+{
+    lwcli::KeyValueOption<int> first;
+    first.aliases = {"--first", "-f"};
+    first.description = "Description for first";
+
+    lwcli::KeyValueOption<int> second;
+    second.aliases = {"--second"};
+    second.description = "Description for second";
+
+    lwcli::FlagOption flag;
+    flag.aliases = {"-v"};
+    flag.description = "Description for flag";
+
+    lwcli::CLIParser parser;
+    parser.register_options(first, second, flag);
+
+    constexpr auto argv = std::array{"integration", "-v"};
+    const auto result = parser.try_parse(static_cast<int>(std::size(argv)), std::data(argv));
+    ASSERT_FALSE(result.has_value());
+    ASSERT_EQ(2, result.error().missing_options.size());
+    EXPECT_NE(result.error().missing_options[0].find("--first"), std::string::npos);
+    EXPECT_NE(result.error().missing_options[0].find("-f"), std::string::npos);
+    EXPECT_EQ("--second", result.error().missing_options[1]);
+
+    try {
+        parser.parse(static_cast<int>(std::size(argv)), std::data(argv));
+        FAIL() << "No exception was thrown";
+    }
+    catch (const lwcli::bad_required_options& e) {
+        EXPECT_EQ(std::string(e.what()), result.error().format());
+    }
+}
+
+TEST(integration, TryParseErrorOutlivesNextParse)
+{
+    lwcli::KeyValueOption<int> first;
+    first.aliases = {"--a"};
+    first.description = "Description for first";
+
+    lwcli::KeyValueOption<int> second;
+    second.aliases = {"--b"};
+    second.description = "Description for second";
+
+    lwcli::CLIParser parser;
+    parser.register_options(first, second);
+
+    constexpr auto failing_argv = std::array{"integration", "--a", "1"};
+    const auto failed = parser.try_parse(static_cast<int>(std::size(failing_argv)), std::data(failing_argv));
+    ASSERT_FALSE(failed.has_value());
+    const std::string message = failed.error().format();
+
+    constexpr auto argv = std::array{"integration", "--a", "1", "--b", "2"};
+    ASSERT_TRUE(parser.try_parse(static_cast<int>(std::size(argv)), std::data(argv)).has_value());
+
+    EXPECT_EQ(message, failed.error().format());
+    EXPECT_NE(message.find("--b"), std::string::npos) << message;
 }
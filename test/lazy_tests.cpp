@@ -0,0 +1,202 @@
+#include "gtest/gtest.h" // cppcheck-suppress [missingInclude]
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "LWCLI/cast.hpp"
+#include "LWCLI/exceptions.hpp"
+#include "LWCLI/lazy_options.hpp"
+#include "LWCLI/options.hpp"
+#include "LWCLI/parse_result.hpp"
+#include "LWCLI/parser.hpp"
+
+namespace
+{
+// A value whose every conversion is counted, standing in for an expensive user-defined cast.
+struct counted
+{
+    int value = 0;
+
+    static inline int n_conversions = 0;
+};
+} // namespace
+
+template<>
+struct lwcli::cast<counted>
+{
+    [[nodiscard]] static std::errc try_from_string(const std::string_view str, counted& result)
+    {
+        ++counted::n_conversions;
+        return lwcli::cast<int>::try_from_string(str, result.value);
+    }
+};
+
+class LazyTests : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        counted::n_conversions = 0;
+
+        level.aliases = {"-l", "--level"};
+        level.description = "Description for level";
+
+        name.aliases = {"-n", "--name"};
+        name.description = "Description for name";
+
+        input.name = "input";
+        input.description = "Description for input";
+
+        parser.register_options(level, name, input);
+    }
+
+    void parse(const std::vector<const char*>& argv)
+    {
+        parser.parse(static_cast<int>(argv.size()), argv.data());
+    }
+
+    lwcli::LazyKeyValueOption<counted> level;
+    lwcli::LazyKeyValueOption<std::optional<std::string>> name;
+    lwcli::LazyPositionalOption<std::optional<counted>> input;
+    lwcli::CLIParser parser;
+};
+
+TEST_F(LazyTests, ConvertsOnceUponFirstAccess)
+{
+    ASSERT_NO_THROW(parse({"lazy_tests", "--level", "3", "7"}));
+    EXPECT_EQ(0, counted::n_conversions);
+    EXPECT_TRUE(level.given());
+    EXPECT_EQ("3", level.argument());
+
+    EXPECT_EQ(3, level.value().value);
+    EXPECT_EQ(3, level.value().value);
+    EXPECT_EQ(1, counted::n_conversions);
+
+    ASSERT_TRUE(input.value().has_value());
+    EXPECT_EQ(7, input.value()->value);
+    EXPECT_EQ(2, counted::n_conversions);
+}
+
+TEST_F(LazyTests, OptionsNotGivenHoldTheirDefault)
+{
+    name.set_default("default");
+
+    ASSERT_NO_THROW(parse({"lazy_tests", "-l", "1"}));
+    EXPECT_FALSE(name.given());
+    EXPECT_EQ("default", name.value());
+    EXPECT_FALSE(input.value().has_value());
+
+    ASSERT_NO_THROW(parse({"lazy_tests", "-l", "1", "-n", "given"}));
+    EXPECT_EQ("given", name.value());
+
+    // Note: each parse discards the arguments of the last, whether or not they were accessed.
+    ASSERT_NO_THROW(parse({"lazy_tests", "-l", "2"}));
+    EXPECT_EQ("default", name.value());
+}
+
+TEST_F(LazyTests, ReportsConversionErrorsUponAccess)
+{
+    ASSERT_NO_THROW(parse({"lazy_tests", "--level=high", "seven"}));
+
+    try {
+        static_cast<void>(level.value());
+        FAIL() << "Expected bad_value_conversion";
+    }
+    catch (const lwcli::bad_value_conversion& error) {
+        EXPECT_NE(std::string(error.what()).find("--level"), std::string::npos);
+        EXPECT_EQ("high", error.value);
+    }
+    // Note: failures are not cached, the conversion is attempted again.
+    EXPECT_THROW(static_cast<void>(level.value()), lwcli::bad_value_conversion);
+    EXPECT_EQ(2, counted::n_conversions);
+
+    EXPECT_THROW(static_cast<void>(input.value()), lwcli::bad_positional_conversion);
+}
+
+TEST_F(LazyTests, RequiredUnlessOptional)
+{
+    EXPECT_THROW(parse({"lazy_tests", "-n", "a"}), lwcli::bad_required_options);
+    EXPECT_NO_THROW(parse({"lazy_tests", "-l", "1"}));
+}
+
+TEST_F(LazyTests, ValidateAllConvertsEagerly)
+{
+    parser.validate_all();
+
+    ASSERT_NO_THROW(parse({"lazy_tests", "--level", "3", "7"}));
+    EXPECT_EQ(2, counted::n_conversions);
+    // Note: the values converted by the parse are cached.
+    EXPECT_EQ(3, level.value().value);
+    EXPECT_EQ(7, input.value()->value);
+    EXPECT_EQ(2, counted::n_conversions);
+
+    const auto argv = std::array{"lazy_tests", "-n", "a", "--level", "high"};
+    const auto result = parser.try_parse(static_cast<int>(argv.size()), argv.data());
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(lwcli::parse_errc::value_conversion, result.error().code);
+    EXPECT_EQ(3, result.error().index);
+    EXPECT_EQ("--level", result.error().argument);
+    EXPECT_EQ("high", result.error().value);
+
+    EXPECT_THROW(parse({"lazy_tests", "-l", "1", "seven"}), lwcli::bad_positional_conversion);
+
+    parser.validate_all(false);
+    EXPECT_NO_THROW(parse({"lazy_tests", "-l", "1", "seven"}));
+}
+
+TEST_F(LazyTests, ReadsOtherSources)
+{
+    const auto path = std::filesystem::temp_directory_path()
+                      / ("lwcli_lazy_tests_" + std::to_string(reinterpret_cast<std::uintptr_t>(this)) + ".ini");
+    std::ofstream(path, std::ios::binary) << "name = from file\n";
+    parser.config_file(path.string());
+
+    ASSERT_NO_THROW(parse({"lazy_tests", "-l", "5"}));
+    EXPECT_EQ("from file", name.value());
+    EXPECT_EQ(0, counted::n_conversions);
+
+    std::filesystem::remove(path);
+}
+
+TEST_F(LazyTests, ParsesIntoResult)
+{
+    parser.freeze();
+
+    lwcli::ParseResult result;
+    const auto argv = std::array{"lazy_tests", "-l", "4", "-n", "a"};
+    ASSERT_NO_THROW(parser.parse_into(static_cast<int>(argv.size()), argv.data(), result));
+    EXPECT_EQ(0, counted::n_conversions);
+
+    EXPECT_EQ(4, result[parser.handle_of(level)].value().value);
+    EXPECT_EQ("a", result[parser.handle_of(name)].value());
+    EXPECT_FALSE(result[parser.handle_of(input)].value().has_value());
+    EXPECT_EQ(1, counted::n_conversions);
+
+    // Note: the registered options are left untouched.
+    EXPECT_FALSE(level.given());
+}
+
+TEST_F(LazyTests, ReusedResultHoldsDefaultsOfOptionsNotGiven)
+{
+    name.set_default("default");
+    parser.freeze();
+
+    lwcli::ParseResult result;
+    const auto argv = std::array{"lazy_tests", "-l", "4", "-n", "a"};
+    ASSERT_NO_THROW(parser.parse_into(static_cast<int>(argv.size()), argv.data(), result));
+    EXPECT_EQ("a", result[parser.handle_of(name)].value());
+
+    // Note: the argument recorded by the last parse is discarded, rather than read back.
+    const auto argv2 = std::array{"lazy_tests", "-l", "6"};
+    ASSERT_NO_THROW(parser.parse_into(static_cast<int>(argv2.size()), argv2.data(), result));
+    EXPECT_FALSE(result[parser.handle_of(name)].given());
+    EXPECT_EQ("default", result[parser.handle_of(name)].value());
+    EXPECT_EQ(6, result[parser.handle_of(level)].value().value);
+}
@@ -0,0 +1,185 @@
+#include "gtest/gtest.h" // cppcheck-suppress [missingInclude]
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "LWCLI/exceptions.hpp"
+#include "LWCLI/options.hpp"
+#include "LWCLI/parse_result.hpp"
+#include "LWCLI/parser.hpp"
+
+class ParseResultTests : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        verbose.aliases = {"-v", "--verbose"};
+        verbose.description = "Description for verbose";
+
+        threads.aliases = {"-j", "--threads"};
+        threads.description = "Description for threads";
+
+        name.aliases = {"--name"};
+        name.description = "Description for name";
+        name.value = "default";
+
+        input.name = "input";
+        input.description = "Description for input";
+
+        parser.register_options(verbose, threads, name, input).freeze();
+    }
+
+    lwcli::FlagOption verbose;
+    lwcli::KeyValueOption<int> threads;
+    lwcli::KeyValueOption<std::optional<std::string>> name;
+    lwcli::PositionalOption<std::string> input;
+    lwcli::CLIParser parser;
+};
+
+TEST_F(ParseResultTests, OptionsAreNotWritten)
+{
+    const auto argv = std::array{"parse_result_tests", "-v", "input.txt", "--verbose", "-j", "4"};
+
+    lwcli::ParseResult result;
+    ASSERT_NO_THROW(parser.parse_into(static_cast<int>(std::size(argv)), std::data(argv), result));
+
+    EXPECT_EQ(2, result[parser.handle_of(verbose)]);
+    EXPECT_EQ(4, result[parser.handle_of(threads)]);
+    EXPECT_EQ("input.txt", result[parser.handle_of(input)]);
+    EXPECT_FALSE(result.help_requested());
+
+    EXPECT_EQ(0, verbose.count);
+    EXPECT_EQ(0, threads.value);
+    EXPECT_EQ("", input.value);
+}
+
+TEST_F(ParseResultTests, AbsentOptionsReadAsDefaults)
+{
+    lwcli::ParseResult result;
+    const auto first_argv = std::array{"parse_result_tests", "-j", "1", "--name", "first", "-v"};
+    parser.parse_into(static_cast<int>(std::size(first_argv)), std::data(first_argv), result);
+
+    // Note: the values of the first parse must not leak into the second.
+    const auto second_argv = std::array{"parse_result_tests", "-j", "2"};
+    parser.parse_into(static_cast<int>(std::size(second_argv)), std::data(second_argv), result);
+
+    const auto name_handle = parser.handle_of(name);
+    EXPECT_FALSE(result.contains(name_handle));
+    EXPECT_EQ("default", result[name_handle]);
+    EXPECT_FALSE(result.contains(parser.handle_of(input)));
+    EXPECT_TRUE(result.contains(parser.handle_of(threads)));
+    EXPECT_EQ(0, result[parser.handle_of(verbose)]);
+}
+
+TEST_F(ParseResultTests, UnparsedResultsReadAsDefaults)
+{
+    const auto check_defaults = [this](const lwcli::ParseResult& result) {
+        EXPECT_EQ(0, result[parser.handle_of(verbose)]);
+        EXPECT_FALSE(result.contains(parser.handle_of(threads)));
+        EXPECT_EQ(0, result[parser.handle_of(threads)]);
+        EXPECT_EQ("default", result[parser.handle_of(name)]);
+        EXPECT_EQ("", result[parser.handle_of(input)]);
+        EXPECT_FALSE(result.help_requested());
+    };
+
+    const lwcli::ParseResult unparsed;
+    check_defaults(unparsed);
+
+    lwcli::ParseResult parsed;
+    const auto argv = std::array{"parse_result_tests", "-v", "-j", "4", "input.txt"};
+    parser.parse_into(static_cast<int>(std::size(argv)), std::data(argv), parsed);
+    const lwcli::ParseResult moved_to(std::move(parsed));
+    EXPECT_EQ(4, moved_to[parser.handle_of(threads)]);
+    // NOLINTNEXTLINE(bugprone-use-after-move, hicpp-invalid-access-moved)
+    check_defaults(parsed);
+}
+
+TEST_F(ParseResultTests, ReportsErrors)
+{
+    lwcli::ParseResult result;
+
+    const auto bad_value_argv = std::array{"parse_result_tests", "-j", "many"};
+    const auto error = parser.try_parse_into(
+        static_cast<int>(std::size(bad_value_argv)),
+        std::data(bad_value_argv),
+        result);
+    ASSERT_FALSE(error.has_value());
+    EXPECT_EQ(lwcli::parse_errc::value_conversion, error.error().code);
+    EXPECT_EQ(1, error.error().index);
+
+    try {
+        const auto argv = std::array{"parse_result_tests", "-v"};
+        parser.parse_into(static_cast<int>(std::size(argv)), std::data(argv), result);
+        FAIL() << "No exception was thrown";
+    }
+    catch (const lwcli::bad_required_options& e) {
+        EXPECT_NE(std::string(e.what()).find("-j | --threads"), std::string::npos) << e.what();
+    }
+}
+
+TEST_F(ParseResultTests, HelpIsReportedNotPrinted)
+{
+    const auto argv = std::array{"parse_result_tests", "-j", "many", "--help"};
+
+    lwcli::ParseResult result;
+    testing::internal::CaptureStdout();
+    EXPECT_NO_THROW(parser.parse_into(static_cast<int>(std::size(argv)), std::data(argv), result));
+    EXPECT_EQ("", testing::internal::GetCapturedStdout());
+    EXPECT_TRUE(result.help_requested());
+}
+
+TEST_F(ParseResultTests, ConcurrentParses)
+{
+    static constexpr int N_THREADS = 8;
+    static constexpr int N_ITERATIONS = 1000;
+
+    std::array<lwcli::ParseResult, N_THREADS> results;
+    std::array<bool, N_THREADS> correct{};
+    std::vector<std::thread> workers;
+
+    const lwcli::CLIParser& schema = parser;
+    for (int thread = 0; thread < N_THREADS; ++thread) {
+        workers.emplace_back([&, thread] {
+            const std::string value = std::to_string(thread);
+            const auto argv = std::array{"parse_result_tests", "-j", value.c_str(), value.c_str(), "-v"};
+
+            correct[thread] = true;
+            for (int i = 0; i < N_ITERATIONS; ++i) {
+                schema.parse_into(static_cast<int>(std::size(argv)), std::data(argv), results[thread]);
+                correct[thread] = correct[thread] && results[thread][schema.handle_of(threads)] == thread
+                                  && results[thread][schema.handle_of(input)] == value
+                                  && results[thread][schema.handle_of(verbose)] == 1;
+            }
+        });
+    }
+
+    for (std::thread& worker : workers)
+        worker.join();
+
+    for (int thread = 0; thread < N_THREADS; ++thread)
+        EXPECT_TRUE(correct[thread]) << "thread " << thread;
+}
+
+TEST(ParseResultLifetimeTests, OutlivesParser)
+{
+    lwcli::KeyValueOption<std::string> name;
+    name.aliases = {"--name"};
+    name.description = "Description for name";
+
+    lwcli::ParseResult result;
+    {
+        auto parser = std::make_unique<lwcli::CLIParser>();
+        parser->register_option(name).freeze();
+
+        const auto argv = std::array{"parse_result_tests", "--name", "a name long enough to be allocated on the heap"};
+        parser->parse_into(static_cast<int>(std::size(argv)), std::data(argv), result);
+    }
+
+    lwcli::ParseResult moved = std::move(result);
+    EXPECT_FALSE(moved.help_requested());
+}
@@ -0,0 +1,69 @@
+#include "gtest/gtest.h" // cppcheck-suppress [missingInclude]
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "LWCLI/_perfect_hash.hpp"
+
+TEST(FrozenStringMapTests, EmptyMap)
+{
+    const lwcli::_frozen_string_map<int> map(std::vector<std::pair<std::string, int>>{});
+
+    EXPECT_EQ(0, map.size());
+    EXPECT_EQ(nullptr, map.find(""));
+    EXPECT_EQ(nullptr, map.find("--value"));
+}
+
+TEST(FrozenStringMapTests, FindsEveryKey)
+{
+    constexpr int n_keys = 10'000;
+
+    std::vector<std::pair<std::string, int>> entries;
+    for (int i = 0; i < n_keys; ++i)
+        entries.emplace_back("--option-" + std::to_string(i), i);
+
+    const lwcli::_frozen_string_map<int> map(entries);
+    ASSERT_EQ(n_keys, map.size());
+
+    for (const auto& [key, value] : entries) {
+        const int* const found = map.find(key);
+        ASSERT_NE(nullptr, found) << "Key '" << key << "' not found";
+        EXPECT_EQ(value, *found);
+    }
+}
+
+TEST(FrozenStringMapTests, RejectsMissingKeys)
+{
+    const std::vector<std::pair<std::string, int>> entries = {{"-v", 0}, {"--verbose", 1}, {"--value", 2}};
+    const lwcli::_frozen_string_map<int> map(entries);
+
+    for (const auto* const missing : {"", "-", "--", "-V", "--verbos", "--verbose ", "--values", "v", "--value\n"})
+        EXPECT_EQ(nullptr, map.find(missing)) << "Unexpectedly found '" << missing << "'";
+}
+
+TEST(StaticPerfectHashTests, HashesMatchAtRuntime)
+{
+    constexpr auto hash = lwcli::_hash_bytes("--a-key-longer-than-a-word", 42);
+    const std::string key = "--a-key-longer-than-a-word";
+    EXPECT_EQ(hash, lwcli::_hash_bytes(key, 42));
+}
+
+TEST(StaticPerfectHashTests, FindsEveryKey)
+{
+    static constexpr std::array<std::string_view, 7> KEYS = {
+        "-h", "--help", "-v", "--verbose", "--version", "--value", "--a-key-longer-than-a-word"};
+    static constexpr lwcli::_static_perfect_hash<KEYS.size()> HASH(KEYS);
+
+    static_assert(HASH.find("--version", KEYS) == 4);
+    for (std::uint32_t i = 0; i < KEYS.size(); ++i) {
+        const std::string key(KEYS[i]);
+        EXPECT_EQ(i, HASH.find(key, KEYS)) << "For key: " << key;
+    }
+
+    for (const std::string_view key : {"", "-", "--", "--verb", "--verbosely", "-V", "--a-key-longer-than-a-wore"})
+        EXPECT_EQ(HASH.NO_KEY, HASH.find(key, KEYS)) << "For key: " << key;
+}
@@ -0,0 +1,226 @@
+#include "gtest/gtest.h" // cppcheck-suppress [missingInclude]
+
+#include <array>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "LWCLI/_prefix_trie.hpp"
+#include "LWCLI/exceptions.hpp"
+#include "LWCLI/options.hpp"
+#include "LWCLI/parse_result.hpp"
+#include "LWCLI/parser.hpp"
+
+/* Trie tests ------------------------------------------------------------------------------------------------------- */
+
+TEST(PrefixTrieTests, EmptyTrie)
+{
+    const lwcli::_prefix_trie<int> trie(std::vector<std::pair<std::string, int>>{});
+
+    EXPECT_TRUE(trie.empty());
+    EXPECT_EQ(lwcli::_prefix_status::NONE, trie.find("").status);
+    EXPECT_EQ(lwcli::_prefix_status::NONE, trie.find("--value").status);
+}
+
+TEST(PrefixTrieTests, ResolvesPrefixes)
+{
+    const std::vector<std::pair<std::string, int>> entries = {
+        {"--verbose", 0},
+        {"--version", 1},
+        {"--value", 2},
+        {"--val", 3},
+        {"--quiet", 4},
+        {"--quiet-mode", 4},
+    };
+    const lwcli::_prefix_trie<int> trie(entries);
+
+    for (const auto& [prefix, value] : std::vector<std::pair<std::string_view, int>>{
+             {"--verb", 0},
+             {"--verbose", 0},
+             {"--vers", 1},
+             {"--valu", 2},
+             {"--q", 4},
+             {"--quiet-m", 4},
+         }) {
+        const auto match = trie.find(prefix);
+        EXPECT_EQ(lwcli::_prefix_status::UNIQUE, match.status) << "For prefix: " << prefix;
+        EXPECT_EQ(value, match.value) << "For prefix: " << prefix;
+    }
+
+    // Note: '--val' is both a key, and the prefix of another.
+    for (const std::string_view prefix : {"-", "--", "--v", "--ver", "--val"})
+        EXPECT_EQ(lwcli::_prefix_status::AMBIGUOUS, trie.find(prefix).status) << "For prefix: " << prefix;
+
+    for (const std::string_view prefix : {"--verbosely", "--x", "--quiet-modes", "-v", "verb"})
+        EXPECT_EQ(lwcli::_prefix_status::NONE, trie.find(prefix).status) << "For prefix: " << prefix;
+}
+
+TEST(PrefixTrieTests, MatchesBruteForce)
+{
+    static constexpr std::string_view ALPHABET = "ab-";
+
+    std::mt19937 engine(42); // NOLINT(cert-msc32-c, cert-msc51-cpp)
+    std::uniform_int_distribution<std::size_t> length(0, 8);
+    std::uniform_int_distribution<std::size_t> character(0, ALPHABET.size() - 1);
+    std::uniform_int_distribution<int> value(0, 3);
+
+    const auto random_string = [&] {
+        std::string str(length(engine), '\0');
+        for (char& chr : str)
+            chr = ALPHABET[character(engine)];
+        return str;
+    };
+
+    for (int i = 0; i < 200; ++i) {
+        std::vector<std::pair<std::string, int>> entries;
+        for (int j = 0; j < 50; ++j) {
+            std::string key = random_string();
+            if (std::ranges::find(entries, key, &std::pair<std::string, int>::first) == entries.end())
+                entries.emplace_back(std::move(key), value(engine));
+        }
+        const lwcli::_prefix_trie<int> trie(entries);
+
+        for (int j = 0; j < 50; ++j) {
+            const std::string prefix = random_string();
+
+            lwcli::_prefix_match<int> expected;
+            for (const auto& [key, key_value] : entries) {
+                if (!key.starts_with(prefix))
+                    continue;
+                if (expected.status == lwcli::_prefix_status::NONE)
+                    expected = {lwcli::_prefix_status::UNIQUE, key_value};
+                else if (expected.value != key_value)
+                    expected = {lwcli::_prefix_status::AMBIGUOUS, 0};
+            }
+
+            const auto match = trie.find(prefix);
+            ASSERT_EQ(expected.status, match.status) << "For prefix: " << prefix;
+            ASSERT_EQ(expected.value, match.value) << "For prefix: " << prefix;
+        }
+    }
+}
+
+/* Parser tests ----------------------------------------------------------------------------------------------------- */
+
+class PrefixMatchingTests : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        verbose.aliases = {"-v", "--verbose"};
+        verbose.description = "Description for verbose";
+
+        version.aliases = {"--version"};
+        version.description = "Description for version";
+
+        threads.aliases = {"-j", "--threads", "--thread-count"};
+        threads.description = "Description for threads";
+
+        input.name = "input";
+        input.description = "Description for input";
+
+        parser.register_options(verbose, version, threads, input).match_prefixes();
+    }
+
+    void parse(const std::vector<const char*>& argv)
+    {
+        parser.parse(static_cast<int>(argv.size()), argv.data());
+    }
+
+    lwcli::FlagOption verbose;
+    lwcli::FlagOption version;
+    lwcli::KeyValueOption<std::optional<int>> threads;
+    lwcli::PositionalOption<std::string> input;
+    lwcli::CLIParser parser;
+};
+
+TEST_F(PrefixMatchingTests, MatchesUnambiguousPrefixes)
+{
+    ASSERT_NO_THROW(parse({"prefix_tests", "--verb", "--vers", "--verbose", "--thr", "4", "file.txt"}));
+
+    EXPECT_EQ(2, verbose.count);
+    EXPECT_EQ(1, version.count);
+    EXPECT_EQ(4, threads.value);
+    EXPECT_EQ("file.txt", input.value);
+}
+
+TEST_F(PrefixMatchingTests, PrefixesOfSeveralAliasesOfOneOptionAreUnambiguous)
+{
+    // Note: '--thread' abbreviates both '--threads' and '--thread-count'.
+    ASSERT_NO_THROW(parse({"prefix_tests", "--thread", "8"}));
+    EXPECT_EQ(8, threads.value);
+}
+
+TEST_F(PrefixMatchingTests, ReportsAmbiguousPrefixes)
+{
+    try {
+        parse({"prefix_tests", "--ver"});
+        FAIL() << "Expected bad_ambiguous_prefix";
+    }
+    catch (const lwcli::bad_ambiguous_prefix& error) {
+        EXPECT_EQ((std::vector<std::string>{"--verbose", "--version"}), error.candidates);
+    }
+
+    const auto argv = std::array{"prefix_tests", "-v", "--ver"};
+    const auto result = parser.try_parse(static_cast<int>(argv.size()), argv.data());
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(lwcli::parse_errc::ambiguous_prefix, result.error().code);
+    EXPECT_EQ(2, result.error().index);
+    EXPECT_EQ("--ver", result.error().argument);
+}
+
+TEST_F(PrefixMatchingTests, OnlyLongAliasesAreAbbreviated)
+{
+    // Note: neither '-' nor '--' abbreviate anything, and short aliases are never abbreviated.
+    EXPECT_THROW(parse({"prefix_tests", "-", "--"}), lwcli::bad_positional_count);
+    EXPECT_THROW(parse({"prefix_tests", "--unknown", "-x"}), lwcli::bad_positional_count);
+}
+
+TEST_F(PrefixMatchingTests, AbbreviatedHelpTakesPrecedence)
+{
+    std::string help;
+    parser.redirect_help({[](void* const context, const std::string_view text) {
+                              *static_cast<std::string*>(context) = text;
+                          },
+                          &help});
+
+    ASSERT_NO_THROW(parse({"prefix_tests", "--ver", "--he"}));
+    EXPECT_FALSE(help.empty());
+}
+
+TEST_F(PrefixMatchingTests, CanBeDisabled)
+{
+    parser.match_prefixes(false);
+
+    ASSERT_NO_THROW(parse({"prefix_tests", "--verb"}));
+    EXPECT_EQ(0, verbose.count);
+    EXPECT_EQ("--verb", input.value);
+}
+
+TEST_F(PrefixMatchingTests, RegistrationReindexesPrefixes)
+{
+    parse({"prefix_tests", "--verb"});
+
+    lwcli::FlagOption verbatim;
+    verbatim.aliases = {"--verbatim"};
+    verbatim.description = "Description for verbatim";
+    parser.register_option(verbatim);
+
+    EXPECT_THROW(parse({"prefix_tests", "--verb"}), lwcli::bad_ambiguous_prefix);
+    ASSERT_NO_THROW(parse({"prefix_tests", "--verba"}));
+    EXPECT_EQ(1, verbatim.count);
+}
+
+TEST_F(PrefixMatchingTests, ParsesIntoResult)
+{
+    parser.freeze();
+
+    const auto argv = std::array{"prefix_tests", "--verb", "--threads", "2"};
+    lwcli::ParseResult result;
+    ASSERT_NO_THROW(parser.parse_into(static_cast<int>(argv.size()), argv.data(), result));
+    EXPECT_EQ(1, result[parser.handle_of(verbose)]);
+    EXPECT_EQ(2, result[parser.handle_of(threads)]);
+}
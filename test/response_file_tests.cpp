@@ -0,0 +1,221 @@
+#include "gtest/gtest.h" // cppcheck-suppress [missingInclude]
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "LWCLI/_tokenizer.hpp"
+#include "LWCLI/exceptions.hpp"
+#include "LWCLI/options.hpp"
+#include "LWCLI/parser.hpp"
+
+/* Tokenizer tests -------------------------------------------------------------------------------------------------- */
+
+[[nodiscard]] std::vector<std::string> tokenize(std::string buffer)
+{
+    std::vector<std::string> result;
+    char* cursor = buffer.data();
+    char* const end = cursor + buffer.size();
+
+    std::string_view token;
+    lwcli::_token_status status{};
+    while ((status = lwcli::_next_shell_token(cursor, end, token)) == lwcli::_token_status::TOKEN)
+        result.emplace_back(token);
+
+    EXPECT_EQ(lwcli::_token_status::END, status);
+    return result;
+}
+
+struct TokenizeCase
+{
+    std::string input;
+    std::vector<std::string> expected;
+};
+
+// Note: names each case after its input, rather than the bytes of the struct.
+void PrintTo(const TokenizeCase& test_case, std::ostream* os)
+{
+    *os << testing::PrintToString(test_case.input);
+}
+
+class InPlaceTokenizerTests : public testing::TestWithParam<TokenizeCase>
+{};
+
+INSTANTIATE_TEST_SUITE_P(
+    shell_quoting,
+    InPlaceTokenizerTests,
+    testing::Values(
+        TokenizeCase{"", {}},
+        TokenizeCase{" \t\n ", {}},
+        TokenizeCase{"-v --value 10", {"-v", "--value", "10"}},
+        TokenizeCase{"  leading\r\ntrailing  ", {"leading", "trailing"}},
+        TokenizeCase{"'single quoted' \"double quoted\"", {"single quoted", "double quoted"}},
+        TokenizeCase{"con'cat'\"enated\"", {"concatenated"}},
+        TokenizeCase{"'' \"\"", {"", ""}},
+        TokenizeCase{R"('no \"escapes\" \here')", {R"(no \"escapes\" \here)"}},
+        TokenizeCase{R"("\"escaped\" \n \\ \$")", {R"("escaped" \n \ $)"}},
+        TokenizeCase{R"(unquoted\ space \'quote\')", {"unquoted space", "'quote'"}},
+        TokenizeCase{"line\\\ncontinuation", {"linecontinuation"}},
+        TokenizeCase{"trailing\\", {"trailing\\"}}));
+
+TEST_P(InPlaceTokenizerTests, Tokenizes)
+{
+    EXPECT_EQ(GetParam().expected, tokenize(GetParam().input));
+}
+
+TEST(InPlaceTokenizerTest, UnterminatedQuote)
+{
+    for (std::string input : {"'unterminated", "\"unterminated", "ok \"unterminated\\\""}) {
+        char* cursor = input.data();
+        char* const end = cursor + input.size();
+
+        std::string_view token;
+        lwcli::_token_status status{};
+        while ((status = lwcli::_next_shell_token(cursor, end, token)) == lwcli::_token_status::TOKEN) {}
+        EXPECT_EQ(lwcli::_token_status::UNTERMINATED_QUOTE, status) << "For input: " << input;
+    }
+}
+
+TEST(InPlaceTokenizerTest, PlainTokensAreNotWritten)
+{
+    // Note: tokens without quotes or escapes must be returned as views into the original buffer.
+    std::string buffer = "first second";
+    char* cursor = buffer.data();
+
+    std::string_view token;
+    ASSERT_EQ(lwcli::_token_status::TOKEN, lwcli::_next_shell_token(cursor, buffer.data() + buffer.size(), token));
+    EXPECT_EQ(buffer.data(), token.data());
+    ASSERT_EQ(lwcli::_token_status::TOKEN, lwcli::_next_shell_token(cursor, buffer.data() + buffer.size(), token));
+    EXPECT_EQ(buffer.data() + 6, token.data());
+}
+
+/* Response file tests ---------------------------------------------------------------------------------------------- */
+
+class ResponseFileTests : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        _directory = std::filesystem::temp_directory_path()
+                     / ("lwcli_response_file_tests_" + std::to_string(reinterpret_cast<std::uintptr_t>(this)));
+        std::filesystem::create_directories(_directory);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(_directory);
+    }
+
+    [[nodiscard]] std::string write_file(const std::string& name, const std::string& contents) const
+    {
+        const auto path = _directory / name;
+        std::ofstream(path, std::ios::binary) << contents;
+        return path.string();
+    }
+
+private:
+    std::filesystem::path _directory;
+};
+
+TEST_F(ResponseFileTests, ExpandsArguments)
+{
+    lwcli::FlagOption flag;
+    flag.aliases = {"-v"};
+    flag.description = "Description for flag";
+
+    lwcli::KeyValueOption<std::string> value;
+    value.aliases = {"--value"};
+    value.description = "Description for value";
+
+    lwcli::PositionalOption<int> positional;
+    positional.name = "positional";
+    positional.description = "Description for positional";
+
+    lwcli::CLIParser parser;
+    parser.register_options(flag, value, positional).expand_response_files();
+
+    const auto nested = "@" + write_file("nested.rsp", "-v\n10");
+    const auto outer = "@" + write_file("outer.rsp", "-v --value 'quoted value'\n" + nested);
+
+    const auto argv = std::array{"response_file_tests", outer.c_str(), "-v"};
+    ASSERT_NO_THROW(parser.parse(static_cast<int>(std::size(argv)), std::data(argv)));
+
+    EXPECT_EQ(3, flag.count);
+    EXPECT_EQ("quoted value", value.value);
+    EXPECT_EQ(10, positional.value);
+}
+
+TEST_F(ResponseFileTests, ValueSpansResponseFileBoundary)
+{
+    lwcli::KeyValueOption<int> value;
+    value.aliases = {"--value"};
+    value.description = "Description for value";
+
+    lwcli::CLIParser parser;
+    parser.register_option(value).expand_response_files();
+
+    const auto file = "@" + write_file("key.rsp", "--value");
+    const auto argv = std::array{"response_file_tests", file.c_str(), "42"};
+    ASSERT_NO_THROW(parser.parse(static_cast<int>(std::size(argv)), std::data(argv)));
+    EXPECT_EQ(42, value.value);
+}
+
+TEST_F(ResponseFileTests, DisabledByDefault)
+{
+    lwcli::PositionalOption<std::string> positional;
+    positional.name = "positional";
+    positional.description = "Description for positional";
+
+    lwcli::CLIParser parser;
+    parser.register_option(positional);
+
+    const auto file = "@" + write_file("unused.rsp", "ignored");
+    const auto argv = std::array{"response_file_tests", file.c_str()};
+    ASSERT_NO_THROW(parser.parse(static_cast<int>(std::size(argv)), std::data(argv)));
+    EXPECT_EQ(file, positional.value);
+}
+
+TEST_F(ResponseFileTests, ErrorsReferToResponseFileArgument)
+{
+    lwcli::KeyValueOption<int> value;
+    value.aliases = {"--value"};
+    value.description = "Description for value";
+
+    lwcli::CLIParser parser;
+    parser.register_option(value).expand_response_files();
+
+    const auto file = "@" + write_file("bad_value.rsp", "--value not-an-int");
+    const auto argv = std::array{"response_file_tests", "--value", "1", file.c_str()};
+    const auto result = parser.try_parse(static_cast<int>(std::size(argv)), std::data(argv));
+
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(lwcli::parse_errc::value_conversion, result.error().code);
+    EXPECT_EQ(3, result.error().index);
+    EXPECT_EQ("not-an-int", result.error().value);
+}
+
+TEST_F(ResponseFileTests, UnreadableResponseFiles)
+{
+    lwcli::FlagOption flag;
+    flag.aliases = {"-v"};
+    flag.description = "Description for flag";
+
+    lwcli::CLIParser parser;
+    parser.register_option(flag).expand_response_files();
+
+    const auto missing = "@" + (std::filesystem::temp_directory_path() / "lwcli_missing_response_file.rsp").string();
+    const auto unterminated = "@" + write_file("unterminated.rsp", "-v 'unterminated");
+    const auto recursive_path = write_file("recursive.rsp", "");
+    const auto recursive = "@" + write_file("recursive.rsp", "-v @" + recursive_path);
+
+    for (const auto& file : {missing, unterminated, recursive}) {
+        const auto argv = std::array{"response_file_tests", file.c_str()};
+        EXPECT_THROW(parser.parse(static_cast<int>(std::size(argv)), std::data(argv)), lwcli::bad_response_file)
+            << "For response file: " << file;
+    }
+}
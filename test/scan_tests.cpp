@@ -0,0 +1,54 @@
+#include "gtest/gtest.h" // cppcheck-suppress [missingInclude]
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "LWCLI/_scan.hpp"
+
+[[nodiscard]] std::string random_string(std::mt19937& engine, const std::size_t length)
+{
+    std::uniform_int_distribution<int> distribution('a', 'd');
+
+    std::string result(length, '\0');
+    for (auto& chr : result)
+        chr = static_cast<char>(distribution(engine));
+    return result;
+}
+
+TEST(ScanTests, MatchesScalarScan)
+{
+    std::mt19937 engine(42); // NOLINT(cert-msc32-c, cert-msc51-cpp)
+
+    for (std::size_t length = 0; length < 200; ++length) {
+        const auto str = random_string(engine, length);
+
+        std::vector<std::size_t> expected;
+        for (std::size_t i = 0; i < str.size(); ++i) {
+            if (str[i] == 'a')
+                expected.push_back(i);
+        }
+
+        std::vector<std::size_t> found;
+        EXPECT_TRUE(lwcli::_for_each_occurrence(str, 'a', [&](const std::size_t index) {
+            found.push_back(index);
+            return true;
+        }));
+
+        EXPECT_EQ(expected, found) << "For string: " << str;
+        EXPECT_EQ(expected.size(), lwcli::_count_occurrences(str, 'a')) << "For string: " << str;
+    }
+}
+
+TEST(ScanTests, StopsEarly)
+{
+    const std::string str(100, 'a');
+
+    std::size_t n_calls = 0;
+    EXPECT_FALSE(lwcli::_for_each_occurrence(str, 'a', [&](const std::size_t index) {
+        ++n_calls;
+        return index < 40;
+    }));
+    EXPECT_EQ(41, n_calls);
+}
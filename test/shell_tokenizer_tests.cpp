@@ -0,0 +1,153 @@
+#include "gtest/gtest.h" // cppcheck-suppress [missingInclude]
+
+#include <cstddef>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "LWCLI/_tokenizer.hpp"
+#include "LWCLI/exceptions.hpp"
+#include "LWCLI/options.hpp"
+#include "LWCLI/parser.hpp"
+#include "LWCLI/shell_tokenizer.hpp"
+
+/* Tokenizer tests -------------------------------------------------------------------------------------------------- */
+
+[[nodiscard]] std::vector<std::string> split(lwcli::ShellTokenizer& tokenizer, const std::string_view command_line)
+{
+    const auto tokens = tokenizer.split(command_line);
+    return {tokens.begin(), tokens.end()};
+}
+
+TEST(ShellTokenizerTests, SplitsQuotedArguments)
+{
+    lwcli::ShellTokenizer tokenizer;
+
+    const std::vector<std::string> expected = {"app", "-j", "4", "two words", "it's", "", "end"};
+    EXPECT_EQ(expected, split(tokenizer, R"(  app -j 4 "two words" it\'s '' end  )"));
+    EXPECT_EQ(std::vector<std::string>{}, split(tokenizer, " \t\n "));
+}
+
+TEST(ShellTokenizerTests, PlainArgumentsViewTheCommandLine)
+{
+    const std::string command_line = "plain 'quoted' another-plain-argument-longer-than-a-block";
+
+    lwcli::ShellTokenizer tokenizer;
+    const auto tokens = tokenizer.split(command_line);
+
+    ASSERT_EQ(3, tokens.size());
+    EXPECT_EQ(command_line.data(), tokens[0].data());
+    EXPECT_NE(command_line.data() + 7, tokens[1].data());
+    EXPECT_EQ("quoted", tokens[1]);
+    EXPECT_EQ(command_line.data() + 15, tokens[2].data());
+}
+
+TEST(ShellTokenizerTests, UnescapedArgumentsRemainValid)
+{
+    // Note: every argument is unescaped, so none may be invalidated by those that follow.
+    std::string command_line;
+    for (int i = 0; i < 100; ++i)
+        command_line += "'argument " + std::to_string(i) + "' ";
+
+    lwcli::ShellTokenizer tokenizer;
+    const auto tokens = tokenizer.split(command_line);
+
+    ASSERT_EQ(100, tokens.size());
+    for (std::size_t i = 0; i < tokens.size(); ++i)
+        EXPECT_EQ("argument " + std::to_string(i), tokens[i]);
+}
+
+TEST(ShellTokenizerTests, UnterminatedQuote)
+{
+    lwcli::ShellTokenizer tokenizer;
+    EXPECT_THROW(static_cast<void>(tokenizer.split("app \"unterminated")), lwcli::bad_command_line);
+
+    const auto result = tokenizer.try_split("app 'unterminated");
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(lwcli::parse_errc::command_line, result.error().code);
+    EXPECT_EQ("app 'unterminated", result.error().argument);
+    EXPECT_FALSE(result.error().format().empty());
+}
+
+TEST(ShellTokenizerTests, MatchesInPlaceTokenizer)
+{
+    // Note: special characters are placed at every offset of (and across) the blocks scanned at a time.
+    static constexpr std::string_view ALPHABET = "ab \t\n'\"\\";
+
+    std::mt19937 engine(42); // NOLINT(cert-msc32-c, cert-msc51-cpp)
+    std::uniform_int_distribution<std::size_t> length(0, 100);
+    std::uniform_int_distribution<std::size_t> character(0, ALPHABET.size() - 1);
+
+    lwcli::ShellTokenizer tokenizer;
+    for (int i = 0; i < 10'000; ++i) {
+        std::string input(length(engine), '\0');
+        for (char& chr : input)
+            chr = ALPHABET[character(engine)];
+
+        std::string buffer = input;
+        char* cursor = buffer.data();
+        std::vector<std::string> expected;
+        std::string_view token;
+        lwcli::_token_status status{};
+        while ((status = lwcli::_next_shell_token(cursor, buffer.data() + buffer.size(), token))
+               == lwcli::_token_status::TOKEN)
+            expected.emplace_back(token);
+
+        const auto result = tokenizer.try_split(input);
+        ASSERT_EQ(status == lwcli::_token_status::END, result.has_value()) << "For input: " << input;
+        if (result.has_value()) {
+            ASSERT_EQ(expected, std::vector<std::string>(result->begin(), result->end())) << "For input: " << input;
+        }
+    }
+}
+
+/* Parser tests ----------------------------------------------------------------------------------------------------- */
+
+class CommandLineParseTests : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        verbose.aliases = {"-v"};
+        verbose.description = "Description for verbose";
+
+        name.aliases = {"--name"};
+        name.description = "Description for name";
+
+        input.name = "input";
+        input.description = "Description for input";
+
+        parser.register_options(verbose, name, input);
+    }
+
+    lwcli::FlagOption verbose;
+    lwcli::KeyValueOption<std::string> name;
+    lwcli::PositionalOption<std::string> input;
+    lwcli::CLIParser parser;
+};
+
+TEST_F(CommandLineParseTests, ParsesQuotedArguments)
+{
+    ASSERT_NO_THROW(parser.parse(R"(app -v --name "a \"quoted\" name" it\'s)"));
+
+    EXPECT_EQ(1, verbose.count);
+    EXPECT_EQ(R"(a "quoted" name)", name.value);
+    EXPECT_EQ("it's", input.value);
+}
+
+TEST_F(CommandLineParseTests, ReportsErrors)
+{
+    EXPECT_THROW(parser.parse("app --name 'unterminated"), lwcli::bad_command_line);
+
+    const std::string command_line = "app -v first second";
+    const auto result = parser.try_parse(command_line);
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(lwcli::parse_errc::positional_count, result.error().code);
+    EXPECT_EQ(3, result.error().index);
+    EXPECT_EQ(command_line.data() + 13, result.error().argument.data());
+
+    const auto split_error = parser.try_parse("app --name \"unterminated");
+    ASSERT_FALSE(split_error.has_value());
+    EXPECT_EQ(lwcli::parse_errc::command_line, split_error.error().code);
+}
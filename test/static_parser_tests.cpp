@@ -0,0 +1,257 @@
+#include "gtest/gtest.h" // cppcheck-suppress [missingInclude]
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "LWCLI/exceptions.hpp"
+#include "LWCLI/options.hpp"
+#include "LWCLI/parser.hpp"
+#include "LWCLI/static_parser.hpp"
+
+/* Schema tests ----------------------------------------------------------------------------------------------------- */
+
+namespace
+{
+struct settings
+{
+    unsigned verbose = 0;
+    bool quiet = false;
+    std::optional<int> threads;
+    std::string name;
+    std::optional<double> ratio;
+    std::string input;
+    std::optional<int> count;
+};
+
+// Note: '-h' is reserved, hence never matched by --quiet.
+constexpr auto SCHEMA = lwcli::make_static_schema<settings>(
+    lwcli::make_static_flag(&settings::verbose, {"-v", "--verbose"}, "Description for verbose"),
+    lwcli::make_static_flag(&settings::quiet, {"-q", "--quiet", "-h"}, "Description for quiet"),
+    lwcli::make_static_key_value(&settings::threads, {"-j", "--threads"}, "Description for threads"),
+    lwcli::make_static_key_value(&settings::name, {"--name"}, "Description for name"),
+    lwcli::make_static_positional(&settings::input, "input", "Description for input"),
+    lwcli::make_static_key_value(&settings::ratio, {"-r", "--ratio"}, "Description for ratio"),
+    lwcli::make_static_positional(&settings::count, "count", "Description for count"));
+
+using parser_t = lwcli::StaticParser<SCHEMA>;
+
+// Note: '--help' is reserved, hence never matched by --mode, nor is '-h' by --dry-run (Which can never be given).
+constexpr auto RESERVED_SCHEMA = lwcli::make_static_schema<settings>(
+    lwcli::make_static_flag(&settings::verbose, {"-v"}, "Description for verbose"),
+    lwcli::make_static_flag(&settings::quiet, {"-h"}, "Description for dry-run"),
+    lwcli::make_static_key_value(&settings::name, {"--help", "--mode"}, "Description for mode"));
+
+using reserved_parser_t = lwcli::StaticParser<RESERVED_SCHEMA>;
+} // namespace
+
+TEST(StaticSchemaTests, ValidatesOptions)
+{
+    using lwcli::_schema_defect;
+    using lwcli::_validate_static_schema;
+    using lwcli::make_static_flag;
+    using lwcli::make_static_key_value;
+    using lwcli::make_static_positional;
+
+    static_assert(
+        _validate_static_schema(
+            make_static_flag(&settings::verbose, {"-v"}),
+            make_static_key_value(&settings::name, {"--name"}, "Description"),
+            make_static_positional(&settings::input, "input"))
+        == _schema_defect::none);
+
+    static_assert(
+        _validate_static_schema(
+            make_static_flag(&settings::verbose, {"-v", "--all"}),
+            make_static_flag(&settings::quiet, {"--all"}))
+        == _schema_defect::duplicate_alias);
+    static_assert(
+        _validate_static_schema(make_static_flag(&settings::verbose, {"verbose"}))
+        == _schema_defect::unprefixed_alias);
+    static_assert(
+        _validate_static_schema(make_static_flag(&settings::verbose, {"--very verbose"}))
+        == _schema_defect::alias_with_spaces);
+    static_assert(
+        _validate_static_schema(make_static_key_value(&settings::name, {"--name"}, ""))
+        == _schema_defect::undescribed_key_value);
+    static_assert(
+        _validate_static_schema(make_static_positional(&settings::input, "")) == _schema_defect::unnamed_positional);
+
+    // Note: reserved aliases may be declared, as they may be registered with a CLIParser.
+    static_assert(
+        _validate_static_schema(make_static_flag(&settings::verbose, {"-h", "--help"})) == _schema_defect::none);
+    SUCCEED();
+}
+
+/* Parser tests ----------------------------------------------------------------------------------------------------- */
+
+class StaticParserTests : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        parser.redirect_help({[](void* const context, const std::string_view text) {
+                                  *static_cast<std::string*>(context) = text;
+                              },
+                              &help});
+    }
+
+    [[nodiscard]] bool parse(const std::vector<const char*>& argv)
+    {
+        return parser.parse(static_cast<int>(argv.size()), argv.data(), result);
+    }
+
+    [[nodiscard]] lwcli::parse_error parse_error_of(const std::vector<const char*>& argv)
+    {
+        const auto parsed = parser.try_parse(static_cast<int>(argv.size()), argv.data(), result);
+        return parsed.has_value() ? lwcli::parse_error{} : parsed.error();
+    }
+
+    parser_t parser;
+    settings result;
+    std::string help;
+};
+
+TEST_F(StaticParserTests, ParsesIntoFields)
+{
+    ASSERT_FALSE(parse({"static_tests", "-v", "--name", "some name", "in.txt", "--verbose", "-q", "-j", "4", "7"}));
+
+    EXPECT_EQ(2, result.verbose);
+    EXPECT_TRUE(result.quiet);
+    EXPECT_EQ(4, result.threads);
+    EXPECT_EQ("some name", result.name);
+    EXPECT_EQ("in.txt", result.input);
+    EXPECT_EQ(7, result.count);
+    EXPECT_TRUE(help.empty());
+}
+
+TEST_F(StaticParserTests, LeavesFieldsOfOptionsNotGiven)
+{
+    result.ratio = 2.5;
+
+    ASSERT_FALSE(parse({"static_tests", "--name", "a"}));
+    EXPECT_EQ(0, result.verbose);
+    EXPECT_FALSE(result.threads.has_value());
+    EXPECT_EQ(2.5, result.ratio);
+    EXPECT_TRUE(result.input.empty());
+}
+
+TEST_F(StaticParserTests, ParsesInlineValues)
+{
+    ASSERT_FALSE(parse({"static_tests", "--name=a=b", "--threads=8", "--verbose=true", "--verbose=0", "--ratio=0.5"}));
+
+    EXPECT_EQ("a=b", result.name);
+    EXPECT_EQ(8, result.threads);
+    EXPECT_EQ(1, result.verbose);
+    EXPECT_EQ(0.5, result.ratio);
+}
+
+TEST_F(StaticParserTests, ReportsErrors)
+{
+    auto error = parse_error_of({"static_tests", "--name", "a", "-j", "four"});
+    EXPECT_EQ(lwcli::parse_errc::value_conversion, error.code);
+    EXPECT_EQ(3, error.index);
+    EXPECT_EQ("-j", error.argument);
+    EXPECT_EQ("four", error.value);
+
+    error = parse_error_of({"static_tests", "--name"});
+    EXPECT_EQ(lwcli::parse_errc::key_value_format, error.code);
+    EXPECT_EQ("--name", error.argument);
+
+    error = parse_error_of({"static_tests", "--name", "a", "in.txt", "1", "extra"});
+    EXPECT_EQ(lwcli::parse_errc::positional_count, error.code);
+    EXPECT_EQ(5, error.index);
+    EXPECT_EQ(2, error.n_max_positional);
+
+    error = parse_error_of({"static_tests", "--name", "a", "in.txt", "one"});
+    EXPECT_EQ(lwcli::parse_errc::positional_conversion, error.code);
+    EXPECT_EQ("one", error.value);
+
+    error = parse_error_of({"static_tests", "--verbose=maybe", "--name", "a"});
+    EXPECT_EQ(lwcli::parse_errc::value_conversion, error.code);
+    EXPECT_EQ("--verbose", error.argument);
+
+    // Note: --name is the only required option, the other key-values being optional.
+    error = parse_error_of({"static_tests", "-v"});
+    EXPECT_EQ(lwcli::parse_errc::required_options, error.code);
+    EXPECT_EQ(2, error.index);
+    EXPECT_EQ("--name", error.argument);
+    EXPECT_EQ(std::vector<std::string>{"--name"}, error.missing_options);
+}
+
+TEST_F(StaticParserTests, ThrowsParseErrors)
+{
+    EXPECT_THROW(static_cast<void>(parse({"static_tests", "--name", "a", "-j", "x"})), lwcli::bad_value_conversion);
+    EXPECT_THROW(static_cast<void>(parse({"static_tests", "--name"})), lwcli::bad_key_value_format);
+    EXPECT_THROW(static_cast<void>(parse({"static_tests", "--name", "a", "b", "1", "c"})), lwcli::bad_positional_count);
+    EXPECT_THROW(static_cast<void>(parse({"static_tests", "--name", "a", "b", "c"})), lwcli::bad_positional_conversion);
+    EXPECT_THROW(static_cast<void>(parse({"static_tests", "-v"})), lwcli::bad_required_options);
+}
+
+TEST_F(StaticParserTests, HelpTakesPrecedence)
+{
+    ASSERT_TRUE(parse({"static_tests", "-v", "-j", "x", "-h"}));
+    EXPECT_EQ(parser_t::help_message(), help);
+    EXPECT_EQ(1, result.verbose);
+    // Note: '-h' is reserved, hence never matched by --quiet.
+    EXPECT_FALSE(result.quiet);
+
+    help.clear();
+    ASSERT_TRUE(parse({"static_tests"}));
+    EXPECT_FALSE(help.empty());
+
+    help.clear();
+    ASSERT_TRUE(parse({"static_tests", "--help=1"}));
+    EXPECT_FALSE(help.empty());
+}
+
+TEST_F(StaticParserTests, HelpMessageMatchesCLIParser)
+{
+    static_assert(!parser_t::help_message().empty());
+
+    lwcli::FlagOption verbose;
+    verbose.aliases = {"-v", "--verbose"};
+    verbose.description = "Description for verbose";
+    lwcli::FlagOption quiet;
+    quiet.aliases = {"-q", "--quiet", "-h"};
+    quiet.description = "Description for quiet";
+    lwcli::KeyValueOption<std::optional<int>> threads;
+    threads.aliases = {"-j", "--threads"};
+    threads.description = "Description for threads";
+    lwcli::KeyValueOption<std::string> name;
+    name.aliases = {"--name"};
+    name.description = "Description for name";
+    lwcli::PositionalOption<std::string> input;
+    input.name = "input";
+    input.description = "Description for input";
+    lwcli::KeyValueOption<std::optional<double>> ratio;
+    ratio.aliases = {"-r", "--ratio"};
+    ratio.description = "Description for ratio";
+    lwcli::PositionalOption<std::optional<int>> count;
+    count.name = "count";
+    count.description = "Description for count";
+
+    lwcli::CLIParser dynamic_parser;
+    dynamic_parser.register_options(verbose, quiet, threads, name, input, ratio, count);
+
+    EXPECT_EQ(dynamic_parser.help_message(), parser_t::help_message());
+}
+
+TEST(StaticParserReservedAliasTests, ReservedAliasesAreNotListed)
+{
+    const reserved_parser_t parser;
+    settings result;
+
+    const auto argv = std::vector<const char*>{"static_tests", "-v"};
+    const auto parsed = parser.try_parse(static_cast<int>(argv.size()), argv.data(), result);
+    ASSERT_FALSE(parsed.has_value());
+    EXPECT_EQ(lwcli::parse_errc::required_options, parsed.error().code);
+    EXPECT_EQ("--mode", parsed.error().argument);
+    EXPECT_EQ(std::vector<std::string>{"--mode"}, parsed.error().missing_options);
+
+    const std::string_view help = reserved_parser_t::help_message();
+    EXPECT_NE(help.find("--mode"), std::string_view::npos);
+    EXPECT_EQ(help.find("--help"), std::string_view::npos);
+    EXPECT_EQ(help.find("dry-run"), std::string_view::npos);
+}
@@ -0,0 +1,143 @@
+#include "gtest/gtest.h" // cppcheck-suppress [missingInclude]
+
+#include <array>
+#include <string>
+#include <string_view>
+
+#include "LWCLI/exceptions.hpp"
+#include "LWCLI/options.hpp"
+#include "LWCLI/parser.hpp"
+
+class SubcommandTests : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        verbose.aliases = {"-v"};
+        verbose.description = "Description for verbose";
+
+        parser.register_option(verbose)
+            .register_subcommand(
+                "build",
+                "Description for build",
+                [this](lwcli::CLIParser& subparser) {
+                    ++n_build_factory_calls;
+
+                    jobs.aliases = {"-j", "--jobs"};
+                    jobs.description = "Description for jobs";
+                    subparser.register_option(jobs).freeze();
+                })
+            .register_subcommand("clean", "Description for clean", [this](lwcli::CLIParser& subparser) {
+                ++n_clean_factory_calls;
+
+                force.aliases = {"-f"};
+                force.description = "Description for force";
+                subparser.register_option(force);
+            });
+    }
+
+    lwcli::FlagOption verbose;
+    lwcli::KeyValueOption<int> jobs;
+    lwcli::FlagOption force;
+    lwcli::CLIParser parser;
+
+    int n_build_factory_calls = 0;
+    int n_clean_factory_calls = 0;
+};
+
+TEST_F(SubcommandTests, OnlySelectedSubcommandIsInstantiated)
+{
+    const auto argv = std::array{"subcommand_tests", "build", "-j", "4"};
+    ASSERT_NO_THROW(parser.parse(static_cast<int>(std::size(argv)), std::data(argv)));
+    ASSERT_NO_THROW(parser.parse(static_cast<int>(std::size(argv)), std::data(argv)));
+
+    EXPECT_EQ("build", parser.selected_subcommand());
+    EXPECT_EQ(4, jobs.value);
+    EXPECT_EQ(1, n_build_factory_calls);
+    EXPECT_EQ(0, n_clean_factory_calls);
+}
+
+TEST_F(SubcommandTests, WithoutSubcommand)
+{
+    const auto argv = std::array{"subcommand_tests", "-v"};
+    ASSERT_NO_THROW(parser.parse(static_cast<int>(std::size(argv)), std::data(argv)));
+
+    EXPECT_EQ("", parser.selected_subcommand());
+    EXPECT_EQ(1, verbose.count);
+    EXPECT_EQ(0, n_build_factory_calls);
+    EXPECT_EQ(0, n_clean_factory_calls);
+}
+
+TEST_F(SubcommandTests, OptionsDoNotLeakBetweenParsers)
+{
+    // Note: -v is only registered on the top-level parser, and the subcommand must be the first argument.
+    const auto subcommand_argv = std::array{"subcommand_tests", "clean", "-v"};
+    EXPECT_THROW(
+        parser.parse(static_cast<int>(std::size(subcommand_argv)), std::data(subcommand_argv)),
+        lwcli::bad_positional_count);
+
+    const auto top_level_argv = std::array{"subcommand_tests", "-v", "clean"};
+    EXPECT_THROW(
+        parser.parse(static_cast<int>(std::size(top_level_argv)), std::data(top_level_argv)),
+        lwcli::bad_positional_count);
+}
+
+TEST_F(SubcommandTests, ErrorsReferToTopLevelArguments)
+{
+    const auto bad_value_argv = std::array{"subcommand_tests", "build", "-j", "many"};
+    auto result = parser.try_parse(static_cast<int>(std::size(bad_value_argv)), std::data(bad_value_argv));
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(lwcli::parse_errc::value_conversion, result.error().code);
+    EXPECT_EQ(2, result.error().index);
+
+    // Note: help is requested from the subcommand, so takes precedence over -v being unknown to it.
+    const auto help_argv = std::array{"subcommand_tests", "build", "-h", "-v"};
+    testing::internal::CaptureStdout();
+    result = parser.try_parse(static_cast<int>(std::size(help_argv)), std::data(help_argv));
+    EXPECT_NE(std::string::npos, testing::internal::GetCapturedStdout().find("-j | --jobs"));
+    EXPECT_TRUE(result.has_value());
+
+    try {
+        const auto argv = std::array{"subcommand_tests", "build", "unexpected"};
+        parser.parse(static_cast<int>(std::size(argv)), std::data(argv));
+        FAIL() << "No exception was thrown";
+    }
+    catch (const lwcli::bad_positional_count& e) {
+        // Note: described by the subcommand's parser, which accepts no positional arguments.
+        EXPECT_NE(std::string(e.what()).find("at most 0"), std::string::npos) << e.what();
+    }
+}
+
+TEST_F(SubcommandTests, HelpListsSubcommandsWithoutInstantiating)
+{
+    const std::string_view help = parser.help_message();
+
+    EXPECT_NE(std::string_view::npos, help.find("build:\n  Description for build\n"));
+    EXPECT_NE(std::string_view::npos, help.find("clean:\n  Description for clean\n"));
+    EXPECT_EQ(0, n_build_factory_calls);
+    EXPECT_EQ(0, n_clean_factory_calls);
+}
+
+TEST_F(SubcommandTests, SettingsReachExistingSubcommands)
+{
+    const auto argv = std::array{"subcommand_tests", "build", "-j", "1"};
+    ASSERT_NO_THROW(parser.parse(static_cast<int>(std::size(argv)), std::data(argv)));
+    ASSERT_EQ(1, n_build_factory_calls);
+
+    // Note: both settings are changed after the subcommand's parser was created.
+    std::string help;
+    parser.redirect_help({[](void* const context, const std::string_view text) {
+                              *static_cast<std::string*>(context) = text;
+                          },
+                          &help});
+    parser.expand_response_files();
+
+    const auto help_argv = std::array{"subcommand_tests", "build", "-h"};
+    ASSERT_NO_THROW(parser.parse(static_cast<int>(std::size(help_argv)), std::data(help_argv)));
+    EXPECT_NE(std::string::npos, help.find("-j | --jobs"));
+
+    const auto response_file_argv = std::array{"subcommand_tests", "build", "@lwcli_missing_response_file.rsp"};
+    EXPECT_THROW(
+        parser.parse(static_cast<int>(std::size(response_file_argv)), std::data(response_file_argv)),
+        lwcli::bad_response_file);
+}
@@ -0,0 +1,278 @@
+#include "gtest/gtest.h" // cppcheck-suppress [missingInclude]
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "LWCLI/_suggest.hpp"
+#include "LWCLI/exceptions.hpp"
+#include "LWCLI/options.hpp"
+#include "LWCLI/parser.hpp"
+
+/* Edit distance tests ---------------------------------------------------------------------------------------------- */
+
+namespace
+{
+std::size_t levenshtein(const std::string_view lhs, const std::string_view rhs)
+{
+    std::vector<std::size_t> row(rhs.size() + 1);
+    std::iota(row.begin(), row.end(), std::size_t{0});
+    for (std::size_t i = 1; i <= lhs.size(); ++i) {
+        std::size_t diagonal = row[0];
+        row[0] = i;
+        for (std::size_t j = 1; j <= rhs.size(); ++j) {
+            const std::size_t above = row[j];
+            row[j] = std::min({row[j] + 1, row[j - 1] + 1, diagonal + (lhs[i - 1] == rhs[j - 1] ? 0 : 1)});
+            diagonal = above;
+        }
+    }
+    return row.back();
+}
+} // namespace
+
+TEST(EditDistanceTests, ComputesDistances)
+{
+    const lwcli::_edit_distance distance_to("--verbose");
+
+    EXPECT_EQ(0, distance_to("--verbose", 3));
+    EXPECT_EQ(1, distance_to("--verbos", 3));
+    EXPECT_EQ(1, distance_to("--verbosee", 3));
+    EXPECT_EQ(2, distance_to("--vrebose", 3));
+    EXPECT_EQ(9, distance_to("", 9));
+    EXPECT_GT(distance_to("--quiet", 3), 3);
+    EXPECT_GT(distance_to("-v", 3), 3);
+}
+
+TEST(EditDistanceTests, MatchesDynamicProgramming)
+{
+    static constexpr std::string_view ALPHABET = "abc-";
+
+    std::mt19937 engine(42); // NOLINT(cert-msc32-c, cert-msc51-cpp)
+    std::uniform_int_distribution<std::size_t> character(0, ALPHABET.size() - 1);
+    std::uniform_int_distribution<std::size_t> bound(0, 8);
+
+    const auto random_string = [&](const std::size_t min_length, const std::size_t max_length) {
+        std::string str(std::uniform_int_distribution<std::size_t>(min_length, max_length)(engine), '\0');
+        for (char& chr : str)
+            chr = ALPHABET[character(engine)];
+        return str;
+    };
+
+    for (int i = 0; i < 2000; ++i) {
+        // Note: up to the longest supported pattern, such that every bit of the word is exercised.
+        const std::string pattern = random_string(1, lwcli::_edit_distance::MAX_PATTERN_LENGTH);
+        const std::string text = random_string(0, 70);
+        const lwcli::_edit_distance distance_to(pattern);
+
+        const std::size_t expected = levenshtein(pattern, text);
+        const std::size_t max_distance = expected + bound(engine) - 4;
+        const std::size_t distance = distance_to(text, max_distance);
+        if (expected <= max_distance)
+            ASSERT_EQ(expected, distance) << pattern << " -> " << text;
+        else
+            ASSERT_GT(distance, max_distance) << pattern << " -> " << text;
+    }
+}
+
+/* Suggestion index tests ------------------------------------------------------------------------------------------- */
+
+TEST(SuggestionIndexTests, FindsNearestStrings)
+{
+    const std::vector<std::string> aliases = {"-v", "--verbose", "--version", "--verbatim", "--quiet", "--threads"};
+    const lwcli::_suggestion_index index(aliases);
+
+    EXPECT_EQ(aliases.size(), index.size());
+    EXPECT_EQ(std::vector<std::string>{"--verbose"}, index.nearest("--verbsoe"));
+    EXPECT_EQ(std::vector<std::string>{"--threads"}, index.nearest("--thread"));
+    EXPECT_EQ(std::vector<std::string>{"--quiet"}, index.nearest("--quite"));
+
+    // Note: ties are all suggested, in lexicographical order.
+    EXPECT_EQ((std::vector<std::string>{"--verbose", "--version"}), index.nearest("--versiose"));
+
+    // Note: a single edit is allowed, however short the query.
+    EXPECT_EQ(std::vector<std::string>{"-v"}, index.nearest("-x"));
+
+    for (const std::string_view query : {"", "--output", "x", "--verbose-mode-enabled"})
+        EXPECT_TRUE(index.nearest(query).empty()) << "For query: " << query;
+}
+
+TEST(SuggestionIndexTests, MatchesBruteForce)
+{
+    static constexpr std::string_view ALPHABET = "ab-1";
+
+    std::mt19937 engine(42); // NOLINT(cert-msc32-c, cert-msc51-cpp)
+    std::uniform_int_distribution<std::size_t> length(1, 12);
+    std::uniform_int_distribution<std::size_t> character(0, ALPHABET.size() - 1);
+
+    const auto random_string = [&] {
+        std::string str(length(engine), '\0');
+        for (char& chr : str)
+            chr = ALPHABET[character(engine)];
+        return str;
+    };
+
+    for (int i = 0; i < 200; ++i) {
+        std::vector<std::string> strings;
+        for (int j = 0; j < 50; ++j) {
+            std::string str = random_string();
+            if (std::ranges::find(strings, str) == strings.end())
+                strings.push_back(std::move(str));
+        }
+        const lwcli::_suggestion_index index(strings);
+
+        for (int j = 0; j < 20; ++j) {
+            const std::string query = random_string();
+
+            const std::size_t max_distance = std::max<std::size_t>(query.size() / 3, 1);
+            std::size_t nearest_distance = max_distance + 1;
+            std::vector<std::string> expected;
+            for (const auto& str : strings) {
+                const std::size_t distance = levenshtein(query, str);
+                if (distance < nearest_distance) {
+                    nearest_distance = distance;
+                    expected.clear();
+                }
+                if (distance == nearest_distance)
+                    expected.push_back(str);
+            }
+            if (nearest_distance > max_distance)
+                expected.clear();
+            std::ranges::sort(expected);
+
+            ASSERT_EQ(expected, index.nearest(query)) << "For query: " << query;
+        }
+    }
+}
+
+/* Parser tests ----------------------------------------------------------------------------------------------------- */
+
+class SuggestionTests : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        verbose.aliases = {"-v", "--verbose"};
+        verbose.description = "Description for verbose";
+
+        threads.aliases = {"-j", "--threads"};
+        threads.description = "Description for threads";
+
+        count.name = "count";
+        count.description = "Description for count";
+
+        parser.register_options(verbose, threads, count);
+    }
+
+    void parse(const std::vector<const char*>& argv)
+    {
+        parser.parse(static_cast<int>(argv.size()), argv.data());
+    }
+
+    lwcli::FlagOption verbose;
+    lwcli::KeyValueOption<std::optional<int>> threads;
+    lwcli::PositionalOption<std::optional<int>> count;
+    lwcli::CLIParser parser;
+};
+
+TEST_F(SuggestionTests, SuggestsForExcessArguments)
+{
+    for (const bool freeze : {false, true}) {
+        if (freeze)
+            parser.freeze();
+
+        try {
+            // Note: the misspelling preceding the excess argument is the one suggested for.
+            parse({"suggest_tests", "4", "--verbsoe", "5"});
+            FAIL() << "Expected bad_positional_count";
+        }
+        catch (const lwcli::bad_positional_count& error) {
+            EXPECT_EQ(std::vector<std::string>{"--verbose"}, error.suggestions);
+            EXPECT_NE(std::string_view(error.what()).find("Did you mean: --verbose?"), std::string_view::npos);
+        }
+    }
+}
+
+TEST_F(SuggestionTests, SuggestsForUnconvertibleArguments)
+{
+    try {
+        parse({"suggest_tests", "--thread", "4"});
+        FAIL() << "Expected bad_positional_conversion";
+    }
+    catch (const lwcli::bad_positional_conversion& error) {
+        EXPECT_EQ(std::vector<std::string>{"--threads"}, error.suggestions);
+    }
+}
+
+TEST_F(SuggestionTests, SuggestsReservedAliases)
+{
+    try {
+        parse({"suggest_tests", "--hepl"});
+        FAIL() << "Expected bad_positional_conversion";
+    }
+    catch (const lwcli::bad_positional_conversion& error) {
+        EXPECT_EQ(std::vector<std::string>{"--help"}, error.suggestions);
+    }
+}
+
+TEST_F(SuggestionTests, DoesNotSuggestForNonOptions)
+{
+    // Note: neither numbers (Negative or otherwise), nor arguments far from any alias, are suggested for.
+    for (const std::vector<const char*>& argv : {
+             std::vector<const char*>{"suggest_tests", "1", "-1"},
+             std::vector<const char*>{"suggest_tests", "1", "-.5"},
+             std::vector<const char*>{"suggest_tests", "1", "verbose"},
+             std::vector<const char*>{"suggest_tests", "1", "--output"},
+         }) {
+        try {
+            parse(argv);
+            FAIL() << "Expected bad_positional_count";
+        }
+        catch (const lwcli::bad_positional_count& error) {
+            EXPECT_TRUE(error.suggestions.empty()) << "For argument: " << argv.back();
+            EXPECT_EQ(std::string_view(error.what()).find("Did you mean"), std::string_view::npos);
+        }
+    }
+}
+
+TEST_F(SuggestionTests, SuggestsForShortAliases)
+{
+    try {
+        parse({"suggest_tests", "1", "-x"});
+        FAIL() << "Expected bad_positional_count";
+    }
+    catch (const lwcli::bad_positional_count& error) {
+        EXPECT_EQ((std::vector<std::string>{"-h", "-j", "-v"}), error.suggestions);
+    }
+}
+
+TEST_F(SuggestionTests, SuggestsOptionsRegisteredSinceLastError)
+{
+    EXPECT_THROW(parse({"suggest_tests", "1", "--outptu"}), lwcli::bad_positional_count);
+
+    lwcli::FlagOption output;
+    output.aliases = {"--output"};
+    output.description = "Description for output";
+    parser.register_option(output);
+
+    try {
+        parse({"suggest_tests", "1", "--outptu"});
+        FAIL() << "Expected bad_positional_count";
+    }
+    catch (const lwcli::bad_positional_count& error) {
+        EXPECT_EQ(std::vector<std::string>{"--output"}, error.suggestions);
+    }
+}
+
+TEST_F(SuggestionTests, ErrorCodesCarryTheMisspelling)
+{
+    const auto argv = std::array{"suggest_tests", "1", "--verbsoe", "2"};
+    const auto result = parser.try_parse(static_cast<int>(argv.size()), argv.data());
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(lwcli::parse_errc::positional_count, result.error().code);
+    EXPECT_EQ("--verbsoe", result.error().value);
+}